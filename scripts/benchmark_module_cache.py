@@ -0,0 +1,71 @@
+import subprocess
+import tempfile
+import statistics
+import os
+import re
+import sys
+
+# compares the tokenization and front-end time of a program that imports most of the standard library
+# without the module cache, with a cold cache (every file is tokenized and stored) and with a warm cache
+# usage: python scripts/benchmark_module_cache.py [run-count]
+
+run_count = int(sys.argv[1]) if len(sys.argv) > 1 else 20
+
+bozon = 'bin\\windows-release\\bozon.exe' if os.name == 'nt' else './bin/linux-release/bozon'
+flags = [ '--stdlib-dir', 'bozon-stdlib', '--profile', '--emit=null' ]
+sections = [ 'tokenization time', 'front-end time', 'initialization time', 'global symbol parse time' ]
+imports = [
+    'std::algorithm', 'std::atomic', 'std::bit', 'std::complex', 'std::format', 'std::math',
+    'std::print', 'std::string', 'std::unicode', 'std::unique_ptr', 'std::utils', 'std::vector', 'std::fs::path',
+    'std::meta::types', 'std::ryu::d2s_full_table', 'std::ryu::d2fixed_full_table',
+]
+
+time_re = re.compile(r'^\s*([a-z -]+):\s+([0-9.]+)ms', re.MULTILINE)
+counter_re = re.compile(r'^module cache hits:\s+([0-9]+)$', re.MULTILINE)
+
+def run(source_file, extra_flags):
+    result = subprocess.run(
+        [ bozon, *flags, *extra_flags, source_file ],
+        stdout=subprocess.PIPE,
+        stderr=subprocess.PIPE,
+        encoding='utf-8'
+    )
+    if result.returncode != 0:
+        print(' '.join(result.args))
+        print(result.stdout)
+        print(result.stderr)
+        sys.exit(1)
+    return result.stdout
+
+with tempfile.TemporaryDirectory() as temp_dir:
+    source_file = os.path.join(temp_dir, 'imports.bz')
+    with open(source_file, 'w') as f:
+        f.write(''.join(f'import {name};\n' for name in imports))
+        f.write('\nfunction main() {}\n')
+
+    modes = [ 'no cache', 'cold cache', 'warm cache' ]
+    times = { mode: { section: [] for section in sections } for mode in modes }
+    warm_dir = os.path.join(temp_dir, 'warm-cache')
+    # fill the warm cache
+    run(source_file, [ '--module-cache-dir', warm_dir ])
+    warm_hits = 0
+    for i in range(run_count):
+        cold_dir = os.path.join(temp_dir, f'cold-cache-{i}')
+        outputs = {
+            'no cache': run(source_file, []),
+            'cold cache': run(source_file, [ '--module-cache-dir', cold_dir ]),
+            'warm cache': run(source_file, [ '--module-cache-dir', warm_dir ]),
+        }
+        warm_hits = int(counter_re.search(outputs['warm cache']).group(1))
+        for mode, output in outputs.items():
+            values = dict(time_re.findall(output))
+            for section in sections:
+                times[mode][section].append(float(values[section]))
+    cache_size = sum(os.path.getsize(os.path.join(warm_dir, name)) for name in os.listdir(warm_dir))
+
+print(f'{run_count} runs, median (min), {warm_hits} module cache hits with a warm cache, {cache_size / 1024:.1f} KiB cache size')
+for section in sections:
+    print(f'{section}:')
+    for mode in modes:
+        values = times[mode][section]
+        print(f'  {mode + ":":24} {statistics.median(values):8.3f}ms ({min(values):8.3f}ms)')
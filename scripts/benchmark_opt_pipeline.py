@@ -0,0 +1,84 @@
+import subprocess
+import tempfile
+import os
+import glob
+import re
+import sys
+
+# compares the '--opt pipeline' modes on the tests/success corpus
+# usage: python scripts/benchmark_opt_pipeline.py [opt-level] [repeat-count]
+
+opt_level = sys.argv[1] if len(sys.argv) > 1 else '2'
+repeat_count = int(sys.argv[2]) if len(sys.argv) > 2 else 3
+
+pipelines = [ 'module', 'eager', 'full' ]
+stages = [ 'function simplification', 'bitcode emission', 'module optimization', 'file emission' ]
+
+test_files = sorted(glob.glob("tests/success/**/*.bz", recursive=True))
+bozon = 'bin\\windows-release\\bozon.exe' if os.name == 'nt' else './bin/linux-release/bozon'
+flags = [ '--stdlib-dir', 'bozon-stdlib', '-Itests/import', '--profile', f'-O{opt_level}' ]
+
+time_re = re.compile(r'^\s*([a-z -]+):\s+([0-9.]+)ms', re.MULTILINE)
+instruction_re = re.compile(r'^\s+(?:%\S+ = )?[a-z]', re.MULTILINE)
+
+def compile_file(test_file, pipeline, emit, output_file):
+    result = subprocess.run(
+        [ bozon, *flags, f'-Opipeline={pipeline}', f'--emit={emit}', '-o', output_file, test_file ],
+        stdout=subprocess.PIPE,
+        stderr=subprocess.PIPE,
+        encoding='utf-8'
+    )
+    if result.returncode != 0:
+        return None
+    return { name: float(ms) for name, ms in time_re.findall(result.stdout) }
+
+def count_ir_instructions(ir_file):
+    # every indented line in a function body is an instruction
+    with open(ir_file, 'r') as f:
+        return len(instruction_re.findall(f.read()))
+
+results = { pipeline: { 'time': { stage: 0.0 for stage in stages }, 'total': 0.0, 'obj_size': 0, 'ir_instructions': 0 } for pipeline in pipelines }
+failed = set()
+
+with tempfile.TemporaryDirectory() as temp_dir:
+    obj_file = os.path.join(temp_dir, 'output.o')
+    ir_file = os.path.join(temp_dir, 'output.ll')
+    for test_file in test_files:
+        print(f'    {test_file}', flush=True)
+        file_results = {}
+        for pipeline in pipelines:
+            best_times = None
+            for _ in range(repeat_count):
+                times = compile_file(test_file, pipeline, 'obj', obj_file)
+                if times is None:
+                    break
+                if best_times is None or times['back-end time'] < best_times['back-end time']:
+                    best_times = times
+            if best_times is None or compile_file(test_file, pipeline, 'llvm-ir', ir_file) is None:
+                break
+            file_results[pipeline] = (best_times, os.path.getsize(obj_file), count_ir_instructions(ir_file))
+
+        # only files that compiled with every pipeline are counted, so the totals are comparable
+        if len(file_results) != len(pipelines):
+            failed.add(test_file)
+            continue
+
+        for pipeline, (times, obj_size, ir_instructions) in file_results.items():
+            result = results[pipeline]
+            for stage in stages:
+                result['time'][stage] += times.get(stage, 0.0)
+            result['total'] += times['back-end time']
+            result['obj_size'] += obj_size
+            result['ir_instructions'] += ir_instructions
+
+print(f'opt-level={opt_level}, {len(test_files) - len(failed)} files, best of {repeat_count} runs')
+print(f'{"":26}' + ''.join(f'{pipeline:>14}' for pipeline in pipelines))
+for stage in stages:
+    print(f'{stage + ":":26}' + ''.join(f'{results[pipeline]["time"][stage]:12.3f}ms' for pipeline in pipelines))
+print(f'{"back-end time:":26}' + ''.join(f'{results[pipeline]["total"]:12.3f}ms' for pipeline in pipelines))
+print(f'{"object size:":26}' + ''.join(f'{results[pipeline]["obj_size"]:14}' for pipeline in pipelines))
+print(f'{"IR instructions:":26}' + ''.join(f'{results[pipeline]["ir_instructions"]:14}' for pipeline in pipelines))
+if len(failed) != 0:
+    print('failed to compile:')
+    for test_file in sorted(failed):
+        print(f'    {test_file}')
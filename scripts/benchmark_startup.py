@@ -0,0 +1,53 @@
+import subprocess
+import tempfile
+import statistics
+import time
+import os
+import re
+import sys
+
+# measures the fixed cost of a compiler invocation by compiling an empty program
+# the initialization of the LLVM targets is part of 'back-end init time'; with a dynamically linked LLVM
+# the process wall time is dominated by loading the shared library, so compare the sections as well
+# usage: python scripts/benchmark_startup.py [run-count]
+
+run_count = int(sys.argv[1]) if len(sys.argv) > 1 else 50
+
+bozon = 'bin\\windows-release\\bozon.exe' if os.name == 'nt' else './bin/linux-release/bozon'
+flags = [ '--stdlib-dir', 'bozon-stdlib', '--profile' ]
+sections = [ 'command line parse time', 'initialization time', 'back-end init time', 'code generation time' ]
+
+time_re = re.compile(r'^\s*([a-z -]+):\s+([0-9.]+)ms', re.MULTILINE)
+
+with tempfile.TemporaryDirectory() as temp_dir:
+    source_file = os.path.join(temp_dir, 'empty.bz')
+    output_file = os.path.join(temp_dir, 'empty.o')
+    with open(source_file, 'w') as f:
+        f.write('function main() {}\n')
+
+    wall_times = []
+    section_times = { section: [] for section in sections }
+    for _ in range(run_count):
+        begin = time.perf_counter()
+        result = subprocess.run(
+            [ bozon, *flags, '-o', output_file, source_file ],
+            stdout=subprocess.PIPE,
+            stderr=subprocess.PIPE,
+            encoding='utf-8'
+        )
+        wall_times.append((time.perf_counter() - begin) * 1000)
+        if result.returncode != 0:
+            print(' '.join(result.args))
+            print(result.stdout)
+            print(result.stderr)
+            sys.exit(1)
+
+        times = dict(time_re.findall(result.stdout))
+        for section in sections:
+            section_times[section].append(float(times[section]))
+
+print(f'{run_count} runs, median (min)')
+print(f'{"process wall time:":26} {statistics.median(wall_times):8.3f}ms ({min(wall_times):8.3f}ms)')
+for section in sections:
+    values = section_times[section]
+    print(f'{section + ":":26} {statistics.median(values):8.3f}ms ({min(values):8.3f}ms)')
@@ -163,7 +163,7 @@ static bz::u8string generate_regular_token_lexer_helper(bz::array_view<token_nam
 			bz_assert(tokens[i + 1].first.length() == tokens[i].first.length() + 1);
 			indent(1); buffer += "if (stream.it == end)\n";
 			indent(1); buffer += "{\n";
-			indent(2); buffer += bz::format("return make_regular_token({}, begin_it, stream.it, stream.file_id, stream.line, context);\n", kind);
+			indent(2); buffer += bz::format("return make_regular_token({}, begin_it, stream, context);\n", kind);
 			indent(1); buffer += "}\n";
 
 			indent(1); buffer += "switch (*stream.it)\n";
@@ -173,7 +173,7 @@ static bz::u8string generate_regular_token_lexer_helper(bz::array_view<token_nam
 		}
 		else
 		{
-			indent(1); buffer += bz::format("return make_regular_token({}, begin_it, stream.it, stream.file_id, stream.line, context);\n", kind);
+			indent(1); buffer += bz::format("return make_regular_token({}, begin_it, stream, context);\n", kind);
 		}
 
 		// case end
@@ -185,7 +185,7 @@ static bz::u8string generate_regular_token_lexer_helper(bz::array_view<token_nam
 	{
 		indent(0); buffer += "default:\n";
 		indent(0); buffer += "{\n";
-		indent(1); buffer += bz::format("return make_regular_token({}, begin_it, stream.it, stream.file_id, stream.line, context);\n", default_kind);
+		indent(1); buffer += bz::format("return make_regular_token({}, begin_it, stream, context);\n", default_kind);
 		indent(0); buffer += "}\n";
 	}
 
@@ -227,10 +227,10 @@ static void generate_keyword_lexer()
 		buffer += bz::format("\t\tif (id_value == \"{}\")\n", token_string);
 		buffer += "\t\t{\n";
 		buffer += bz::format(
-			"\t\t\treturn token(\n"
+			"\t\t\treturn make_token(\n"
 			"\t\t\t\t{},\n"
 			"\t\t\t\tid_value,\n"
-			"\t\t\t\tstream.file_id, line, begin_it, end_it\n"
+			"\t\t\t\tbegin_it, end_it, stream\n"
 			"\t\t\t);\n",
 			kind
 		);
@@ -239,10 +239,10 @@ static void generate_keyword_lexer()
 
 	buffer += "\t\tbreak;\n"
 		"\t}\n"
-		"\treturn token(\n"
+		"\treturn make_token(\n"
 		"\t\ttoken::identifier,\n"
 		"\t\tid_value,\n"
-		"\t\tstream.file_id, line, begin_it, end_it\n"
+		"\t\tbegin_it, end_it, stream\n"
 		"\t);\n";
 
 	auto const file_text = read_text_from_file("src/lex/keywords.inc");
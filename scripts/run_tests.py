@@ -2,6 +2,9 @@ import subprocess
 import os
 import glob
 import re
+import shlex
+import shutil
+import tempfile
 
 def remove_ansi_colors(s):
     ansi_escape = re.compile(r'\x1B(?:[@-Z\\-_]|\[[0-?]*[ -/]*[@-~])')
@@ -46,6 +49,8 @@ class ProcessPool:
 success_test_files = glob.glob("tests/success/**/*.bz", recursive=True)
 warning_test_files = glob.glob("tests/warning/**/*.bz", recursive=True)
 error_test_files = glob.glob("tests/error/**/*.bz", recursive=True)
+# files in tests/emit/inputs are only used as additional source files by emit tests
+emit_test_files = glob.glob("tests/emit/*.bz")
 bozon = 'bin\\windows-debug\\no-sanitize-bozon.exe' if os.name == 'nt' else './bin/linux-debug/bozon'
 flags = [ '--stdlib-dir', 'bozon-stdlib', '-Wall', '--debug-no-emit-file', '-Itests/import' ]
 
@@ -78,6 +83,7 @@ file_name_print_length = 3 + max((
     max((len(test_file) for test_file in success_test_files)) if len(success_test_files) != 0 else 0,
     max((len(test_file) for test_file in warning_test_files)) if len(warning_test_files) != 0 else 0,
     max((len(test_file) for test_file in error_test_files)) if len(error_test_files) != 0 else 0,
+    max((len(test_file) for test_file in emit_test_files)) if len(emit_test_files) != 0 else 0,
 ))
 
 def print_test_fail_info(command, stdout, stderr, rc, wanted_messages=None):
@@ -125,10 +131,22 @@ for test_file in warning_test_files:
         failed_tests_info.append((test_file, command, stdout, stderr, rc))
         print_test_fail_info(*failed_tests_info[-1][1:])
 
+# additional command line arguments for a test can be given with '// flags: <args>' at the top of the file
+def get_test_flags(test_file):
+    result = []
+    with open(test_file, 'r') as f:
+        for line in f:
+            if not line.startswith('// flags:'):
+                break
+            result += shlex.split(line[len('// flags:'):])
+    return result
+
 def get_error_messages(test_file):
     result = []
     with open(test_file, 'r') as f:
         for line in f:
+            if line.startswith('// flags:'):
+                continue
             if not line.startswith('// error:') and not line.startswith('// note:') and not line.startswith('// warning:') and not line.startswith('// suggestion:'):
                 break
             result.append(line[3:-1])
@@ -147,7 +165,7 @@ def get_error_messages_from_compiler_output(output):
     return result
 
 error_commands = [
-    [ bozon, *flags, test_file ] if p == 0 else [ bozon, *flags, '--return-zero-on-error', test_file ]
+    [ bozon, *flags, *get_test_flags(test_file), test_file ] if p == 0 else [ bozon, *flags, *get_test_flags(test_file), '--return-zero-on-error', test_file ]
     for test_file in error_test_files
     for p in (0, 1)
 ]
@@ -170,7 +188,79 @@ for test_file in error_test_files:
         failed_tests_info.append((test_file, command, stdout, stderr, rc, wanted_messages))
         print_test_fail_info(*failed_tests_info[-1][1:])
 
-total_test_count = len(success_test_files) + len(warning_test_files) + len(error_test_files)
+# emit tests write object files, so they need the llvm back-end; they are only run for ELF targets,
+# because multiple codegen units and ifuncs are ELF only.  every '// run: <args>' line at the top of
+# a test is a compiler invocation in a temporary directory, which must succeed without any output;
+# '{file}' and '{dir}' are replaced with the path and the directory of the test file.  a '// link: <objects>'
+# line links the given object files from the temporary directory into one relocatable object, and a
+# '// check: <output file> <text>' line checks that an output file contains the given text
+def has_object_emission():
+    result = subprocess.run([ bozon, '--help' ], stdout=subprocess.PIPE, stderr=subprocess.PIPE, encoding='utf-8')
+    return '--emit={obj|' in remove_ansi_colors(result.stdout)
+
+def get_emit_test_steps(test_file):
+    result = []
+    replacements = { '{file}': os.path.abspath(test_file), '{dir}': os.path.abspath(os.path.dirname(test_file)) }
+    with open(test_file, 'r') as f:
+        for line in f:
+            if line.startswith('// run:'):
+                kind = 'run'
+            elif line.startswith('// link:'):
+                kind = 'link'
+            elif line.startswith('// check:'):
+                kind = 'check'
+            else:
+                break
+            args = line[line.find(':') + 1:].strip()
+            if kind == 'check':
+                output_file, _, text = args.partition(' ')
+                result.append((kind, [ output_file, text ]))
+                continue
+            for key, value in replacements.items():
+                args = args.replace(key, value)
+            result.append((kind, shlex.split(args)))
+    return result
+
+def run_emit_test(test_file, temp_dir):
+    emit_flags = [ '--stdlib-dir', os.path.abspath('bozon-stdlib'), '-Wall', f'-I{os.path.abspath("tests/import")}' ]
+    linker = shutil.which('ld.lld') or shutil.which('ld')
+    for kind, args in get_emit_test_steps(test_file):
+        if kind == 'check':
+            output_file, text = args
+            output_path = os.path.join(temp_dir, output_file)
+            contents = open(output_path, 'r', errors='replace').read() if os.path.exists(output_path) else ''
+            if text not in contents:
+                return [ 'check', output_file ], '', f'expected "{text}" in {output_file}', 1
+            continue
+        elif kind == 'run':
+            command = [ os.path.abspath(bozon), *emit_flags, *args ]
+        elif linker is None:
+            return [ 'link' ], '', 'unable to find a linker', 1
+        else:
+            command = [ linker, '-r', '-o', 'linked.o', *args ]
+        result = subprocess.run(command, cwd=temp_dir, stdout=subprocess.PIPE, stderr=subprocess.PIPE, encoding='utf-8')
+        stdout, stderr = remove_ansi_colors(result.stdout), remove_ansi_colors(result.stderr)
+        if result.returncode != 0 or stdout != '' or stderr != '':
+            return command, stdout, stderr, result.returncode
+    return None
+
+if len(emit_test_files) != 0 and (os.name == 'nt' or not has_object_emission()):
+    print(f'{bright_yellow}skipping emit tests, object file emission is not available{clear}')
+    emit_test_files = []
+
+for test_file in emit_test_files:
+    print(f'    {test_file:.<{file_name_print_length}}', end='', flush=True)
+    with tempfile.TemporaryDirectory() as temp_dir:
+        fail_info = run_emit_test(test_file, temp_dir)
+    if fail_info is None:
+        total_passed += 1
+        print(f'{bright_green}OK{clear}')
+    else:
+        print(f'{bright_red}FAIL{clear}')
+        failed_tests_info.append((test_file, *fail_info))
+        print_test_fail_info(*failed_tests_info[-1][1:])
+
+total_test_count = len(success_test_files) + len(warning_test_files) + len(error_test_files) + len(emit_test_files)
 passed_percentage = 100 * total_passed / total_test_count
 
 if total_passed == total_test_count:
@@ -682,4 +682,92 @@ bool operator != (constant_value const &lhs, constant_value const &rhs) noexcept
 	return !(lhs == rhs);
 }
 
+template<typename T>
+static size_t hash_constant_value_array(bz::array_view<T const> values)
+{
+	auto result = std::hash<size_t>()(values.size());
+	for (auto const &value : values)
+	{
+		if constexpr (bz::meta::is_same<T, constant_value>)
+		{
+			result = hash_combine(result, constant_value_hash()(value));
+		}
+		else if constexpr (bz::meta::is_same<T, float32_t>)
+		{
+			result = hash_combine(result, std::hash<uint32_t>()(value == 0.0f ? 0 : bit_cast<uint32_t>(value)));
+		}
+		else if constexpr (bz::meta::is_same<T, float64_t>)
+		{
+			result = hash_combine(result, std::hash<uint64_t>()(value == 0.0 ? 0 : bit_cast<uint64_t>(value)));
+		}
+		else
+		{
+			result = hash_combine(result, std::hash<T>()(value));
+		}
+	}
+	return result;
+}
+
+size_t constant_value_hash::operator () (constant_value const &value) const noexcept
+{
+	auto const kind_hash = std::hash<uint64_t>()(static_cast<uint64_t>(value.kind()));
+	switch (value.kind())
+	{
+	static_assert(constant_value::variant_count == 19);
+	case constant_value_kind::sint:
+		return hash_combine(kind_hash, std::hash<int64_t>()(value.get_sint()));
+	case constant_value_kind::uint:
+		return hash_combine(kind_hash, std::hash<uint64_t>()(value.get_uint()));
+	case constant_value_kind::float32:
+	{
+		// -0.0 == 0.0, so they need to have the same hash
+		auto const float32_value = value.get_float32();
+		return hash_combine(kind_hash, std::hash<uint32_t>()(float32_value == 0.0f ? 0 : bit_cast<uint32_t>(float32_value)));
+	}
+	case constant_value_kind::float64:
+	{
+		auto const float64_value = value.get_float64();
+		return hash_combine(kind_hash, std::hash<uint64_t>()(float64_value == 0.0 ? 0 : bit_cast<uint64_t>(float64_value)));
+	}
+	case constant_value_kind::u8char:
+		return hash_combine(kind_hash, std::hash<uint32_t>()(bit_cast<uint32_t>(value.get_u8char())));
+	case constant_value_kind::string:
+	{
+		auto const str = value.get_string();
+		auto const str_view = std::string_view(reinterpret_cast<char const *>(str.data()), str.size());
+		return hash_combine(kind_hash, std::hash<std::string_view>()(str_view));
+	}
+	case constant_value_kind::boolean:
+		return hash_combine(kind_hash, std::hash<bool>()(value.get_boolean()));
+	case constant_value_kind::null:
+	case constant_value_kind::void_:
+		return kind_hash;
+	case constant_value_kind::enum_:
+	{
+		auto const [decl, enum_value] = value.get_enum();
+		return hash_combine(hash_combine(kind_hash, std::hash<void const *>()(decl)), std::hash<uint64_t>()(enum_value));
+	}
+	case constant_value_kind::array:
+		return hash_combine(kind_hash, hash_constant_value_array(value.get_array()));
+	case constant_value_kind::sint_array:
+		return hash_combine(kind_hash, hash_constant_value_array(value.get_sint_array()));
+	case constant_value_kind::uint_array:
+		return hash_combine(kind_hash, hash_constant_value_array(value.get_uint_array()));
+	case constant_value_kind::float32_array:
+		return hash_combine(kind_hash, hash_constant_value_array(value.get_float32_array()));
+	case constant_value_kind::float64_array:
+		return hash_combine(kind_hash, hash_constant_value_array(value.get_float64_array()));
+	case constant_value_kind::tuple:
+		return hash_combine(kind_hash, hash_constant_value_array(value.get_tuple()));
+	case constant_value_kind::function:
+		return hash_combine(kind_hash, std::hash<void const *>()(value.get_function()));
+	case constant_value_kind::type:
+		return hash_combine(kind_hash, typespec_hash()(value.get_type()));
+	case constant_value_kind::aggregate:
+		return hash_combine(kind_hash, hash_constant_value_array(value.get_aggregate()));
+	default:
+		bz_unreachable;
+	}
+}
+
 } // namespace ast
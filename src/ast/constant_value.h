@@ -266,6 +266,12 @@ bz::u8string get_value_string(constant_value const &value);
 bool operator == (constant_value const &lhs, constant_value const &rhs) noexcept;
 bool operator != (constant_value const &lhs, constant_value const &rhs) noexcept;
 
+// consistent with operator ==, so e.g. -0.0 and 0.0 have the same hash
+struct constant_value_hash
+{
+	size_t operator () (constant_value const &value) const noexcept;
+};
+
 } // namespace ast
 
 #endif // AST_CONSTANT_VALUE_H
@@ -1471,11 +1471,21 @@ struct expr_compound
 	);
 };
 
+// set with '@likely' and '@unlikely' on the branches of if and switch expressions
+enum class branch_likelihood : uint8_t
+{
+	none,
+	likely,
+	unlikely,
+};
+
 struct expr_if
 {
 	expression condition;
 	expression then_block;
 	expression else_block;
+	// a hint on the else block is stored as the opposite hint for the then block
+	branch_likelihood then_likelihood = branch_likelihood::none;
 
 	expr_if(
 		expression _condition,
@@ -1531,10 +1541,13 @@ struct switch_case
 
 struct expr_switch
 {
-	expression                matched_expr;
-	expression                default_case;
-	arena_vector<switch_case> cases;
-	bool                      is_complete;
+	expression                      matched_expr;
+	expression                      default_case;
+	arena_vector<switch_case>       cases;
+	// empty if there are no '@likely' or '@unlikely' hints, otherwise it has one element per case
+	arena_vector<branch_likelihood> case_likelihoods;
+	branch_likelihood               default_likelihood = branch_likelihood::none;
+	bool                            is_complete;
 
 	expr_switch(
 		expression                _matched_expr,
@@ -12,14 +12,26 @@ namespace ast
 struct identifier
 {
 	lex::token_range tokens = {};
-	arena_vector<bz::u8string_view> values{};
+	// interned identifier values, see lex::intern_identifier
+	arena_vector<uint32_t> ids{};
 	bool is_qualified = false;
 
+	bz::u8string_view get_value(size_t i) const
+	{
+		bz_assert(i < this->ids.size());
+		return lex::get_identifier_value(this->ids[i]);
+	}
+
+	auto get_values(void) const
+	{
+		return this->ids.transform([](uint32_t const id) { return lex::get_identifier_value(id); });
+	}
+
 	bz::u8string format_as_unqualified(void) const
 	{
 		bz::u8string result;
 		bool first = true;
-		for (auto const value : this->values)
+		for (auto const value : this->get_values())
 		{
 			if (first)
 			{
@@ -39,7 +51,7 @@ struct identifier
 	{
 		bz::u8string result;
 		bool first = true;
-		for (auto const value : this->values)
+		for (auto const value : this->get_values())
 		{
 			if (first)
 			{
@@ -58,7 +70,7 @@ struct identifier
 	{
 		bz::u8string result;
 		bool first = true;
-		for (auto const value : this->values)
+		for (auto const value : this->get_values())
 		{
 			if (first)
 			{
@@ -82,7 +94,7 @@ struct identifier
 			result += "::";
 		}
 		bool first = true;
-		for (auto const value : this->values)
+		for (auto const value : this->get_values())
 		{
 			if (first)
 			{
@@ -99,17 +111,17 @@ struct identifier
 	}
 
 	bool empty(void) const noexcept
-	{ return this->values.empty(); }
+	{ return this->ids.empty(); }
 
 	bool not_empty(void) const noexcept
-	{ return this->values.not_empty(); }
+	{ return this->ids.not_empty(); }
 };
 
 inline identifier make_identifier(lex::token_pos id)
 {
 	return {
 		{ id, id + 1 },
-		{ id->value },
+		{ id->get_identifier_id() },
 		false
 	};
 }
@@ -118,7 +130,7 @@ inline identifier make_identifier(bz::u8string_view id)
 {
 	return {
 		{},
-		{ id },
+		{ lex::intern_identifier(id) },
 		false
 	};
 }
@@ -132,12 +144,12 @@ inline identifier make_identifier(lex::token_range tokens)
 		{},
 		tokens.begin->kind == lex::token::scope
 	};
-	result.values.reserve((tokens.end - tokens.begin + 1) / 2);
+	result.ids.reserve((tokens.end - tokens.begin + 1) / 2);
 	for (auto it = tokens.begin; it != tokens.end; ++it)
 	{
 		if (it->kind == lex::token::identifier)
 		{
-			result.values.push_back(it->value);
+			result.ids.push_back(it->get_identifier_id());
 		}
 	}
 	return result;
@@ -146,8 +158,8 @@ inline identifier make_identifier(lex::token_range tokens)
 inline bool operator == (identifier const &lhs, identifier const &rhs) noexcept
 {
 	return lhs.is_qualified == rhs.is_qualified
-		&& lhs.values.size() == rhs.values.size()
-		&& std::equal(lhs.values.begin(), lhs.values.end(), rhs.values.begin());
+		&& lhs.ids.size() == rhs.ids.size()
+		&& std::equal(lhs.ids.begin(), lhs.ids.end(), rhs.ids.begin());
 }
 
 inline bool operator != (identifier const &lhs, identifier const &rhs) noexcept
@@ -5,7 +5,7 @@ namespace ast
 {
 
 std::pair<global_scope_symbol_list_t::id_map_t::iterator, bool> global_scope_symbol_list_t::insert(
-	bz::array_view<bz::u8string_view const> id,
+	bz::array_view<uint32_t const> id,
 	global_scope_symbol_index_t index
 )
 {
@@ -23,14 +23,14 @@ std::pair<global_scope_symbol_list_t::id_map_t::iterator, bool> global_scope_sym
 
 static_assert(statement::variant_count == 17);
 
-void global_scope_symbol_list_t::add_variable(bz::array_view<bz::u8string_view const> id, decl_variable &var_decl)
+void global_scope_symbol_list_t::add_variable(bz::array_view<uint32_t const> id, decl_variable &var_decl)
 {
 	auto const index = this->variables.size();
 	this->variables.push_back(&var_decl);
 
 	if (id.empty())
 	{
-		id = var_decl.get_id().values;
+		id = var_decl.get_id().ids;
 	}
 
 	auto const [it, inserted] = this->insert(id, {
@@ -54,14 +54,14 @@ void global_scope_symbol_list_t::add_variable(bz::array_view<bz::u8string_view c
 	}
 }
 
-void global_scope_symbol_list_t::add_variable(bz::array_view<bz::u8string_view const> id, decl_variable &original_decl, arena_vector<decl_variable *> variadic_decls)
+void global_scope_symbol_list_t::add_variable(bz::array_view<uint32_t const> id, decl_variable &original_decl, arena_vector<decl_variable *> variadic_decls)
 {
 	auto const index = this->variadic_variables.size();
 	this->variadic_variables.push_back({ &original_decl, std::move(variadic_decls) });
 
 	if (id.empty())
 	{
-		id = original_decl.get_id().values;
+		id = original_decl.get_id().ids;
 	}
 
 	auto const [it, inserted] = this->insert(id, {
@@ -85,11 +85,11 @@ void global_scope_symbol_list_t::add_variable(bz::array_view<bz::u8string_view c
 	}
 }
 
-void global_scope_symbol_list_t::add_function(bz::array_view<bz::u8string_view const> id, decl_function &func_decl)
+void global_scope_symbol_list_t::add_function(bz::array_view<uint32_t const> id, decl_function &func_decl)
 {
 	if (id.empty())
 	{
-		id = func_decl.id.values;
+		id = func_decl.id.ids;
 	}
 
 	auto const potential_index = this->function_sets.size();
@@ -129,11 +129,11 @@ void global_scope_symbol_list_t::add_function(bz::array_view<bz::u8string_view c
 	}
 }
 
-void global_scope_symbol_list_t::add_function_alias(bz::array_view<bz::u8string_view const> id, decl_function_alias &alias_decl)
+void global_scope_symbol_list_t::add_function_alias(bz::array_view<uint32_t const> id, decl_function_alias &alias_decl)
 {
 	if (id.empty())
 	{
-		id = alias_decl.id.values;
+		id = alias_decl.id.ids;
 	}
 
 	auto const potential_index = this->function_sets.size();
@@ -209,14 +209,14 @@ void global_scope_symbol_list_t::add_operator_alias(decl_operator_alias &alias_d
 	}
 }
 
-void global_scope_symbol_list_t::add_type_alias(bz::array_view<bz::u8string_view const> id, decl_type_alias &alias_decl)
+void global_scope_symbol_list_t::add_type_alias(bz::array_view<uint32_t const> id, decl_type_alias &alias_decl)
 {
 	auto const index = this->type_aliases.size();
 	this->type_aliases.push_back(&alias_decl);
 
 	if (id.empty())
 	{
-		id = alias_decl.id.values;
+		id = alias_decl.id.ids;
 	}
 
 	auto const [it, inserted] = this->insert(id, {
@@ -240,14 +240,14 @@ void global_scope_symbol_list_t::add_type_alias(bz::array_view<bz::u8string_view
 	}
 }
 
-void global_scope_symbol_list_t::add_struct(bz::array_view<bz::u8string_view const> id, decl_struct &struct_decl)
+void global_scope_symbol_list_t::add_struct(bz::array_view<uint32_t const> id, decl_struct &struct_decl)
 {
 	auto const index = this->structs.size();
 	this->structs.push_back(&struct_decl);
 
 	if (id.empty())
 	{
-		id = struct_decl.id.values;
+		id = struct_decl.id.ids;
 	}
 
 	auto const [it, inserted] = this->insert(id, {
@@ -271,14 +271,14 @@ void global_scope_symbol_list_t::add_struct(bz::array_view<bz::u8string_view con
 	}
 }
 
-void global_scope_symbol_list_t::add_enum(bz::array_view<bz::u8string_view const> id, decl_enum &enum_decl)
+void global_scope_symbol_list_t::add_enum(bz::array_view<uint32_t const> id, decl_enum &enum_decl)
 {
 	auto const index = this->enums.size();
 	this->enums.push_back(&enum_decl);
 
 	if (id.empty())
 	{
-		id = enum_decl.id.values;
+		id = enum_decl.id.ids;
 	}
 
 	auto const [it, inserted] = this->insert(id, {
@@ -302,9 +302,9 @@ void global_scope_symbol_list_t::add_enum(bz::array_view<bz::u8string_view const
 	}
 }
 
-global_scope_symbol_index_t global_scope_symbol_list_t::get_symbol_index_by_id(identifier const &id) const
+global_scope_symbol_index_t global_scope_symbol_list_t::get_symbol_index_by_id(bz::array_view<uint32_t const> id) const
 {
-	auto const it = this->id_map.find(id.values);
+	auto const it = this->id_map.find(id);
 	if (it != this->id_map.end())
 	{
 		return it->second;
@@ -315,9 +315,9 @@ global_scope_symbol_index_t global_scope_symbol_list_t::get_symbol_index_by_id(i
 	}
 }
 
-bz::array_view<global_scope_symbol_index_t const> global_scope_symbol_list_t::get_ambiguous_symbols_by_id(identifier const &id) const
+bz::array_view<global_scope_symbol_index_t const> global_scope_symbol_list_t::get_ambiguous_symbols_by_id(bz::array_view<uint32_t const> id) const
 {
-	auto const it = this->ambiguous_id_map.find(id.values);
+	auto const it = this->ambiguous_id_map.find(id);
 	if (it != this->ambiguous_id_map.end())
 	{
 		return it->second;
@@ -328,7 +328,216 @@ bz::array_view<global_scope_symbol_index_t const> global_scope_symbol_list_t::ge
 	}
 }
 
-void global_scope_t::add_variable(bz::array_view<bz::u8string_view const> id, decl_variable &var_decl)
+operator_overload_set const *global_scope_symbol_list_t::get_operator_set(uint32_t op) const
+{
+	auto const it = std::find_if(
+		this->operator_sets.begin(), this->operator_sets.end(),
+		[op](auto const &set) {
+			return set.op == op;
+		}
+	);
+	if (it != this->operator_sets.end())
+	{
+		return &*it;
+	}
+	else
+	{
+		return nullptr;
+	}
+}
+
+bz::array_view<decl_function * const> global_scope_symbol_t::get_func_decls(void) const
+{
+	bz_assert(this->symbol_kind == global_scope_symbol_kind::function_set);
+	if (this->symbols != nullptr)
+	{
+		return this->symbols->function_sets[this->index].func_decls;
+	}
+	else
+	{
+		return this->func_decls;
+	}
+}
+
+bz::array_view<decl_function_alias * const> global_scope_symbol_t::get_alias_decls(void) const
+{
+	bz_assert(this->symbol_kind == global_scope_symbol_kind::function_set);
+	if (this->symbols != nullptr)
+	{
+		return this->symbols->function_sets[this->index].alias_decls;
+	}
+	else
+	{
+		return this->alias_decls;
+	}
+}
+
+// the functions below merge the symbols of an id from multiple symbol lists the same way
+// global_scope_symbol_list_t::add_* would if the symbols were added to a single list one by one
+
+static void add_decl_to_function_set(global_scope_symbol_t &symbol, decl_function *func_decl)
+{
+	symbol.func_decls.push_back(func_decl);
+}
+
+static void add_decl_to_function_set(global_scope_symbol_t &symbol, decl_function_alias *alias_decl)
+{
+	symbol.alias_decls.push_back(alias_decl);
+}
+
+template<typename Decl>
+static void add_function_to_lookup_result(global_scope_lookup_result_t &result, Decl *decl)
+{
+	switch (result.symbol.symbol_kind)
+	{
+	case global_scope_symbol_kind::none:
+		result.symbol.symbol_kind = global_scope_symbol_kind::function_set;
+		add_decl_to_function_set(result.symbol, decl);
+		break;
+	case global_scope_symbol_kind::function_set:
+		if (result.symbol.symbols != nullptr)
+		{
+			auto const &set = result.symbol.symbols->function_sets[result.symbol.index];
+			result.symbol.func_decls.append(set.func_decls);
+			result.symbol.alias_decls.append(set.alias_decls);
+			result.symbol.symbols = nullptr;
+			result.symbol.index = 0;
+		}
+		add_decl_to_function_set(result.symbol, decl);
+		break;
+	case global_scope_symbol_kind::ambiguous:
+		// functions are not added to an already ambiguous id, see global_scope_symbol_list_t::add_function
+		break;
+	default:
+	{
+		result.ambiguous_symbols.push_back(std::move(result.symbol));
+		auto &set = result.ambiguous_symbols.emplace_back();
+		set.symbol_kind = global_scope_symbol_kind::function_set;
+		add_decl_to_function_set(set, decl);
+		result.symbol = {
+			.symbol_kind = global_scope_symbol_kind::ambiguous,
+			.symbols = nullptr,
+			.index = 0,
+			.func_decls = {},
+			.alias_decls = {},
+		};
+		break;
+	}
+	}
+}
+
+static void add_to_lookup_result(
+	global_scope_lookup_result_t &result,
+	global_scope_symbol_list_t const &symbols,
+	global_scope_symbol_index_t symbol_index
+)
+{
+	auto const [kind, index] = symbol_index;
+	if (kind == global_scope_symbol_kind::function_set && result.symbol.symbol_kind != global_scope_symbol_kind::none)
+	{
+		auto const &set = symbols.function_sets[index];
+		for (auto const func_decl : set.func_decls)
+		{
+			add_function_to_lookup_result(result, func_decl);
+		}
+		for (auto const alias_decl : set.alias_decls)
+		{
+			add_function_to_lookup_result(result, alias_decl);
+		}
+		return;
+	}
+
+	global_scope_symbol_t symbol = {
+		.symbol_kind = kind,
+		.symbols = &symbols,
+		.index = index,
+		.func_decls = {},
+		.alias_decls = {},
+	};
+	switch (result.symbol.symbol_kind)
+	{
+	case global_scope_symbol_kind::none:
+		result.symbol = std::move(symbol);
+		break;
+	case global_scope_symbol_kind::ambiguous:
+		result.ambiguous_symbols.push_back(std::move(symbol));
+		break;
+	default:
+		result.ambiguous_symbols.push_back(std::move(result.symbol));
+		result.ambiguous_symbols.push_back(std::move(symbol));
+		result.symbol = {
+			.symbol_kind = global_scope_symbol_kind::ambiguous,
+			.symbols = nullptr,
+			.index = 0,
+			.func_decls = {},
+			.alias_decls = {},
+		};
+		break;
+	}
+}
+
+// 'id' must start with the prefix of 'import'
+static void add_imported_symbols_to_lookup_result(
+	global_scope_lookup_result_t &result,
+	imported_symbol_list_t const &import,
+	bz::array_view<uint32_t const> id
+)
+{
+	auto const &symbols = *import.symbols;
+	auto const symbol_id = id.slice(import.prefix.size());
+	auto const symbol_index = symbols.get_symbol_index_by_id(symbol_id);
+	if (symbol_index.symbol_kind == global_scope_symbol_kind::ambiguous)
+	{
+		auto const it = import.ambiguous_id_map.find(symbol_id);
+		bz_assert(it != import.ambiguous_id_map.end());
+		for (auto const ambiguous_id : it->second)
+		{
+			add_to_lookup_result(result, symbols, ambiguous_id);
+		}
+	}
+	else if (symbol_index.symbol_kind != global_scope_symbol_kind::none)
+	{
+		add_to_lookup_result(result, symbols, symbol_index);
+	}
+}
+
+static global_scope_lookup_result_t find_by_id_in_symbol_list(
+	global_scope_symbol_list_t const &symbols,
+	bz::array_view<uint32_t const> id
+)
+{
+	global_scope_lookup_result_t result;
+
+	auto const [kind, index] = symbols.get_symbol_index_by_id(id);
+	if (kind == global_scope_symbol_kind::ambiguous)
+	{
+		result.symbol.symbol_kind = global_scope_symbol_kind::ambiguous;
+		for (auto const [ambiguous_kind, ambiguous_index] : symbols.get_ambiguous_symbols_by_id(id))
+		{
+			result.ambiguous_symbols.push_back({
+				.symbol_kind = ambiguous_kind,
+				.symbols = &symbols,
+				.index = ambiguous_index,
+				.func_decls = {},
+				.alias_decls = {},
+			});
+		}
+	}
+	else if (kind != global_scope_symbol_kind::none)
+	{
+		result.symbol = {
+			.symbol_kind = kind,
+			.symbols = &symbols,
+			.index = index,
+			.func_decls = {},
+			.alias_decls = {},
+		};
+	}
+
+	return result;
+}
+
+void global_scope_t::add_variable(bz::array_view<uint32_t const> id, decl_variable &var_decl)
 {
 	this->all_symbols.add_variable(id, var_decl);
 	if (var_decl.is_module_export())
@@ -337,7 +546,7 @@ void global_scope_t::add_variable(bz::array_view<bz::u8string_view const> id, de
 	}
 }
 
-void global_scope_t::add_variable(bz::array_view<bz::u8string_view const> id, decl_variable &original_decl, arena_vector<decl_variable *> variadic_decls)
+void global_scope_t::add_variable(bz::array_view<uint32_t const> id, decl_variable &original_decl, arena_vector<decl_variable *> variadic_decls)
 {
 	if (original_decl.is_module_export())
 	{
@@ -350,7 +559,7 @@ void global_scope_t::add_variable(bz::array_view<bz::u8string_view const> id, de
 	}
 }
 
-void global_scope_t::add_function(bz::array_view<bz::u8string_view const> id, decl_function &func_decl)
+void global_scope_t::add_function(bz::array_view<uint32_t const> id, decl_function &func_decl)
 {
 	this->all_symbols.add_function(id, func_decl);
 	if (func_decl.body.is_export())
@@ -359,7 +568,7 @@ void global_scope_t::add_function(bz::array_view<bz::u8string_view const> id, de
 	}
 }
 
-void global_scope_t::add_function_alias(bz::array_view<bz::u8string_view const> id, decl_function_alias &alias_decl)
+void global_scope_t::add_function_alias(bz::array_view<uint32_t const> id, decl_function_alias &alias_decl)
 {
 	this->all_symbols.add_function_alias(id, alias_decl);
 	if (alias_decl.is_export)
@@ -386,7 +595,7 @@ void global_scope_t::add_operator_alias(decl_operator_alias &alias_decl)
 	}
 }
 
-void global_scope_t::add_type_alias(bz::array_view<bz::u8string_view const> id, decl_type_alias &alias_decl)
+void global_scope_t::add_type_alias(bz::array_view<uint32_t const> id, decl_type_alias &alias_decl)
 {
 	this->all_symbols.add_type_alias(id, alias_decl);
 	if (alias_decl.is_module_export())
@@ -395,7 +604,7 @@ void global_scope_t::add_type_alias(bz::array_view<bz::u8string_view const> id,
 	}
 }
 
-void global_scope_t::add_struct(bz::array_view<bz::u8string_view const> id, decl_struct &struct_decl)
+void global_scope_t::add_struct(bz::array_view<uint32_t const> id, decl_struct &struct_decl)
 {
 	this->all_symbols.add_struct(id, struct_decl);
 	if (struct_decl.info.is_module_export())
@@ -404,7 +613,7 @@ void global_scope_t::add_struct(bz::array_view<bz::u8string_view const> id, decl
 	}
 }
 
-void global_scope_t::add_enum(bz::array_view<bz::u8string_view const> id, decl_enum &enum_decl)
+void global_scope_t::add_enum(bz::array_view<uint32_t const> id, decl_enum &enum_decl)
 {
 	this->all_symbols.add_enum(id, enum_decl);
 	if (enum_decl.is_module_export())
@@ -413,6 +622,83 @@ void global_scope_t::add_enum(bz::array_view<bz::u8string_view const> id, decl_e
 	}
 }
 
+void global_scope_t::add_import(bz::array_view<uint32_t const> prefix, global_scope_symbol_list_t const &import_symbols)
+{
+	auto const import_index = this->imported_symbols.size();
+	auto &import = this->imported_symbols.emplace_back();
+	import.symbols = &import_symbols;
+	import.prefix = prefix;
+
+	// the global symbols of a file are all added before its imports are resolved, so the export symbols
+	// of an imported file don't change after this and the ambiguous ids can be ordered only once here
+	for (auto const &[id, ambiguous_ids] : import_symbols.ambiguous_id_map)
+	{
+		auto &sorted_ids = import.ambiguous_id_map[id];
+		sorted_ids = ambiguous_ids;
+		std::sort(
+			sorted_ids.begin(), sorted_ids.end(),
+			[](auto const &lhs, auto const &rhs) {
+				return lhs.symbol_kind < rhs.symbol_kind || (lhs.symbol_kind == rhs.symbol_kind && lhs.index < rhs.index);
+			}
+		);
+	}
+
+	this->import_indices_by_prefix[import.prefix.as_array_view()].push_back(static_cast<uint32_t>(import_index));
+	this->max_import_prefix_size = std::max(this->max_import_prefix_size, import.prefix.size());
+}
+
+global_scope_lookup_result_t global_scope_t::find_by_id(bz::array_view<uint32_t const> id) const
+{
+	auto result = find_by_id_in_symbol_list(this->all_symbols, id);
+	if (id.empty())
+	{
+		return result;
+	}
+
+	// only the imports whose prefix is a proper prefix of 'id' can have a symbol with this id.  usually only
+	// one of the prefixes matches, otherwise the imports of all matching prefixes are merged in import order
+	bz::array_view<uint32_t const> import_indices;
+	bz::vector<uint32_t> merged_import_indices;
+	auto const max_prefix_size = std::min(this->max_import_prefix_size, id.size() - 1);
+	for (auto const prefix_size : bz::iota(0, max_prefix_size + 1))
+	{
+		auto const it = this->import_indices_by_prefix.find(id.slice(0, prefix_size));
+		if (it == this->import_indices_by_prefix.end())
+		{
+			continue;
+		}
+		else if (import_indices.empty())
+		{
+			import_indices = it->second;
+		}
+		else
+		{
+			bz::vector<uint32_t> merged;
+			merged.resize(import_indices.size() + it->second.size());
+			std::merge(
+				import_indices.begin(), import_indices.end(),
+				it->second.begin(), it->second.end(),
+				merged.begin()
+			);
+			merged_import_indices = std::move(merged);
+			import_indices = merged_import_indices;
+		}
+	}
+
+	for (auto const import_index : import_indices)
+	{
+		add_imported_symbols_to_lookup_result(result, this->imported_symbols[import_index], id);
+	}
+
+	return result;
+}
+
+global_scope_lookup_result_t global_scope_t::find_export_by_id(bz::array_view<uint32_t const> id) const
+{
+	// imported symbols are not exported
+	return find_by_id_in_symbol_list(this->export_symbols, id);
+}
+
 identifier const &local_symbol_t::get_id(void) const
 {
 	static_assert(variant_count == 7);
@@ -463,7 +749,7 @@ lex::src_tokens const &local_symbol_t::get_src_tokens(void) const
 
 local_symbol_t *local_scope_t::find_by_id(identifier const &id, size_t bound) noexcept
 {
-	if (id.is_qualified || id.values.size() != 1)
+	if (id.is_qualified || id.ids.size() != 1)
 	{
 		return nullptr;
 	}
@@ -72,14 +72,13 @@ struct global_scope_symbol_index_t
 
 struct identifier_hash
 {
-	size_t operator () (bz::array_view<bz::u8string_view const> id) const
+	size_t operator () (bz::array_view<uint32_t const> id) const
 	{
-		auto hasher = std::hash<std::string_view>();
 		size_t result = 0;
 		for (auto const value : id)
 		{
 			// https://stackoverflow.com/questions/35985960/c-why-is-boosthash-combine-the-best-way-to-combine-hash-values
-			result ^= hasher(std::string_view(value.data(), value.size())) + 0x9e3779b9 + (result << 6) + (result >> 2);
+			result ^= std::hash<uint32_t>()(value) + 0x9e3779b9 + (result << 6) + (result >> 2);
 		}
 		return result;
 	}
@@ -95,43 +94,87 @@ struct global_scope_symbol_list_t
 	arena_vector<decl_struct     *> structs;
 	arena_vector<decl_enum       *> enums;
 
-	using id_map_t = std::unordered_map<bz::array_view<bz::u8string_view const>, global_scope_symbol_index_t, identifier_hash>;
-	using ambiguous_id_map_t = std::unordered_map<bz::array_view<bz::u8string_view const>, bz::vector<global_scope_symbol_index_t>, identifier_hash>;
+	using id_map_t = std::unordered_map<bz::array_view<uint32_t const>, global_scope_symbol_index_t, identifier_hash>;
+	using ambiguous_id_map_t = std::unordered_map<bz::array_view<uint32_t const>, bz::vector<global_scope_symbol_index_t>, identifier_hash>;
 
 	id_map_t id_map;
 	ambiguous_id_map_t ambiguous_id_map;
-	bz::vector<bz::vector<bz::u8string_view>> id_storage;
+	bz::vector<bz::vector<uint32_t>> id_storage;
 
-	std::pair<id_map_t::iterator, bool> insert(bz::array_view<bz::u8string_view const> id, global_scope_symbol_index_t index);
+	std::pair<id_map_t::iterator, bool> insert(bz::array_view<uint32_t const> id, global_scope_symbol_index_t index);
 
-	void add_variable(bz::array_view<bz::u8string_view const> id, decl_variable &var_decl);
-	void add_variable(bz::array_view<bz::u8string_view const> id, decl_variable &original_decl, arena_vector<decl_variable *> variadic_decls);
-	void add_function(bz::array_view<bz::u8string_view const> id, decl_function &func_decl);
-	void add_function_alias(bz::array_view<bz::u8string_view const> id, decl_function_alias &alias_decl);
+	void add_variable(bz::array_view<uint32_t const> id, decl_variable &var_decl);
+	void add_variable(bz::array_view<uint32_t const> id, decl_variable &original_decl, arena_vector<decl_variable *> variadic_decls);
+	void add_function(bz::array_view<uint32_t const> id, decl_function &func_decl);
+	void add_function_alias(bz::array_view<uint32_t const> id, decl_function_alias &alias_decl);
 	void add_operator(decl_operator &op_decl);
 	void add_operator_alias(decl_operator_alias &alias_decl);
-	void add_type_alias(bz::array_view<bz::u8string_view const> id, decl_type_alias &alias_decl);
-	void add_struct(bz::array_view<bz::u8string_view const> id, decl_struct &struct_decl);
-	void add_enum(bz::array_view<bz::u8string_view const> id, decl_enum &enum_decl);
+	void add_type_alias(bz::array_view<uint32_t const> id, decl_type_alias &alias_decl);
+	void add_struct(bz::array_view<uint32_t const> id, decl_struct &struct_decl);
+	void add_enum(bz::array_view<uint32_t const> id, decl_enum &enum_decl);
 
-	global_scope_symbol_index_t get_symbol_index_by_id(identifier const &id) const;
-	bz::array_view<global_scope_symbol_index_t const> get_ambiguous_symbols_by_id(identifier const &id) const;
+	global_scope_symbol_index_t get_symbol_index_by_id(bz::array_view<uint32_t const> id) const;
+	bz::array_view<global_scope_symbol_index_t const> get_ambiguous_symbols_by_id(bz::array_view<uint32_t const> id) const;
+	operator_overload_set const *get_operator_set(uint32_t op) const;
+};
+
+// the export symbols of an imported file, which are accessible with 'prefix' prepended to their ids
+struct imported_symbol_list_t
+{
+	global_scope_symbol_list_t const *symbols;
+	arena_vector<uint32_t> prefix;
+	// the ambiguous ids of 'symbols', grouped by kind and in declaration order within a kind,
+	// which is the order they are merged into a lookup result
+	global_scope_symbol_list_t::ambiguous_id_map_t ambiguous_id_map;
+};
+
+struct global_scope_symbol_t
+{
+	global_scope_symbol_kind symbol_kind = global_scope_symbol_kind::none;
+	// the symbol is at 'index' in 'symbols', except for function sets that are merged from multiple
+	// symbol lists, in which case 'symbols' is null and the declarations are in 'func_decls' and 'alias_decls'
+	global_scope_symbol_list_t const *symbols = nullptr;
+	uint32_t index = 0;
+	bz::vector<decl_function *>       func_decls;
+	bz::vector<decl_function_alias *> alias_decls;
+
+	bz::array_view<decl_function * const> get_func_decls(void) const;
+	bz::array_view<decl_function_alias * const> get_alias_decls(void) const;
+};
+
+struct global_scope_lookup_result_t
+{
+	global_scope_symbol_t symbol;
+	// only used if symbol.symbol_kind is ambiguous
+	bz::vector<global_scope_symbol_t> ambiguous_symbols;
 };
 
 struct global_scope_t
 {
 	global_scope_symbol_list_t all_symbols;
 	global_scope_symbol_list_t export_symbols;
-
-	void add_variable(bz::array_view<bz::u8string_view const> id, decl_variable &var_decl);
-	void add_variable(bz::array_view<bz::u8string_view const> id, decl_variable &original_decl, arena_vector<decl_variable *> variadic_decls);
-	void add_function(bz::array_view<bz::u8string_view const> id, decl_function &func_decl);
-	void add_function_alias(bz::array_view<bz::u8string_view const> id, decl_function_alias &alias_decl);
+	// imported symbols are not copied into all_symbols, lookups fall through to these lists instead
+	arena_vector<imported_symbol_list_t> imported_symbols;
+
+	using import_prefix_map_t = std::unordered_map<bz::array_view<uint32_t const>, bz::vector<uint32_t>, identifier_hash>;
+	// the indices of the imports in imported_symbols by their prefix, in the order they were added.
+	// the keys point into the prefixes in imported_symbols
+	import_prefix_map_t import_indices_by_prefix;
+	size_t max_import_prefix_size = 0;
+
+	void add_variable(bz::array_view<uint32_t const> id, decl_variable &var_decl);
+	void add_variable(bz::array_view<uint32_t const> id, decl_variable &original_decl, arena_vector<decl_variable *> variadic_decls);
+	void add_function(bz::array_view<uint32_t const> id, decl_function &func_decl);
+	void add_function_alias(bz::array_view<uint32_t const> id, decl_function_alias &alias_decl);
 	void add_operator(decl_operator &op_decl);
 	void add_operator_alias(decl_operator_alias &alias_decl);
-	void add_type_alias(bz::array_view<bz::u8string_view const> id, decl_type_alias &alias_decl);
-	void add_struct(bz::array_view<bz::u8string_view const> id, decl_struct &struct_decl);
-	void add_enum(bz::array_view<bz::u8string_view const> id, decl_enum &enum_decl);
+	void add_type_alias(bz::array_view<uint32_t const> id, decl_type_alias &alias_decl);
+	void add_struct(bz::array_view<uint32_t const> id, decl_struct &struct_decl);
+	void add_enum(bz::array_view<uint32_t const> id, decl_enum &enum_decl);
+	void add_import(bz::array_view<uint32_t const> prefix, global_scope_symbol_list_t const &import_symbols);
+
+	global_scope_lookup_result_t find_by_id(bz::array_view<uint32_t const> id) const;
+	global_scope_lookup_result_t find_export_by_id(bz::array_view<uint32_t const> id) const;
 
 	enclosing_scope_t parent = {};
 };
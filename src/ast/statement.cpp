@@ -479,41 +479,9 @@ type_info *type_info::add_generic_instantiation(
 		generic_params.size() == this->generic_parameters.size()
 		|| (!this->generic_parameters.empty() && this->generic_parameters.back().get_type().is<ast::ts_variadic>())
 	);
-	auto const is_equal_params = [](auto const &lhs, auto const &rhs) {
-		if (lhs.size() != rhs.size())
-		{
-			return false;
-		}
-		for (auto const &[lhs_param, rhs_param] : bz::zip(lhs, rhs))
-		{
-			if (lhs_param.get_type() != rhs_param.get_type())
-			{
-				return false;
-			}
-			else if (is_generic_parameter(lhs_param))
-			{
-				bz_assert(lhs_param.init_expr.is_constant());
-				bz_assert(rhs_param.init_expr.is_constant());
-				auto const &lhs_val = lhs_param.init_expr.get_constant_value();
-				auto const &rhs_val = rhs_param.init_expr.get_constant_value();
-				if (lhs_val != rhs_val)
-				{
-					return false;
-				}
-			}
-		}
-		return true;
-	};
-	auto const it = std::find_if(
-		this->generic_instantiations.begin(), this->generic_instantiations.end(),
-		[&](auto const &instantiation) {
-			return is_equal_params(instantiation->generic_parameters, generic_params);
-		}
-	);
-
-	if (it != this->generic_instantiations.end())
+	if (auto const it = this->generic_instantiations_map.find(generic_params); it != this->generic_instantiations_map.end())
 	{
-		return it->get();
+		return it->second;
 	}
 
 	this->generic_instantiations.emplace_back(make_ast_unique<type_info>(*this, generic_copy_t{}));
@@ -521,6 +489,8 @@ type_info *type_info::add_generic_instantiation(
 	info->generic_parameters = std::move(generic_params);
 	info->generic_parent = this;
 	info->generic_required_from.append(std::move(required_from));
+
+	this->generic_instantiations_map.insert({ info->generic_parameters, info });
 	return info;
 }
 
@@ -628,7 +598,7 @@ bz::u8string_view decl_enum::get_value_name(uint64_t value) const
 		}
 		else
 		{
-			return it->id->value;
+			return it->id->get_value();
 		}
 	}
 	else
@@ -645,7 +615,7 @@ bz::u8string_view decl_enum::get_value_name(uint64_t value) const
 		}
 		else
 		{
-			return it->id->value;
+			return it->id->get_value();
 		}
 	}
 }
@@ -744,23 +714,23 @@ decl_enum::decl_operator_ptr decl_enum::make_default_compare_op(
 bz::vector<universal_function_set> make_builtin_universal_functions(void)
 {
 	return {
-		{ "size", {
+		{ lex::intern_identifier("size"), {
 			function_body::builtin_slice_size,
 			function_body::builtin_array_size,
 		}},
-		{ "begin", {
+		{ lex::intern_identifier("begin"), {
 			function_body::builtin_slice_begin_ptr,
 			function_body::builtin_slice_begin_mut_ptr,
 			function_body::builtin_array_begin_ptr,
 			function_body::builtin_array_begin_mut_ptr,
 		}},
-		{ "end", {
+		{ lex::intern_identifier("end"), {
 			function_body::builtin_slice_end_ptr,
 			function_body::builtin_slice_end_mut_ptr,
 			function_body::builtin_array_end_ptr,
 			function_body::builtin_array_end_mut_ptr,
 		}},
-		{ "get_value", {
+		{ lex::intern_identifier("get_value"), {
 			function_body::builtin_optional_get_value_ref,
 			function_body::builtin_optional_get_mut_value_ref,
 			function_body::builtin_optional_get_value,
@@ -414,11 +414,16 @@ struct decl_variable
 	identifier const &get_id(void) const
 	{ return this->id_and_type.id; }
 
-	bz::u8string_view get_unqualified_id_value(void) const
+	uint32_t get_unqualified_id(void) const
 	{
 		auto const &id = this->get_id();
-		bz_assert(!id.is_qualified && id.values.size() == 1);
-		return id.values.front();
+		bz_assert(!id.is_qualified && id.ids.size() == 1);
+		return id.ids.front();
+	}
+
+	bz::u8string_view get_unqualified_id_value(void) const
+	{
+		return lex::get_identifier_value(this->get_unqualified_id());
 	}
 
 	lex::token_range get_prototype_range(void) const
@@ -435,6 +440,56 @@ inline bool is_generic_parameter(decl_variable const &var_decl)
 		);
 }
 
+// Hashes and compares parameter lists of generic specializations and instantiations.  Two lists are equal
+// if the types of the parameters are the same, and the generic parameters have the same values.
+struct generic_params_hash
+{
+	size_t operator () (bz::array_view<decl_variable const> params) const
+	{
+		auto result = std::hash<size_t>()(params.size());
+		for (auto const &param : params)
+		{
+			result = hash_combine(result, typespec_hash()(param.get_type()));
+			if (is_generic_parameter(param))
+			{
+				bz_assert(param.init_expr.is_constant());
+				result = hash_combine(result, constant_value_hash()(param.init_expr.get_constant_value()));
+			}
+		}
+		return result;
+	}
+};
+
+struct generic_params_equal_to
+{
+	bool operator () (bz::array_view<decl_variable const> lhs_params, bz::array_view<decl_variable const> rhs_params) const
+	{
+		if (lhs_params.size() != rhs_params.size())
+		{
+			return false;
+		}
+		for (auto const &[lhs_param, rhs_param] : bz::zip(lhs_params, rhs_params))
+		{
+			if (lhs_param.get_type() != rhs_param.get_type())
+			{
+				return false;
+			}
+			else if (is_generic_parameter(lhs_param))
+			{
+				bz_assert(lhs_param.init_expr.is_constant());
+				bz_assert(rhs_param.init_expr.is_constant());
+				auto const &lhs_val = lhs_param.init_expr.get_constant_value();
+				auto const &rhs_val = rhs_param.init_expr.get_constant_value();
+				if (lhs_val != rhs_val)
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+};
+
 struct generic_required_from_t
 {
 	lex::src_tokens src_tokens;
@@ -474,6 +529,11 @@ struct function_body
 		deleted                     = bit_at<24>,
 		copy_assign_op              = bit_at<25>,
 		move_assign_op              = bit_at<26>,
+		always_inline               = bit_at<27>,
+		no_inline                   = bit_at<28>,
+		cold                        = bit_at<29>,
+		hot                         = bit_at<30>,
+		flatten                     = bit_at<31>,
 	};
 
 	enum : uint16_t
@@ -599,6 +659,7 @@ struct function_body
 
 		builtin_is_comptime,
 		builtin_is_option_set,
+		builtin_expect,
 		builtin_panic,
 		builtin_panic_handler,
 
@@ -743,6 +804,27 @@ struct function_body
 		arithmetic_shift_right_u32,
 		arithmetic_shift_right_u64,
 
+		// vector intrinsics, these operate on arrays of integers, floating-point numbers or bools lane by lane
+
+		vector_add, vector_sub, vector_mul, vector_div, vector_rem,
+		vector_and, vector_or, vector_xor, vector_shl, vector_shr,
+		vector_min, vector_max,
+		vector_eq, vector_neq, vector_lt, vector_gt, vector_lte, vector_gte,
+		vector_select,
+		vector_shuffle,
+		vector_reduce_add, vector_reduce_mul,
+		vector_reduce_min, vector_reduce_max,
+		vector_reduce_and, vector_reduce_or, vector_reduce_xor,
+		vector_masked_load,
+		vector_masked_store,
+
+		// atomic intrinsics, the memory order arguments are checked if they are constant expressions
+
+		atomic_load, atomic_store, atomic_exchange, atomic_compare_exchange,
+		atomic_fetch_add, atomic_fetch_sub,
+		atomic_fetch_and, atomic_fetch_or, atomic_fetch_xor,
+		atomic_fence,
+
 		_builtin_last,
 		_builtin_default_constructor_first = _builtin_last,
 
@@ -808,54 +890,11 @@ struct function_body
 		_builtin_binary_operator_last,
 	};
 
-	struct param_hash
-	{
-		size_t operator () (bz::array_view<decl_variable const> params) const
-		{
-			auto result = std::hash<size_t>()(params.size());
-			for (auto const &param : params)
-			{
-				result = hash_combine(result, typespec_hash()(param.get_type()));
-			}
-			return result;
-		}
-	};
-
-	struct param_equal_to
-	{
-		bool operator () (bz::array_view<decl_variable const> lhs_params, bz::array_view<decl_variable const> rhs_params) const
-		{
-			if (lhs_params.size() != rhs_params.size())
-			{
-				return false;
-			}
-			for (auto const &[lhs_param, rhs_param] : bz::zip(lhs_params, rhs_params))
-			{
-				if (lhs_param.get_type() != rhs_param.get_type())
-				{
-					return false;
-				}
-				else if (is_generic_parameter(lhs_param))
-				{
-					bz_assert(lhs_param.init_expr.is_constant());
-					bz_assert(rhs_param.init_expr.is_constant());
-					auto const &lhs_val = lhs_param.init_expr.get_constant_value();
-					auto const &rhs_val = rhs_param.init_expr.get_constant_value();
-					if (lhs_val != rhs_val)
-					{
-						return false;
-					}
-				}
-			}
-			return true;
-		}
-	};
-
 	using generic_specializations_map_t = std::unordered_map<
 		bz::array_view<decl_variable const>,
 		function_body *,
-		param_hash,
-		param_equal_to
+		generic_params_hash,
+		generic_params_equal_to
 	>;
 
 	arena_vector<decl_variable> params;
@@ -870,6 +909,8 @@ struct function_body
 	abi::calling_convention     cc = abi::calling_convention::c;
 	uint16_t                    intrinsic_kind = 0;
 	int64_t                     overload_priority = 0;
+	// the feature sets given in '@target_clones', without "default"
+	arena_vector<bz::u8string>  target_clones;
 
 	type_info *constructor_or_destructor_of;
 
@@ -895,6 +936,7 @@ struct function_body
 		  state          (other.state),
 		  cc             (other.cc),
 		  intrinsic_kind (other.intrinsic_kind),
+		  target_clones  (other.target_clones),
 		  constructor_or_destructor_of(nullptr),
 		  generic_specializations(),
 		  generic_required_from(other.generic_required_from),
@@ -1012,6 +1054,21 @@ struct function_body
 	bool is_move_assign_op(void) const noexcept
 	{ return (this->flags & move_assign_op) != 0; }
 
+	bool is_always_inline(void) const noexcept
+	{ return (this->flags & always_inline) != 0; }
+
+	bool is_no_inline(void) const noexcept
+	{ return (this->flags & no_inline) != 0; }
+
+	bool is_cold(void) const noexcept
+	{ return (this->flags & cold) != 0; }
+
+	bool is_hot(void) const noexcept
+	{ return (this->flags & hot) != 0; }
+
+	bool is_flatten(void) const noexcept
+	{ return (this->flags & flatten) != 0; }
+
 	bool has_builtin_implementation(void) const noexcept
 	{
 		return (this->is_intrinsic() && this->body.is_null())
@@ -1243,8 +1300,16 @@ struct type_info
 	arena_vector<decl_function *> constructors{};
 	arena_vector<decl_function *> destructors{};
 
+	using generic_instantiations_map_t = std::unordered_map<
+		bz::array_view<decl_variable const>,
+		type_info *,
+		generic_params_hash,
+		generic_params_equal_to
+	>;
+
 	arena_vector<decl_variable>             generic_parameters{};
 	arena_vector<ast_unique_ptr<type_info>> generic_instantiations{};
+	generic_instantiations_map_t            generic_instantiations_map{};
 	type_info *generic_parent = nullptr;
 	arena_vector<generic_required_from_t> generic_required_from;
 
@@ -1742,12 +1807,23 @@ def_make_fn(statement, stmt_static_assert)
 
 struct universal_function_set
 {
-	bz::u8string_view id;
+	// interned identifier, see lex::intern_identifier
+	uint32_t id;
 	bz::vector<uint32_t> func_kinds;
 };
 
 bz::vector<universal_function_set> make_builtin_universal_functions(void);
 
+// memory order arguments of the atomic intrinsics, these match the values of std::memory_order
+enum class memory_order : uint32_t
+{
+	relaxed = 0,
+	acquire = 1,
+	release = 2,
+	acq_rel = 3,
+	seq_cst = 4,
+};
+
 struct intrinsic_info_t
 {
 	uint32_t kind;
@@ -1755,7 +1831,7 @@ struct intrinsic_info_t
 };
 
 constexpr auto intrinsic_info = []() {
-	static_assert(function_body::_builtin_last - function_body::_builtin_first == 285);
+	static_assert(function_body::_builtin_last - function_body::_builtin_first == 325);
 	constexpr size_t size = function_body::_builtin_last - function_body::_builtin_first;
 	return bz::array<intrinsic_info_t, size>{{
 		{ function_body::builtin_str_length,      "__builtin_str_length"      },
@@ -1877,6 +1953,7 @@ constexpr auto intrinsic_info = []() {
 
 		{ function_body::builtin_is_comptime,        "__builtin_is_comptime"        },
 		{ function_body::builtin_is_option_set,      "__builtin_is_option_set"      },
+		{ function_body::builtin_expect,             "__builtin_expect"             },
 		{ function_body::builtin_panic,              "__builtin_panic"              },
 		{ function_body::builtin_panic_handler,      "__builtin_panic_handler"      },
 
@@ -2092,6 +2169,51 @@ constexpr auto intrinsic_info = []() {
 		{ function_body::arithmetic_shift_right_u16, "__builtin_arithmetic_shift_right_u16" },
 		{ function_body::arithmetic_shift_right_u32, "__builtin_arithmetic_shift_right_u32" },
 		{ function_body::arithmetic_shift_right_u64, "__builtin_arithmetic_shift_right_u64" },
+
+		{ function_body::vector_add,          "__builtin_vector_add"          },
+		{ function_body::vector_sub,          "__builtin_vector_sub"          },
+		{ function_body::vector_mul,          "__builtin_vector_mul"          },
+		{ function_body::vector_div,          "__builtin_vector_div"          },
+		{ function_body::vector_rem,          "__builtin_vector_rem"          },
+		{ function_body::vector_and,          "__builtin_vector_and"          },
+		{ function_body::vector_or,           "__builtin_vector_or"           },
+		{ function_body::vector_xor,          "__builtin_vector_xor"          },
+		{ function_body::vector_shl,          "__builtin_vector_shl"          },
+		{ function_body::vector_shr,          "__builtin_vector_shr"          },
+		{ function_body::vector_min,          "__builtin_vector_min"          },
+		{ function_body::vector_max,          "__builtin_vector_max"          },
+
+		{ function_body::vector_eq,           "__builtin_vector_eq"           },
+		{ function_body::vector_neq,          "__builtin_vector_neq"          },
+		{ function_body::vector_lt,           "__builtin_vector_lt"           },
+		{ function_body::vector_gt,           "__builtin_vector_gt"           },
+		{ function_body::vector_lte,          "__builtin_vector_lte"          },
+		{ function_body::vector_gte,          "__builtin_vector_gte"          },
+
+		{ function_body::vector_select,       "__builtin_vector_select"       },
+		{ function_body::vector_shuffle,      "__builtin_vector_shuffle"      },
+
+		{ function_body::vector_reduce_add,   "__builtin_vector_reduce_add"   },
+		{ function_body::vector_reduce_mul,   "__builtin_vector_reduce_mul"   },
+		{ function_body::vector_reduce_min,   "__builtin_vector_reduce_min"   },
+		{ function_body::vector_reduce_max,   "__builtin_vector_reduce_max"   },
+		{ function_body::vector_reduce_and,   "__builtin_vector_reduce_and"   },
+		{ function_body::vector_reduce_or,    "__builtin_vector_reduce_or"    },
+		{ function_body::vector_reduce_xor,   "__builtin_vector_reduce_xor"   },
+
+		{ function_body::vector_masked_load,  "__builtin_vector_masked_load"  },
+		{ function_body::vector_masked_store, "__builtin_vector_masked_store" },
+
+		{ function_body::atomic_load,             "__builtin_atomic_load"             },
+		{ function_body::atomic_store,            "__builtin_atomic_store"            },
+		{ function_body::atomic_exchange,         "__builtin_atomic_exchange"         },
+		{ function_body::atomic_compare_exchange, "__builtin_atomic_compare_exchange" },
+		{ function_body::atomic_fetch_add,        "__builtin_atomic_fetch_add"        },
+		{ function_body::atomic_fetch_sub,        "__builtin_atomic_fetch_sub"        },
+		{ function_body::atomic_fetch_and,        "__builtin_atomic_fetch_and"        },
+		{ function_body::atomic_fetch_or,         "__builtin_atomic_fetch_or"         },
+		{ function_body::atomic_fetch_xor,        "__builtin_atomic_fetch_xor"        },
+		{ function_body::atomic_fence,            "__builtin_atomic_fence"            },
 	}};
 }();
 
@@ -53,7 +53,7 @@ inline constexpr bz::array ctcli::option_group_multiple<warning_group_id> = []()
 
 template<>
 inline constexpr bz::array ctcli::option_group<opt_group_id> = []() {
-	bz::array<ctcli::group_element_t, codegen::optimization_infos.size() + 4> result{};
+	bz::array<ctcli::group_element_t, codegen::optimization_infos.size() + 5> result{};
 
 	size_t i = 0;
 	for (i = 0; i < codegen::optimization_infos.size(); ++i)
@@ -68,6 +68,7 @@ inline constexpr bz::array ctcli::option_group<opt_group_id> = []() {
 	result[i++] = ctcli::create_group_element("size-opt-level=<level>", "Set size optimization level (0-2) (default=0)",             ctcli::arg_type::uint32);
 
 	result[i++] = ctcli::create_hidden_group_element("machine-code-opt-level=<level>", "Manually set optimization level for machine code generation (0-3)", ctcli::arg_type::uint32);
+	result[i++] = ctcli::create_hidden_group_element("pipeline={module|eager|full}",   "Control when functions are simplified by the optimizer (default=full)");
 
 	bz_assert(i == result.size());
 	return result;
@@ -94,6 +95,11 @@ inline constexpr bz::array ctcli::option_group<code_gen_group_id> = {
 	ctcli::create_group_element("freestanding",                     "Generate code with no external dependencies (default=false)"),
 	ctcli::create_group_element("target-pointer-size=<size>",       "Pointer size of the target architecture in bytes", ctcli::arg_type::uint64),
 	ctcli::create_group_element("target-endianness={little|big}",   "Endianness of the target architecture"),
+	ctcli::create_group_element("codegen-units=<count>",            "Split machine code generation into <count> parallel units (default=1)", ctcli::arg_type::uint64),
+	ctcli::create_group_element("target-cpu=<cpu>",                 "Generate code for <cpu>, 'native' selects the host CPU (default=generic)", ctcli::arg_type::string),
+	ctcli::create_group_element("target-features=<features>",       "Enable or disable target features, e.g. '+avx2,-sse4.2'", ctcli::arg_type::string),
+	ctcli::create_group_element("profile-generate=<dir>",           "Instrument the code to write execution profiles into <dir>", ctcli::arg_type::string),
+	ctcli::create_group_element("profile-use=<file>",               "Use the merged execution profile <file> for optimizations", ctcli::arg_type::string),
 };
 
 namespace internal
@@ -163,7 +169,7 @@ inline constexpr bz::u8string_view emit_usage = internal::static_string_maker::m
 	writer.write("--emit={");
 	if (config::backend_llvm)
 	{
-		writer.write("obj|asm|llvm-bc|llvm-ir|");
+		writer.write("obj|asm|llvm-bc|llvm-ir|thinlto-bc|");
 	}
 	writer.write("null}");
 }>;
@@ -191,9 +197,12 @@ inline constexpr bz::array ctcli::command_line_options<ctcli::options_id_t::def>
 	ctcli::create_option("--target=<target-triple>", "Set compilation target to <target-triple>", ctcli::arg_type::string),
 
 	ctcli::create_hidden_option("--stdlib-dir <dir>",             "Specify the standard library directory", ctcli::arg_type::string),
+	ctcli::create_hidden_option("--module-cache-dir <dir>",       "Cache tokenized source files in <dir> and reuse them in later compilations", ctcli::arg_type::string),
 	ctcli::create_hidden_option("--x86-asm-syntax={att|intel}",   "Assembly syntax used for x86 (default=att)"),
 	ctcli::create_hidden_option("--profile",                      "Measure time for compilation steps"),
 	ctcli::create_hidden_option("--no-main",                      "Don't provide a default 'main' function"),
+	ctcli::create_hidden_option("--thinlto-backend",              "Optimize the given ThinLTO bitcode files together and emit an object file for each"),
+	ctcli::create_hidden_option("--check-library",                "Resolve every function in library files, even the ones that are not used"),
 	ctcli::create_hidden_option("--no-error-highlight",           "Disable printing of highlighted source in error messages"),
 	ctcli::create_hidden_option("--error-report-tab-size=<size>", "Set tab size in error reporting (default=4)", ctcli::arg_type::uint64),
 	ctcli::create_hidden_option("--enable-comptime-print",        "Enable the usage of '__builtin_comptime_print'"),
@@ -207,6 +216,7 @@ inline constexpr bz::array ctcli::command_line_options<ctcli::options_id_t::def>
 #endif // !NDEBUG
 #ifdef BOZON_PROFILE_COMPTIME
 	ctcli::create_undocumented_option("--debug-comptime-print-instruction-counts", ""),
+	ctcli::create_undocumented_option("--debug-comptime-switch-dispatch", "Use switch based dispatch for compile time execution"),
 #endif // BOZON_PROFILE_COMPTIME
 
 	ctcli::create_group_option("-W, --warn <warning>",     "Enable the specified <warning>",      warning_group_id,  "warnings"),
@@ -228,9 +238,12 @@ template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::option("--defi
 template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::option("--emit")>                     = &global_data::emit_file_type;
 template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::option("--target")>                   = &global_data::target;
 template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::option("--stdlib-dir")>               = &global_data::stdlib_dir;
+template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::option("--module-cache-dir")>         = &global_data::module_cache_dir;
 template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::option("--x86-asm-syntax")>           = &global_data::x86_asm_syntax;
 template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::option("--profile")>                  = &global_data::do_profile;
 template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::option("--no-main")>                  = &global_data::no_main;
+template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::option("--thinlto-backend")>          = &global_data::thinlto_backend;
+template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::option("--check-library")>            = &global_data::check_library;
 #ifndef NDEBUG
 template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::option("--debug-ir-output")>                   = &global_data::debug_ir_output;
 template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::option("--debug-comptime-print-functions")>    = &global_data::debug_comptime_print_functions;
@@ -239,6 +252,7 @@ template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::option("--debu
 #endif // !NDEBUG
 #ifdef BOZON_PROFILE_COMPTIME
 template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::option("--debug-comptime-print-instruction-counts")> = &global_data::debug_comptime_print_instruction_counts;
+template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::option("--debug-comptime-switch-dispatch")>          = &global_data::debug_comptime_switch_dispatch;
 #endif // BOZON_PROFILE_COMPTIME
 template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::option("--no-error-highlight")>       = &global_data::no_error_highlight;
 template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::option("--error-report-tab-size")>    = &global_data::tab_size;
@@ -278,6 +292,7 @@ template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::group_element(
 template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::group_element("--opt opt-level")>              = &global_data::opt_level;
 template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::group_element("--opt size-opt-level")>         = &global_data::size_opt_level;
 template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::group_element("--opt machine-code-opt-level")> = &global_data::machine_code_opt_level;
+template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::group_element("--opt pipeline")>               = &global_data::opt_pipeline;
 
 template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::group_element("--code-gen panic-on-unreachable")>             = &global_data::panic_on_unreachable;
 template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::group_element("--code-gen panic-on-null-dereference")>        = &global_data::panic_on_null_dereference;
@@ -288,6 +303,11 @@ template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::group_element(
 template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::group_element("--code-gen freestanding")>                     = &global_data::freestanding;
 template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::group_element("--code-gen target-pointer-size")>              = &global_data::target_pointer_size;
 template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::group_element("--code-gen target-endianness")>                = &global_data::target_endianness;
+template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::group_element("--code-gen codegen-units")>                    = &global_data::codegen_units;
+template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::group_element("--code-gen target-cpu")>                       = &global_data::target_cpu;
+template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::group_element("--code-gen target-features")>                  = &global_data::target_features;
+template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::group_element("--code-gen profile-generate")>                 = &global_data::profile_generate_dir;
+template<> inline constexpr auto *ctcli::value_storage_ptr<ctcli::group_element("--code-gen profile-use")>                      = &global_data::profile_use_file;
 
 template<>
 inline constexpr auto ctcli::argument_parse_function<ctcli::option("--emit")> = [](bz::u8string_view arg) -> std::optional<emit_type> {
@@ -315,6 +335,19 @@ inline constexpr auto ctcli::argument_parse_function<ctcli::option("--x86-asm-sy
 	}
 };
 
+template<>
+inline constexpr auto ctcli::argument_parse_function<ctcli::group_element("--opt pipeline")> = [](bz::u8string_view arg) -> std::optional<opt_pipeline_kind> {
+	auto const result = parse_opt_pipeline(arg);
+	if (result.has_value())
+	{
+		return result.get();
+	}
+	else
+	{
+		return {};
+	}
+};
+
 template<>
 inline constexpr auto ctcli::argument_parse_function<ctcli::group_element("--code-gen target-endianness")> = [](bz::u8string_view arg) -> std::optional<target_endianness_kind> {
 	auto const result = parse_target_endianness(arg);
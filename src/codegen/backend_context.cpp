@@ -19,6 +19,8 @@ namespace codegen
 		return llvm_latest::output_code_kind::llvm_bc;
 	case emit_type::llvm_ir:
 		return llvm_latest::output_code_kind::llvm_ir;
+	case emit_type::thinlto_bc:
+		return llvm_latest::output_code_kind::thinlto_bc;
 	case emit_type::null:
 		bz_unreachable;
 	}
@@ -32,6 +34,7 @@ std::unique_ptr<backend_context> create_backend_context(ctx::global_context &glo
 	case emit_type::asm_:
 	case emit_type::llvm_bc:
 	case emit_type::llvm_ir:
+	case emit_type::thinlto_bc:
 	{
 		if constexpr (config::backend_llvm)
 		{
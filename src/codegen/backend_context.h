@@ -12,10 +12,20 @@ struct backend_context
 {
 	virtual ~backend_context(void) = default;
 
+	// generates code for the compilation unit of the source file 'file_id'
 	[[nodiscard]] virtual bool generate_and_output_code(
 		ctx::global_context &global_ctx,
+		uint32_t file_id,
 		bz::optional<bz::u8string_view> output_path
 	) = 0;
+
+	// runs the ThinLTO backend on bitcode files emitted with '--emit=thinlto-bc', and writes an
+	// object file for each of them
+	[[nodiscard]] virtual bool run_thinlto_backend(
+		ctx::global_context &global_ctx,
+		bz::array_view<bz::u8string const> input_files,
+		bz::array_view<bz::u8string const> output_files
+	) = 0;
 };
 
 std::unique_ptr<backend_context> create_backend_context(ctx::global_context &global_ctx);
@@ -4,18 +4,32 @@
 #include "bitcode_context.h"
 #include "emit_bitcode.h"
 #include "colors.h"
+#include "timer.h"
 
 #include <llvm/TargetParser/Host.h>
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Support/CommandLine.h>
 #include <llvm/Support/FileSystem.h>
 #include <llvm/MC/TargetRegistry.h>
+#include <llvm/MC/MCSubtargetInfo.h>
+#include <llvm/ADT/StringExtras.h>
 #include <llvm/Analysis/LoopAnalysisManager.h>
 #include <llvm/Analysis/CGSCCPassManager.h>
 #include <llvm/IR/PassManager.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/Passes/PassBuilder.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Transforms/Utils/SplitModule.h>
+#include <llvm/Transforms/IPO/AlwaysInliner.h>
+#include <llvm/Analysis/ModuleSummaryAnalysis.h>
+#include <llvm/LTO/LTO.h>
+#include <llvm/Support/Caching.h>
+#include <llvm/Support/Threading.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Program.h>
+
+#include <thread>
 
 #if LLVM_VERSION_MAJOR != 22
 #error LLVM 22 is required
@@ -49,9 +63,144 @@ get_llvm_builtin_types(llvm::LLVMContext &context)
 	};
 }
 
+static std::pair<std::string, std::string> get_target_cpu_and_features(void)
+{
+	auto const user_features = std::string(global_data::target_features.data_as_char_ptr(), global_data::target_features.size());
+	if (global_data::target_cpu == "native")
+	{
+		auto const host_features = llvm::sys::getHostCPUFeatures();
+		// the features are sorted, so that the generated code doesn't depend on the order of the map
+		bz::vector<llvm::StringRef> feature_names;
+		feature_names.reserve(host_features.size());
+		for (auto const &feature : host_features)
+		{
+			feature_names.push_back(feature.getKey());
+		}
+		std::sort(feature_names.begin(), feature_names.end());
+
+		std::string features;
+		for (auto const name : feature_names)
+		{
+			if (!features.empty())
+			{
+				features += ',';
+			}
+			features += host_features.lookup(name) ? '+' : '-';
+			features += name.str();
+		}
+		// features given on the command line come last, so they override the host features
+		if (!user_features.empty())
+		{
+			if (!features.empty())
+			{
+				features += ',';
+			}
+			features += user_features;
+		}
+		return { llvm::sys::getHostCPUName().str(), std::move(features) };
+	}
+	else if (global_data::target_cpu == "")
+	{
+		return { "generic", user_features };
+	}
+	else
+	{
+		return { std::string(global_data::target_cpu.data_as_char_ptr(), global_data::target_cpu.size()), user_features };
+	}
+}
+
+static bool check_target_cpu_and_features(
+	llvm::TargetMachine const &target_machine,
+	std::string const &cpu,
+	ctx::global_context &global_ctx
+)
+{
+	auto const subtarget_info = target_machine.getMCSubtargetInfo();
+	bz_assert(subtarget_info != nullptr);
+	bool result = true;
+
+	if (cpu != "generic" && !subtarget_info->isCPUStringValid(cpu))
+	{
+		bz::vector<ctx::source_highlight> notes;
+		if (global_data::do_verbose)
+		{
+			bz::u8string message = "available CPUs are: ";
+			bool is_first = true;
+			for (auto const &processor : subtarget_info->getAllProcessorDescriptions())
+			{
+				if (is_first)
+				{
+					message += bz::format("'{}'", processor.Key);
+					is_first = false;
+				}
+				else
+				{
+					message += bz::format(", '{}'", processor.Key);
+				}
+			}
+			notes.emplace_back(global_ctx.make_note(std::move(message)));
+		}
+		global_ctx.report_error(bz::format(
+			"'{}' is not a valid CPU for target '{}'",
+			cpu.c_str(), target_machine.getTargetTriple().str().c_str()
+		), std::move(notes));
+		result = false;
+	}
+
+	// only the features given on the command line are checked, the host features are always valid
+	auto const user_features = llvm::StringRef(global_data::target_features.data_as_char_ptr(), global_data::target_features.size());
+	auto const available_features = subtarget_info->getAllProcessorFeatures();
+	for (auto const feature : llvm::split(user_features, ','))
+	{
+		if (feature.empty())
+		{
+			continue;
+		}
+
+		// the leading '+' or '-' is checked during command line parsing
+		auto const name = feature.drop_front();
+		auto const is_available = std::any_of(
+			available_features.begin(), available_features.end(),
+			[name](auto const &available_feature) {
+				return name == available_feature.Key;
+			}
+		);
+		if (!is_available)
+		{
+			global_ctx.report_error(bz::format(
+				"'{}' is not a valid feature for target '{}'",
+				name.str().c_str(), target_machine.getTargetTriple().str().c_str()
+			));
+			result = false;
+		}
+	}
+
+	return result;
+}
+
+// initializes the code generator of the backend 'backend_name' (e.g. 'X86'), the target infos of all
+// backends must already be initialized
+static void initialize_llvm_target(llvm::StringRef backend_name)
+{
+#define LLVM_TARGET(name)                       \
+	if (backend_name == #name)                  \
+	{                                           \
+		LLVMInitialize ## name ## Target();     \
+		LLVMInitialize ## name ## TargetMC();   \
+	}
+#include <llvm/Config/Targets.def>
+
+#define LLVM_ASM_PRINTER(name)                  \
+	if (backend_name == #name)                  \
+	{                                           \
+		LLVMInitialize ## name ## AsmPrinter(); \
+	}
+#include <llvm/Config/AsmPrinters.def>
+}
+
 backend_context::backend_context(ctx::global_context &global_ctx, bz::u8string_view target_triple, output_code_kind output_code, bool &error)
 	: _llvm_context(),
-	  _module("test", this->_llvm_context),
+	  _module(nullptr),
 	  _target(nullptr),
 	  _target_machine(nullptr),
 	  _data_layout(),
@@ -63,12 +212,9 @@ backend_context::backend_context(ctx::global_context &global_ctx, bz::u8string_v
 
 	auto const llvm_target_triple_string = llvm::Triple::normalize(std::string(target_triple.data(), target_triple.size()));
 	auto const llvm_target_triple = llvm::Triple(llvm_target_triple_string);
-	llvm::InitializeAllDisassemblers();
+	// only the target infos are needed to find the target for the triple, and they are cheap to initialize,
+	// the rest of the target is initialized after the lookup
 	llvm::InitializeAllTargetInfos();
-	llvm::InitializeAllTargets();
-	llvm::InitializeAllTargetMCs();
-	llvm::InitializeAllAsmParsers();
-	llvm::InitializeAllAsmPrinters();
 
 	{
 		// set --x86-asm-syntax for LLVM
@@ -120,8 +266,22 @@ backend_context::backend_context(ctx::global_context &global_ctx, bz::u8string_v
 		return;
 	}
 
-	auto const cpu = "generic";
-	auto const features = "";
+	initialize_llvm_target(this->_target->getBackendName());
+
+	if (
+		global_data::target_cpu == "native"
+		&& llvm::Triple(llvm::sys::getProcessTriple()).getArch() != llvm_target_triple.getArch()
+	)
+	{
+		global_ctx.report_error(bz::format(
+			"target CPU 'native' can't be used, because the host architecture is different from target '{}'",
+			llvm_target_triple.getTriple().c_str()
+		));
+		error = true;
+		return;
+	}
+
+	auto const [cpu, features] = get_target_cpu_and_features();
 
 	llvm::TargetOptions options;
 	auto const rm = llvm::Reloc::Model::PIC_;
@@ -166,9 +326,19 @@ backend_context::backend_context(ctx::global_context &global_ctx, bz::u8string_v
 	));
 	bz_assert(this->_target_machine);
 
+	if (!check_target_cpu_and_features(*this->_target_machine, cpu, global_ctx))
+	{
+		error = true;
+		return;
+	}
+
+	if (global_data::do_verbose)
+	{
+		bz::print("target CPU:      {}\n", cpu.c_str());
+		bz::print("target features: {}\n", features.empty() ? "(default)" : features.c_str());
+	}
+
 	this->_data_layout = this->_target_machine->createDataLayout();
-	this->_module.setDataLayout(*this->_data_layout);
-	this->_module.setTargetTriple(llvm_target_triple);
 
 	auto const os = llvm_target_triple.getOS();
 	auto const arch = llvm_target_triple.getArch();
@@ -198,11 +368,31 @@ backend_context::backend_context(ctx::global_context &global_ctx, bz::u8string_v
 	}
 }
 
-static llvm::PassBuilder get_pass_builder(llvm::TargetMachine *tm)
+static std::optional<llvm::PGOOptions> get_pgo_options(void)
+{
+	if (global_data::profile_generate_dir != "")
+	{
+		// same as clang's '-fprofile-generate=<dir>', '%m' makes the file name unique for each instrumented binary
+		auto profile_file = std::string(global_data::profile_generate_dir.data_as_char_ptr(), global_data::profile_generate_dir.size());
+		profile_file += "/default_%m.profraw";
+		return llvm::PGOOptions(std::move(profile_file), "", "", "", llvm::PGOOptions::IRInstr);
+	}
+	else if (global_data::profile_use_file != "")
+	{
+		auto profile_file = std::string(global_data::profile_use_file.data_as_char_ptr(), global_data::profile_use_file.size());
+		return llvm::PGOOptions(std::move(profile_file), "", "", "", llvm::PGOOptions::IRUse);
+	}
+	else
+	{
+		return std::nullopt;
+	}
+}
+
+static llvm::PassBuilder get_pass_builder(llvm::TargetMachine *tm, std::optional<llvm::PGOOptions> pgo_options = std::nullopt)
 {
 	auto tuning_options = llvm::PipelineTuningOptions();
 	// we could later add command line options to set different tuning options
-	return llvm::PassBuilder(tm, tuning_options);
+	return llvm::PassBuilder(tm, tuning_options, std::move(pgo_options));
 }
 
 static auto filter_struct_decls(bz::array_view<ast::statement const> decls)
@@ -302,18 +492,35 @@ static void emit_variables_helper(bz::array_view<ast::statement const> decls, bi
 
 [[nodiscard]] bool backend_context::generate_and_output_code(
 	ctx::global_context &global_ctx,
+	uint32_t file_id,
 	bz::optional<bz::u8string_view> output_path
 )
 {
-	if (!this->emit_bitcode(global_ctx))
+	auto const module_name = global_ctx.get_src_file(file_id).get_file_path().generic_string();
+	this->_module = std::make_unique<llvm::Module>(module_name, this->_llvm_context);
+	this->_module->setDataLayout(*this->_data_layout);
+	this->_module->setTargetTriple(this->_target_machine->getTargetTriple());
+
+	auto const add_stage_profile_info = [&](bz::u8string_view name, timer::duration duration) {
+		if (global_ctx.profile_timer != nullptr)
+		{
+			global_ctx.profile_timer->add_subsection_time(name, duration);
+		}
+	};
+
+	auto begin = timer::now();
+	if (!this->emit_bitcode(global_ctx, file_id))
 	{
 		return false;
 	}
+	add_stage_profile_info("bitcode emission", timer::now() - begin);
 
+	begin = timer::now();
 	if (!this->optimize())
 	{
 		return false;
 	}
+	add_stage_profile_info("module optimization", timer::now() - begin);
 
 	// only here for debug purposes, the '--emit' option does not control this
 #ifndef NDEBUG
@@ -323,7 +530,7 @@ static void emit_variables_helper(bz::array_view<ast::statement const> decls, bi
 		llvm::raw_fd_ostream file("debug_output.ll", ec, llvm::sys::fs::OF_Text);
 		if (!ec)
 		{
-			this->_module.print(file, nullptr);
+			this->_module->print(file, nullptr);
 		}
 		else
 		{
@@ -334,18 +541,21 @@ static void emit_variables_helper(bz::array_view<ast::statement const> decls, bi
 
 	if (output_path.has_value())
 	{
+		begin = timer::now();
 		if (!this->emit_file(global_ctx, output_path.get()))
 		{
 			return false;
 		}
+		add_stage_profile_info("file emission", timer::now() - begin);
 	}
 
 	return true;
 }
 
-[[nodiscard]] bool backend_context::emit_bitcode(ctx::global_context &global_ctx)
+[[nodiscard]] bool backend_context::emit_bitcode(ctx::global_context &global_ctx, uint32_t file_id)
 {
-	bitcode_context context(global_ctx, *this, &this->_module);
+	bitcode_context context(global_ctx, *this, this->_module.get());
+	context.compilation_unit_file_id = file_id;
 
 	auto const llvm_opt_level = [&]() {
 		if (global_data::size_opt_level != 0)
@@ -372,7 +582,7 @@ static void emit_variables_helper(bz::array_view<ast::statement const> decls, bi
 
 	auto builder = get_pass_builder(this->_target_machine.get());
 
-	if (llvm_opt_level != llvm::OptimizationLevel::O0)
+	if (llvm_opt_level != llvm::OptimizationLevel::O0 && global_data::opt_pipeline != opt_pipeline_kind::module)
 	{
 		builder.registerModuleAnalyses(module_analysis_manager);
 		builder.registerCGSCCAnalyses(cgscc_analysis_manager);
@@ -386,11 +596,17 @@ static void emit_variables_helper(bz::array_view<ast::statement const> decls, bi
 		);
 	}
 
-	auto function_pass_manager = llvm_opt_level != llvm::OptimizationLevel::O0
-		? builder.buildFunctionSimplificationPipeline(llvm_opt_level, llvm::ThinOrFullLTOPhase::None)
+	auto const lto_phase = this->_output_code == output_code_kind::thinlto_bc
+		? llvm::ThinOrFullLTOPhase::ThinLTOPreLink
+		: llvm::ThinOrFullLTOPhase::None;
+	// with '--opt pipeline=module' the functions are only simplified by the module pipeline in optimize()
+	auto const simplify_functions = llvm_opt_level != llvm::OptimizationLevel::O0
+		&& global_data::opt_pipeline != opt_pipeline_kind::module;
+	auto function_pass_manager = simplify_functions
+		? builder.buildFunctionSimplificationPipeline(llvm_opt_level, lto_phase)
 		: llvm::FunctionPassManager();
 
-	if (llvm_opt_level != llvm::OptimizationLevel::O0)
+	if (simplify_functions)
 	{
 		context.function_analysis_manager = &function_analysis_manager;
 		context.function_pass_manager = &function_pass_manager;
@@ -414,6 +630,7 @@ static void emit_variables_helper(bz::array_view<ast::statement const> decls, bi
 	{
 		if (
 			func->is_external_linkage()
+			&& context.is_in_compilation_unit(func->src_tokens)
 			&& !(
 				global_ctx._main == nullptr
 				&& func->symbol_name == "main"
@@ -425,6 +642,18 @@ static void emit_variables_helper(bz::array_view<ast::statement const> decls, bi
 	}
 
 	emit_necessary_functions(context);
+	emit_target_clones_dispatch(context);
+
+	if (global_ctx.profile_timer != nullptr && simplify_functions)
+	{
+		global_ctx.profile_timer->add_subsection_time("function simplification", context.function_pass_manager_duration);
+	}
+
+	// the emitted functions may be needed again in the next compilation unit
+	for (auto const func : context.functions_to_compile)
+	{
+		func->flags &= ~ast::function_body::bitcode_emitted;
+	}
 
 	return !global_ctx.has_errors();
 }
@@ -436,7 +665,7 @@ static void emit_variables_helper(bz::array_view<ast::statement const> decls, bi
 		return true;
 	}
 
-	auto &module = this->_module;
+	auto &module = *this->_module;
 
 	auto const llvm_opt_level = [&]() {
 		if (global_data::size_opt_level != 0)
@@ -459,14 +688,16 @@ static void emit_variables_helper(bz::array_view<ast::statement const> decls, bi
 		}
 	}();
 
-	for ([[maybe_unused]] auto const _ : bz::iota(0, global_data::max_opt_iter_count))
+	for (auto const i : bz::iota(0, global_data::max_opt_iter_count))
 	{
 		llvm::LoopAnalysisManager loop_analysis_manager;
 		llvm::FunctionAnalysisManager function_analysis_manager;
 		llvm::CGSCCAnalysisManager cgscc_analysis_manager;
 		llvm::ModuleAnalysisManager module_analysis_manager;
 
-		auto builder = get_pass_builder(this->_target_machine.get());
+		// the instrumentation and the profile annotations must only be added once, the profile metadata
+		// is kept in the module for the later iterations
+		auto builder = get_pass_builder(this->_target_machine.get(), i == 0 ? get_pgo_options() : std::nullopt);
 
 		builder.registerModuleAnalyses(module_analysis_manager);
 		builder.registerCGSCCAnalyses(cgscc_analysis_manager);
@@ -479,9 +710,37 @@ static void emit_variables_helper(bz::array_view<ast::statement const> decls, bi
 			module_analysis_manager
 		);
 
-		auto pass_manager = llvm_opt_level == llvm::OptimizationLevel::O0
-			? builder.buildO0DefaultPipeline(llvm_opt_level)
-			: builder.buildPerModuleDefaultPipeline(llvm_opt_level);
+		// with ThinLTO the module is only simplified here, the rest of the optimizations are done
+		// by the ThinLTO backend after cross-module importing
+		// with '--opt pipeline=eager' the functions have already been simplified in emit_bitcode, so only
+		// the inliner and the module level optimizations are run here
+		auto const is_thinlto = this->_output_code == output_code_kind::thinlto_bc;
+		auto pass_manager = [&]() -> llvm::ModulePassManager {
+			if (llvm_opt_level == llvm::OptimizationLevel::O0)
+			{
+				return builder.buildO0DefaultPipeline(
+					llvm_opt_level,
+					is_thinlto ? llvm::ThinOrFullLTOPhase::ThinLTOPreLink : llvm::ThinOrFullLTOPhase::None
+				);
+			}
+			else if (is_thinlto)
+			{
+				return builder.buildThinLTOPreLinkDefaultPipeline(llvm_opt_level);
+			}
+			else if (global_data::opt_pipeline == opt_pipeline_kind::eager)
+			{
+				// the inliner is part of the module simplification pipeline, which is skipped here
+				llvm::ModulePassManager result;
+				result.addPass(llvm::AlwaysInlinerPass());
+				result.addPass(builder.buildInlinerPipeline(llvm_opt_level, llvm::ThinOrFullLTOPhase::None));
+				result.addPass(builder.buildModuleOptimizationPipeline(llvm_opt_level, llvm::ThinOrFullLTOPhase::None));
+				return result;
+			}
+			else
+			{
+				return builder.buildPerModuleDefaultPipeline(llvm_opt_level);
+			}
+		}();
 
 		pass_manager.run(module, module_analysis_manager);
 	}
@@ -502,6 +761,8 @@ static void emit_variables_helper(bz::array_view<ast::statement const> decls, bi
 		return this->emit_llvm_bc(global_ctx, output_path);
 	case output_code_kind::llvm_ir:
 		return this->emit_llvm_ir(global_ctx, output_path);
+	case output_code_kind::thinlto_bc:
+		return this->emit_thinlto_bc(global_ctx, output_path);
 	}
 	bz_unreachable;
 }
@@ -541,7 +802,12 @@ static void emit_variables_helper(bz::array_view<ast::statement const> decls, bi
 		);
 	}
 
-	auto &module = this->_module;
+	if (global_data::codegen_units > 1)
+	{
+		return this->emit_obj_codegen_units(global_ctx, dest);
+	}
+
+	auto &module = *this->_module;
 	llvm::legacy::PassManager pass_manager;
 	auto const target_machine = this->_target_machine.get();
 	auto const res = target_machine->addPassesToEmitFile(pass_manager, dest, nullptr, llvm::CodeGenFileType::ObjectFile);
@@ -555,6 +821,219 @@ static void emit_variables_helper(bz::array_view<ast::statement const> decls, bi
 	return true;
 }
 
+struct codegen_unit_t
+{
+	llvm::SmallString<0> bitcode;
+	llvm::SmallString<0> object;
+	size_t function_count = 0;
+	timer::duration duration{};
+	// empty if the unit was emitted successfully
+	bz::u8string error;
+};
+
+static std::unique_ptr<llvm::TargetMachine> clone_target_machine(llvm::Target const &target, llvm::TargetMachine const &target_machine)
+{
+	return std::unique_ptr<llvm::TargetMachine>(target.createTargetMachine(
+		target_machine.getTargetTriple(),
+		target_machine.getTargetCPU(),
+		target_machine.getTargetFeatureString(),
+		target_machine.Options,
+		target_machine.getRelocationModel(),
+		target_machine.getCodeModel(),
+		target_machine.getOptLevel()
+	));
+}
+
+static void emit_codegen_unit(codegen_unit_t &unit, llvm::Target const &target, llvm::TargetMachine const &base_target_machine)
+{
+	auto const begin = timer::now();
+
+	llvm::LLVMContext llvm_context;
+	llvm_context.setDiscardValueNames(global_data::discard_llvm_value_names);
+	auto module = llvm::parseBitcodeFile(llvm::MemoryBufferRef(unit.bitcode, "codegen-unit"), llvm_context);
+	if (!module)
+	{
+		auto const message = llvm::toString(module.takeError());
+		unit.error = bz::format("unable to read codegen unit, reason: '{}'", message.c_str());
+		return;
+	}
+
+	auto const target_machine = clone_target_machine(target, base_target_machine);
+	if (target_machine == nullptr)
+	{
+		unit.error = "unable to create target machine for codegen unit";
+		return;
+	}
+
+	llvm::raw_svector_ostream dest(unit.object);
+	llvm::legacy::PassManager pass_manager;
+	if (target_machine->addPassesToEmitFile(pass_manager, dest, nullptr, llvm::CodeGenFileType::ObjectFile))
+	{
+		unit.error = "object file emission is not supported";
+		return;
+	}
+
+	pass_manager.run(**module);
+	unit.duration = timer::now() - begin;
+}
+
+struct temporary_files_t
+{
+	bz::vector<llvm::SmallString<128>> paths;
+
+	~temporary_files_t(void)
+	{
+		for (auto const &path : this->paths)
+		{
+			llvm::sys::fs::remove(path);
+		}
+	}
+};
+
+static bz::optional<std::string> find_relocatable_linker(void)
+{
+	for (auto const name : { "ld.lld", "ld" })
+	{
+		if (auto const path = llvm::sys::findProgramByName(name))
+		{
+			return *path;
+		}
+	}
+	return {};
+}
+
+[[nodiscard]] bool backend_context::emit_obj_codegen_units(ctx::global_context &global_ctx, llvm::raw_pwrite_stream &dest)
+{
+	if (!this->_target_machine->getTargetTriple().isOSBinFormatELF())
+	{
+		global_ctx.report_error("multiple codegen units are only supported for ELF targets");
+		return false;
+	}
+
+	auto const linker = find_relocatable_linker();
+	if (!linker.has_value())
+	{
+		global_ctx.report_error("unable to find 'ld.lld' or 'ld', which is needed to combine multiple codegen units");
+		return false;
+	}
+
+	// the partitions created by SplitModule share our LLVMContext, which can't be used from multiple threads,
+	// so every partition is serialized here and read back into a separate context on its own thread
+	// locals are preserved, so SplitModule keeps them in the same partition as their users; otherwise
+	// they would be made external without being renamed, and locals with the same name would clash
+	// when the units are linked together
+	constexpr bool preserve_locals = true;
+	bz::vector<codegen_unit_t> units;
+	llvm::SplitModule(*this->_module, static_cast<unsigned>(global_data::codegen_units), [&units](std::unique_ptr<llvm::Module> partition) {
+		auto &unit = units.emplace_back();
+		for (auto const &func : *partition)
+		{
+			if (!func.isDeclaration())
+			{
+				unit.function_count += 1;
+			}
+		}
+		llvm::raw_svector_ostream os(unit.bitcode);
+		llvm::WriteBitcodeToFile(*partition, os);
+	}, preserve_locals);
+
+	{
+		bz::vector<std::thread> threads;
+		threads.reserve(units.size());
+		for (auto &unit : units)
+		{
+			threads.push_back(std::thread(emit_codegen_unit, std::ref(unit), std::cref(*this->_target), std::cref(*this->_target_machine)));
+		}
+		for (auto &thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	for (auto &unit : units)
+	{
+		if (unit.error != "")
+		{
+			global_ctx.report_error(std::move(unit.error));
+			return false;
+		}
+		global_data::codegen_unit_profile_infos.push_back({ unit.function_count, unit.duration });
+	}
+
+	// the objects are combined with a relocatable link, so there's still only one output file
+	temporary_files_t object_files;
+	for (auto const &unit : units)
+	{
+		auto &path = object_files.paths.emplace_back();
+		int fd = -1;
+		if (auto const ec = llvm::sys::fs::createTemporaryFile("bozon-codegen-unit", "o", fd, path))
+		{
+			object_files.paths.pop_back();
+			global_ctx.report_error(bz::format("unable to create temporary file, reason: '{}'", ec.message().c_str()));
+			return false;
+		}
+		llvm::raw_fd_ostream file(fd, true);
+		file << unit.object;
+		file.close();
+		if (file.has_error())
+		{
+			global_ctx.report_error(bz::format(
+				"unable to write temporary file '{}', reason: '{}'",
+				path.c_str(), file.error().message().c_str()
+			));
+			// raw_fd_ostream aborts on destruction if the error wasn't cleared
+			file.clear_error();
+			return false;
+		}
+	}
+
+	temporary_files_t combined_file;
+	auto &combined_path = combined_file.paths.emplace_back();
+	if (auto const ec = llvm::sys::fs::createTemporaryFile("bozon-codegen-units", "o", combined_path))
+	{
+		combined_file.paths.pop_back();
+		global_ctx.report_error(bz::format("unable to create temporary file, reason: '{}'", ec.message().c_str()));
+		return false;
+	}
+
+	bz::vector<llvm::StringRef> args;
+	args.push_back(linker.get());
+	args.push_back("-r");
+	args.push_back("-o");
+	args.push_back(combined_path);
+	for (auto const &path : object_files.paths)
+	{
+		args.push_back(path);
+	}
+
+	std::string error_message;
+	auto const linker_result = llvm::sys::ExecuteAndWait(
+		linker.get(),
+		llvm::ArrayRef<llvm::StringRef>(args.data(), args.size()),
+		std::nullopt, {}, 0, 0, &error_message
+	);
+	if (linker_result != 0)
+	{
+		global_ctx.report_error(bz::format(
+			"unable to combine codegen units with '{}', reason: '{}'",
+			linker.get().c_str(), error_message.empty() ? "linker failed" : error_message.c_str()
+		));
+		return false;
+	}
+
+	auto combined_object = llvm::MemoryBuffer::getFile(combined_path);
+	if (!combined_object)
+	{
+		global_ctx.report_error(bz::format(
+			"unable to read combined object file, reason: '{}'", combined_object.getError().message().c_str()
+		));
+		return false;
+	}
+
+	dest << (*combined_object)->getBuffer();
+	return true;
+}
+
 [[nodiscard]] bool backend_context::emit_asm(ctx::global_context &global_ctx, bz::u8string_view output_path)
 {
 	if (output_path != "-" && !output_path.ends_with(".s"))
@@ -582,7 +1061,7 @@ static void emit_variables_helper(bz::array_view<ast::statement const> decls, bi
 		return false;
 	}
 
-	auto &module = this->_module;
+	auto &module = *this->_module;
 	llvm::legacy::PassManager pass_manager;
 	auto const target_machine = this->_target_machine.get();
 	auto const res = target_machine->addPassesToEmitFile(pass_manager, dest, nullptr, llvm::CodeGenFileType::AssemblyFile);
@@ -600,7 +1079,7 @@ static void emit_variables_helper(bz::array_view<ast::statement const> decls, bi
 
 [[nodiscard]] bool backend_context::emit_llvm_bc(ctx::global_context &global_ctx, bz::u8string_view output_path)
 {
-	auto &module = this->_module;
+	auto &module = *this->_module;
 	if (output_path != "-" && !output_path.ends_with(".bc"))
 	{
 		global_ctx.report_warning(
@@ -640,7 +1119,7 @@ static void emit_variables_helper(bz::array_view<ast::statement const> decls, bi
 
 [[nodiscard]] bool backend_context::emit_llvm_ir(ctx::global_context &global_ctx, bz::u8string_view output_path)
 {
-	auto &module = this->_module;
+	auto &module = *this->_module;
 	if (output_path != "-" && !output_path.ends_with(".ll"))
 	{
 		global_ctx.report_warning(
@@ -670,4 +1149,225 @@ static void emit_variables_helper(bz::array_view<ast::statement const> decls, bi
 	return true;
 }
 
+[[nodiscard]] bool backend_context::emit_thinlto_bc(ctx::global_context &global_ctx, bz::u8string_view output_path)
+{
+	auto &module = *this->_module;
+	if (output_path != "-" && !output_path.ends_with(".bc"))
+	{
+		global_ctx.report_warning(
+			ctx::warning_kind::bad_file_extension,
+			bz::format("ThinLTO bitcode output file '{}' doesn't have the file extension '.bc'", output_path)
+		);
+	}
+
+	// passing "-" to raw_fd_ostream should output to stdout and not create a new file
+	// http://llvm.org/doxygen/classllvm_1_1raw__fd__ostream.html#af5462bc0fe5a61eccc662708da280e64
+	std::error_code ec;
+	llvm::raw_fd_ostream dest(
+		llvm::StringRef(output_path.data(), output_path.size()),
+		ec, llvm::sys::fs::OF_None
+	);
+
+	if (ec)
+	{
+		global_ctx.report_error(bz::format(
+			"unable to open output file '{}', reason: '{}'",
+			output_path, ec.message().c_str()
+		));
+		return false;
+	}
+
+	if (output_path == "-")
+	{
+		global_ctx.report_warning(
+			ctx::warning_kind::binary_stdout,
+			"outputting binary file to stdout"
+		);
+	}
+
+	// the module hash is used by the ThinLTO backend to identify the modules
+	auto const summary = llvm::buildModuleSummaryIndex(module, nullptr, nullptr);
+	llvm::WriteBitcodeToFile(module, dest, false, &summary, true);
+	return true;
+}
+
+[[nodiscard]] bool backend_context::run_thinlto_backend(
+	ctx::global_context &global_ctx,
+	bz::array_view<bz::u8string const> input_files,
+	bz::array_view<bz::u8string const> output_files
+)
+{
+	bz_assert(input_files.size() == output_files.size());
+
+	llvm::lto::Config config;
+	config.CPU = this->_target_machine->getTargetCPU().str();
+	auto const features = this->_target_machine->getTargetFeatureString();
+	if (!features.empty())
+	{
+		llvm::SmallVector<llvm::StringRef> feature_list;
+		features.split(feature_list, ',');
+		for (auto const feature : feature_list)
+		{
+			config.MAttrs.push_back(feature.str());
+		}
+	}
+	config.Options = this->_target_machine->Options;
+	config.RelocModel = llvm::Reloc::Model::PIC_;
+	config.CGOptLevel = this->_target_machine->getOptLevel();
+	config.OptLevel = global_data::size_opt_level != 0 ? 2 : std::min(global_data::opt_level, 3u);
+
+	llvm::lto::LTO lto(std::move(config), llvm::lto::createInProcessThinBackend(llvm::heavyweight_hardware_concurrency()));
+
+	struct thinlto_input_t
+	{
+		bz::u8string_view file_name;
+		std::unique_ptr<llvm::MemoryBuffer> buffer;
+		std::unique_ptr<llvm::lto::InputFile> input;
+	};
+
+	bz::vector<thinlto_input_t> inputs;
+	inputs.reserve(input_files.size());
+	for (auto const &input_file : input_files)
+	{
+		auto const input_path = llvm::StringRef(input_file.data_as_char_ptr(), input_file.size());
+		auto buffer = llvm::MemoryBuffer::getFile(input_path);
+		if (!buffer)
+		{
+			global_ctx.report_error(bz::format(
+				"unable to read input file '{}', reason: '{}'", input_file, buffer.getError().message().c_str()
+			));
+			return false;
+		}
+
+		auto input = llvm::lto::InputFile::create((*buffer)->getMemBufferRef());
+		if (!input)
+		{
+			global_ctx.report_error(bz::format(
+				"unable to read ThinLTO bitcode file '{}', reason: '{}'",
+				input_file, llvm::toString(input.takeError()).c_str()
+			));
+			return false;
+		}
+
+		auto const lto_info = (*input)->getSingleBitcodeModule().getLTOInfo();
+		if (!lto_info || !lto_info->IsThinLTO)
+		{
+			global_ctx.report_error(bz::format(
+				"'{}' doesn't have a ThinLTO summary, it must be compiled with '--emit=thinlto-bc'", input_file
+			));
+			return false;
+		}
+
+		inputs.push_back({ input_file, std::move(*buffer), std::move(*input) });
+	}
+
+	// the prevailing definition of a symbol is chosen the same way as a linker would: a strong definition
+	// is preferred over weak and common ones, otherwise the first definition is used
+	struct prevailing_definition_t
+	{
+		size_t input_index;
+		size_t symbol_index;
+		bool is_strong;
+	};
+
+	llvm::StringMap<prevailing_definition_t> prevailing_definitions;
+	for (auto const &[input, input_index] : inputs.enumerate())
+	{
+		auto const symbols = input.input->symbols();
+		for (auto const symbol_index : bz::iota(0, symbols.size()))
+		{
+			auto const &symbol = symbols[symbol_index];
+			if (symbol.isUndefined())
+			{
+				continue;
+			}
+
+			auto const is_strong = !symbol.isWeak() && !symbol.isCommon();
+			auto const [it, inserted] = prevailing_definitions.try_emplace(
+				symbol.getName(),
+				prevailing_definition_t{ input_index, symbol_index, is_strong }
+			);
+			if (inserted)
+			{
+				continue;
+			}
+			else if (is_strong && it->second.is_strong)
+			{
+				global_ctx.report_error(bz::format(
+					"symbol '{}' is defined in both '{}' and '{}'",
+					bz::u8string_view(symbol.getName().data(), symbol.getName().data() + symbol.getName().size()),
+					inputs[it->second.input_index].file_name, input.file_name
+				));
+				return false;
+			}
+			else if (is_strong)
+			{
+				it->second = { input_index, symbol_index, is_strong };
+			}
+		}
+	}
+
+	llvm::StringMap<std::string> output_paths;
+	for (auto const &[input, input_index] : inputs.enumerate())
+	{
+		auto const &output_file = output_files[input_index];
+		auto const symbols = input.input->symbols();
+		bz::vector<llvm::lto::SymbolResolution> resolutions;
+		resolutions.reserve(symbols.size());
+		for (auto const symbol_index : bz::iota(0, symbols.size()))
+		{
+			auto const &symbol = symbols[symbol_index];
+			auto &resolution = resolutions.emplace_back();
+			if (symbol.isUndefined())
+			{
+				continue;
+			}
+
+			auto const &prevailing = prevailing_definitions.find(symbol.getName())->second;
+			auto const is_default_visibility = symbol.getVisibility() == llvm::GlobalValue::DefaultVisibility;
+			resolution.Prevailing = prevailing.input_index == input_index && prevailing.symbol_index == symbol_index;
+			// the objects are linked with regular objects that we don't see, e.g. the C runtime, so every symbol
+			// in the symbol table of an object file may be referenced by them.  symbols that can be omitted from
+			// the symbol table, like linkonce_odr unnamed_addr functions, can only be referenced from other
+			// ThinLTO modules, so they are internalized after importing
+			resolution.VisibleToRegularObj = symbol.isUsed() || !symbol.canBeOmittedFromSymbolTable();
+			resolution.ExportDynamic = resolution.VisibleToRegularObj && is_default_visibility;
+			// hidden and protected symbols can't be preempted at run time
+			resolution.FinalDefinitionInLinkage = resolution.Prevailing && !is_default_visibility;
+		}
+
+		output_paths[input.input->getName()] = std::string(output_file.data_as_char_ptr(), output_file.size());
+		if (auto error = lto.add(std::move(input.input), llvm::ArrayRef(resolutions.data(), resolutions.size())))
+		{
+			global_ctx.report_error(bz::format(
+				"unable to add '{}' to the ThinLTO backend, reason: '{}'",
+				input.file_name, llvm::toString(std::move(error)).c_str()
+			));
+			return false;
+		}
+	}
+
+	auto const add_stream = [&output_paths](unsigned, llvm::Twine const &module_name)
+		-> llvm::Expected<std::unique_ptr<llvm::CachedFileStream>>
+	{
+		auto const it = output_paths.find(module_name.str());
+		bz_assert(it != output_paths.end());
+		std::error_code ec;
+		auto stream = std::make_unique<llvm::raw_fd_ostream>(it->second, ec, llvm::sys::fs::OF_None);
+		if (ec)
+		{
+			return llvm::errorCodeToError(ec);
+		}
+		return std::make_unique<llvm::CachedFileStream>(std::move(stream), it->second);
+	};
+
+	if (auto error = lto.run(add_stream))
+	{
+		global_ctx.report_error(bz::format("ThinLTO backend failed, reason: '{}'", llvm::toString(std::move(error)).c_str()));
+		return false;
+	}
+
+	return true;
+}
+
 } // namespace codegen::llvm_latest
@@ -26,6 +26,7 @@ enum class output_code_kind
 	asm_,
 	llvm_bc,
 	llvm_ir,
+	thinlto_bc,
 };
 
 #ifdef BOZON_CONFIG_BACKEND_LLVM
@@ -35,7 +36,8 @@ struct backend_context : virtual ::codegen::backend_context
 	backend_context(ctx::global_context &global_ctx, bz::u8string_view target_triple, output_code_kind output_code, bool &error);
 
 	llvm::LLVMContext _llvm_context;
-	llvm::Module      _module;
+	// a new module is created for each compilation unit
+	std::unique_ptr<llvm::Module> _module;
 	llvm::Target const *_target;
 	std::unique_ptr<llvm::TargetMachine> _target_machine;
 	bz::optional<llvm::DataLayout>       _data_layout;
@@ -57,16 +59,25 @@ struct backend_context : virtual ::codegen::backend_context
 
 	[[nodiscard]] virtual bool generate_and_output_code(
 		ctx::global_context &global_ctx,
+		uint32_t file_id,
 		bz::optional<bz::u8string_view> output_path
 	) override;
 
-	[[nodiscard]] bool emit_bitcode(ctx::global_context &global_ctx);
+	[[nodiscard]] virtual bool run_thinlto_backend(
+		ctx::global_context &global_ctx,
+		bz::array_view<bz::u8string const> input_files,
+		bz::array_view<bz::u8string const> output_files
+	) override;
+
+	[[nodiscard]] bool emit_bitcode(ctx::global_context &global_ctx, uint32_t file_id);
 	[[nodiscard]] bool optimize(void);
 	[[nodiscard]] bool emit_file(ctx::global_context &global_ctx, bz::u8string_view output_path);
 	[[nodiscard]] bool emit_obj(ctx::global_context &global_ctx, bz::u8string_view output_path);
+	[[nodiscard]] bool emit_obj_codegen_units(ctx::global_context &global_ctx, llvm::raw_pwrite_stream &dest);
 	[[nodiscard]] bool emit_asm(ctx::global_context &global_ctx, bz::u8string_view output_path);
 	[[nodiscard]] bool emit_llvm_bc(ctx::global_context &global_ctx, bz::u8string_view output_path);
 	[[nodiscard]] bool emit_llvm_ir(ctx::global_context &global_ctx, bz::u8string_view output_path);
+	[[nodiscard]] bool emit_thinlto_bc(ctx::global_context &global_ctx, bz::u8string_view output_path);
 };
 
 #else
@@ -78,11 +89,21 @@ struct backend_context : virtual ::codegen::backend_context
 
 	[[nodiscard]] virtual bool generate_and_output_code(
 		ctx::global_context &global_ctx,
+		uint32_t file_id,
 		bz::optional<bz::u8string_view> output_path
 	) override
 	{
 		return false;
 	}
+
+	[[nodiscard]] virtual bool run_thinlto_backend(
+		ctx::global_context &global_ctx,
+		bz::array_view<bz::u8string const> input_files,
+		bz::array_view<bz::u8string const> output_files
+	) override
+	{
+		return false;
+	}
 };
 
 #endif // BOZON_CONFIG_BACKEND_LLVM
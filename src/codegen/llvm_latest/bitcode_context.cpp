@@ -88,6 +88,12 @@ abi::platform_abi bitcode_context::get_platform_abi(void) const noexcept
 	return this->backend_ctx._platform_abi;
 }
 
+llvm::TargetMachine const &bitcode_context::get_target_machine(void) const noexcept
+{
+	bz_assert(this->backend_ctx._target_machine != nullptr);
+	return *this->backend_ctx._target_machine;
+}
+
 size_t bitcode_context::get_size(llvm::Type *t) const
 {
 	bz_assert(t->isSized());
@@ -337,9 +343,7 @@ llvm::CallInst *bitcode_context::create_call(
 	llvm::ArrayRef<llvm::Value *> args
 )
 {
-	auto const call = this->builder.CreateCall(fn, args);
-	call->setCallingConv(fn->getCallingConv());
-	return call;
+	return this->create_call(fn, args);
 }
 
 llvm::CallInst *bitcode_context::create_call(
@@ -349,6 +353,17 @@ llvm::CallInst *bitcode_context::create_call(
 {
 	auto const call = this->builder.CreateCall(fn, args);
 	call->setCallingConv(fn->getCallingConv());
+	// '@flatten' is implemented by inlining every direct call in the function, like in clang,
+	// except for calls to cold functions, e.g. the panic handler
+	if (
+		this->current_function.first != nullptr
+		&& this->current_function.first->is_flatten()
+		&& !fn->hasFnAttribute(llvm::Attribute::NoInline)
+		&& !fn->hasFnAttribute(llvm::Attribute::Cold)
+	)
+	{
+		call->addFnAttr(llvm::Attribute::AlwaysInline);
+	}
 	return call;
 }
 
@@ -766,6 +781,14 @@ void bitcode_context::ensure_function_emission(ast::function_body *func)
 	{
 		return;
 	}
+	// library function bodies are resolved when the function is referenced, see global_context::require_function_body
+	bz_assert(!func->body.is<lex::token_range>());
+
+	// functions with external linkage are only defined in their own compilation unit
+	if (func->is_external_linkage() && !this->is_in_compilation_unit(func->src_tokens))
+	{
+		return;
+	}
 
 	if (!func->is_bitcode_emitted())
 	{
@@ -773,6 +796,14 @@ void bitcode_context::ensure_function_emission(ast::function_body *func)
 	}
 }
 
+bool bitcode_context::is_in_compilation_unit(lex::src_tokens const &src_tokens) const
+{
+	auto const file_id = src_tokens.pivot == nullptr
+		? ctx::global_context::compiler_file_id
+		: src_tokens.pivot->get_file_id();
+	return this->global_ctx.get_compilation_unit_file_id(file_id) == this->compilation_unit_file_id;
+}
+
 void bitcode_context::report_error(
 	lex::src_tokens const &src_tokens, bz::u8string message,
 	bz::vector<ctx::source_highlight> notes,
@@ -782,8 +813,8 @@ void bitcode_context::report_error(
 	this->global_ctx.report_error(ctx::error{
 			ctx::warning_kind::_last,
 		{
-			src_tokens.pivot->src_pos.file_id, src_tokens.pivot->src_pos.line,
-			src_tokens.begin->src_pos.begin, src_tokens.pivot->src_pos.begin, (src_tokens.end - 1)->src_pos.end,
+			src_tokens.pivot->get_file_id(), src_tokens.pivot->get_line(),
+			src_tokens.begin->get_begin(), src_tokens.pivot->get_begin(), (src_tokens.end - 1)->get_end(),
 			ctx::suggestion_range{}, ctx::suggestion_range{},
 			std::move(message),
 		},
@@ -794,8 +825,8 @@ void bitcode_context::report_error(
 [[nodiscard]] ctx::source_highlight bitcode_context::make_note(lex::src_tokens const &src_tokens, bz::u8string message)
 {
 	return ctx::source_highlight{
-		src_tokens.pivot->src_pos.file_id, src_tokens.pivot->src_pos.line,
-		src_tokens.begin->src_pos.begin, src_tokens.pivot->src_pos.begin, (src_tokens.end - 1)->src_pos.end,
+		src_tokens.pivot->get_file_id(), src_tokens.pivot->get_line(),
+		src_tokens.begin->get_begin(), src_tokens.pivot->get_begin(), (src_tokens.end - 1)->get_end(),
 		{}, {},
 		std::move(message)
 	};
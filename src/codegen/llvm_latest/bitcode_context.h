@@ -12,6 +12,7 @@
 #include "val_ptr.h"
 #include "common.h"
 #include "backend_context.h"
+#include "timer.h"
 
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/Function.h>
@@ -43,6 +44,7 @@ struct bitcode_context
 	llvm::DataLayout const &get_data_layout(void) const noexcept;
 	llvm::Module &get_module(void) const noexcept;
 	abi::platform_abi get_platform_abi(void) const noexcept;
+	llvm::TargetMachine const &get_target_machine(void) const noexcept;
 
 	size_t get_size(llvm::Type *t) const;
 	size_t get_align(llvm::Type *t) const;
@@ -153,6 +155,7 @@ struct bitcode_context
 	void pop_loop(loop_info_t info) noexcept;
 
 	void ensure_function_emission(ast::function_body *func);
+	bool is_in_compilation_unit(lex::src_tokens const &src_tokens) const;
 
 
 	void report_error(
@@ -167,6 +170,7 @@ struct bitcode_context
 	ctx::global_context &global_ctx;
 	backend_context &backend_ctx;
 	llvm::Module *module;
+	uint32_t compilation_unit_file_id = 0;
 
 	std::unordered_map<ast::decl_variable const *, llvm::Value *> move_destruct_indicators{};
 	std::unordered_map<ast::decl_variable const *, value_and_type_pair> vars_{};
@@ -199,6 +203,7 @@ struct bitcode_context
 
 	llvm::FunctionAnalysisManager *function_analysis_manager = nullptr;
 	llvm::FunctionPassManager *function_pass_manager = nullptr;
+	timer::duration function_pass_manager_duration{};
 };
 
 } // namespace codegen::llvm_latest
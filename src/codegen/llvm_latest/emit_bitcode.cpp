@@ -4,6 +4,9 @@
 #include "ctx/global_context.h"
 
 #include <llvm/IR/Verifier.h>
+#include <llvm/IR/MDBuilder.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+#include <llvm/TargetParser/X86TargetParser.h>
 
 namespace codegen::llvm_latest
 {
@@ -244,7 +247,9 @@ static void emit_panic_call(
 	auto const panic_handler_func_body = context.get_builtin_function(ast::function_body::builtin_panic_handler);
 	if (panic_handler_func_body == nullptr)
 	{
-		context.builder.CreateIntrinsic(llvm::Intrinsic::trap, {});
+		// the cold call makes the block cold, so it's placed away from the hot code
+		auto const trap = context.builder.CreateIntrinsic(llvm::Intrinsic::trap, {});
+		trap->addFnAttr(llvm::Attribute::Cold);
 
 		auto const current_ret_type = context.current_function.second->getReturnType();
 		if (current_ret_type->isVoidTy())
@@ -291,6 +296,7 @@ static void emit_panic_call(
 	add_call_parameter<false>(param_type, param_llvm_type, param, params, params_is_byval, context);
 
 	auto const call = context.create_call(panic_handler_fn, llvm::ArrayRef(params.data(), params.size()));
+	call->addFnAttr(llvm::Attribute::Cold);
 	auto is_byval_it = params_is_byval.begin();
 	auto const is_byval_end = params_is_byval.end();
 	unsigned i = 0;
@@ -2053,8 +2059,8 @@ static val_ptr emit_builtin_subscript_range(
 	auto const result_value = val_ptr::get_reference(result_address, context.get_slice_t());
 
 	bz_assert(rhs_type.is<ast::ts_base_type>());
-	bz_assert(rhs_type.get<ast::ts_base_type>().info->type_name.values.size() == 1);
-	auto const kind = range_kind_from_name(rhs_type.get<ast::ts_base_type>().info->type_name.values[0]);
+	bz_assert(rhs_type.get<ast::ts_base_type>().info->type_name.ids.size() == 1);
+	auto const kind = range_kind_from_name(rhs_type.get<ast::ts_base_type>().info->type_name.get_value(0));
 
 	auto const is_unsigned_index = [&]() {
 		if (kind == range_kind::unbounded)
@@ -2314,6 +2320,542 @@ static val_ptr emit_builtin_binary_bool_or(
 	return value_or_result_address(phi, result_address, context);
 }
 
+// the operands of the vector intrinsics are arrays, which are loaded and stored as llvm vectors.  bools
+// take up a byte in arrays, but <N x i1> is bit packed in memory, so they are loaded as <N x i8>.
+
+static llvm::Type *get_vector_memory_element_type(llvm::Type *elem_type, bitcode_context &context)
+{
+	return elem_type->isIntegerTy(1) ? context.get_uint8_t() : elem_type;
+}
+
+static llvm::Value *emit_vector_load(val_ptr array, bitcode_context &context)
+{
+	auto const array_type = array.get_type();
+	bz_assert(array_type->isArrayTy());
+	auto const elem_type = array_type->getArrayElementType();
+	auto const size = array_type->getArrayNumElements();
+
+	if (array.kind == val_ptr::reference && array.consteval_val == nullptr)
+	{
+		auto const memory_elem_type = get_vector_memory_element_type(elem_type, context);
+		auto const memory_vector_type = llvm::FixedVectorType::get(memory_elem_type, size);
+		// the array only has the alignment of its elements
+		auto const result = context.builder.CreateAlignedLoad(
+			memory_vector_type,
+			array.val,
+			llvm::Align(context.get_align(memory_elem_type))
+		);
+		return memory_elem_type == elem_type
+			? result
+			: context.builder.CreateICmpNE(result, llvm::Constant::getNullValue(memory_vector_type));
+	}
+	else
+	{
+		auto const array_value = array.get_value(context.builder);
+		llvm::Value *result = llvm::PoisonValue::get(llvm::FixedVectorType::get(elem_type, size));
+		for (auto const i : bz::iota(0, size))
+		{
+			auto const elem = context.builder.CreateExtractValue(array_value, i);
+			result = context.builder.CreateInsertElement(result, elem, i);
+		}
+		return result;
+	}
+}
+
+static val_ptr emit_vector_store(
+	llvm::Value *vector,
+	llvm::Type *array_type,
+	bitcode_context &context,
+	llvm::Value *result_address
+)
+{
+	bz_assert(array_type->isArrayTy());
+	if (result_address == nullptr)
+	{
+		result_address = context.create_alloca(array_type);
+	}
+
+	auto const elem_type = array_type->getArrayElementType();
+	auto const memory_elem_type = get_vector_memory_element_type(elem_type, context);
+	auto const memory_vector = memory_elem_type == elem_type
+		? vector
+		: context.builder.CreateZExt(vector, llvm::FixedVectorType::get(memory_elem_type, array_type->getArrayNumElements()));
+	context.builder.CreateAlignedStore(memory_vector, result_address, llvm::Align(context.get_align(memory_elem_type)));
+	return val_ptr::get_reference(result_address, array_type);
+}
+
+static uint8_t get_vector_element_kind(ast::typespec_view vector_type)
+{
+	vector_type = vector_type.remove_any_mut();
+	bz_assert(vector_type.is<ast::ts_array>());
+	auto const elem_type = vector_type.get<ast::ts_array>().elem_type.as_typespec_view();
+	bz_assert(elem_type.is<ast::ts_base_type>());
+	return elem_type.get<ast::ts_base_type>().info->kind;
+}
+
+static llvm::Value *emit_vector_binary_op(
+	uint32_t intrinsic_kind,
+	llvm::Value *lhs,
+	llvm::Value *rhs,
+	uint8_t elem_kind,
+	bitcode_context &context
+)
+{
+	auto const is_signed = ast::is_signed_integer_kind(elem_kind);
+	auto const is_float = ast::is_floating_point_kind(elem_kind);
+
+	if (
+		is_signed
+		&& (intrinsic_kind == ast::function_body::vector_div || intrinsic_kind == ast::function_body::vector_rem)
+	)
+	{
+		// min / -1 is undefined behavior in llvm, but it's min for division and 0 for modulo in
+		// scalar code, which is what we get by dividing with 1 instead
+		auto const vector_type = lhs->getType();
+		auto const min_value = llvm::ConstantInt::get(
+			vector_type,
+			llvm::APInt::getSignedMinValue(vector_type->getScalarSizeInBits())
+		);
+		auto const is_overflow = context.builder.CreateAnd(
+			context.builder.CreateICmpEQ(lhs, min_value),
+			context.builder.CreateICmpEQ(rhs, llvm::Constant::getAllOnesValue(vector_type))
+		);
+		rhs = context.builder.CreateSelect(is_overflow, llvm::ConstantInt::get(vector_type, 1), rhs);
+	}
+
+	switch (intrinsic_kind)
+	{
+	case ast::function_body::vector_add:
+		return is_float ? context.builder.CreateFAdd(lhs, rhs) : context.builder.CreateAdd(lhs, rhs);
+	case ast::function_body::vector_sub:
+		return is_float ? context.builder.CreateFSub(lhs, rhs) : context.builder.CreateSub(lhs, rhs);
+	case ast::function_body::vector_mul:
+		return is_float ? context.builder.CreateFMul(lhs, rhs) : context.builder.CreateMul(lhs, rhs);
+	case ast::function_body::vector_div:
+		return is_float ? context.builder.CreateFDiv(lhs, rhs)
+			: is_signed ? context.builder.CreateSDiv(lhs, rhs)
+			: context.builder.CreateUDiv(lhs, rhs);
+	case ast::function_body::vector_rem:
+		return is_signed ? context.builder.CreateSRem(lhs, rhs) : context.builder.CreateURem(lhs, rhs);
+	case ast::function_body::vector_and:
+		return context.builder.CreateAnd(lhs, rhs);
+	case ast::function_body::vector_or:
+		return context.builder.CreateOr(lhs, rhs);
+	case ast::function_body::vector_xor:
+		return context.builder.CreateXor(lhs, rhs);
+	case ast::function_body::vector_shl:
+		return context.builder.CreateShl(lhs, rhs);
+	case ast::function_body::vector_shr:
+		return context.builder.CreateLShr(lhs, rhs);
+	case ast::function_body::vector_min:
+		return is_float ? context.builder.CreateMinNum(lhs, rhs)
+			: context.builder.CreateBinaryIntrinsic(is_signed ? llvm::Intrinsic::smin : llvm::Intrinsic::umin, lhs, rhs);
+	case ast::function_body::vector_max:
+		return is_float ? context.builder.CreateMaxNum(lhs, rhs)
+			: context.builder.CreateBinaryIntrinsic(is_signed ? llvm::Intrinsic::smax : llvm::Intrinsic::umax, lhs, rhs);
+	case ast::function_body::vector_eq:
+		return is_float ? context.builder.CreateFCmpOEQ(lhs, rhs) : context.builder.CreateICmpEQ(lhs, rhs);
+	case ast::function_body::vector_neq:
+		return is_float ? context.builder.CreateFCmpUNE(lhs, rhs) : context.builder.CreateICmpNE(lhs, rhs);
+	case ast::function_body::vector_lt:
+		return is_float ? context.builder.CreateFCmpOLT(lhs, rhs)
+			: is_signed ? context.builder.CreateICmpSLT(lhs, rhs)
+			: context.builder.CreateICmpULT(lhs, rhs);
+	case ast::function_body::vector_gt:
+		return is_float ? context.builder.CreateFCmpOGT(lhs, rhs)
+			: is_signed ? context.builder.CreateICmpSGT(lhs, rhs)
+			: context.builder.CreateICmpUGT(lhs, rhs);
+	case ast::function_body::vector_lte:
+		return is_float ? context.builder.CreateFCmpOLE(lhs, rhs)
+			: is_signed ? context.builder.CreateICmpSLE(lhs, rhs)
+			: context.builder.CreateICmpULE(lhs, rhs);
+	case ast::function_body::vector_gte:
+		return is_float ? context.builder.CreateFCmpOGE(lhs, rhs)
+			: is_signed ? context.builder.CreateICmpSGE(lhs, rhs)
+			: context.builder.CreateICmpUGE(lhs, rhs);
+	default:
+		bz_unreachable;
+	}
+}
+
+static llvm::Value *emit_vector_reduce(
+	uint32_t intrinsic_kind,
+	llvm::Value *vector,
+	uint8_t elem_kind,
+	bitcode_context &context
+)
+{
+	auto const is_signed = ast::is_signed_integer_kind(elem_kind);
+	auto const is_float = ast::is_floating_point_kind(elem_kind);
+	auto const elem_type = vector->getType()->getScalarType();
+	switch (intrinsic_kind)
+	{
+	// floating-point additions and multiplications are done in order, so the result
+	// is the same as the one calculated at compile time
+	case ast::function_body::vector_reduce_add:
+		return is_float
+			? context.builder.CreateFAddReduce(llvm::ConstantFP::getNegativeZero(elem_type), vector)
+			: context.builder.CreateAddReduce(vector);
+	case ast::function_body::vector_reduce_mul:
+		return is_float
+			? context.builder.CreateFMulReduce(llvm::ConstantFP::get(elem_type, 1.0), vector)
+			: context.builder.CreateMulReduce(vector);
+	case ast::function_body::vector_reduce_min:
+		return is_float ? context.builder.CreateFPMinReduce(vector) : context.builder.CreateIntMinReduce(vector, is_signed);
+	case ast::function_body::vector_reduce_max:
+		return is_float ? context.builder.CreateFPMaxReduce(vector) : context.builder.CreateIntMaxReduce(vector, is_signed);
+	case ast::function_body::vector_reduce_and:
+		return context.builder.CreateAndReduce(vector);
+	case ast::function_body::vector_reduce_or:
+		return context.builder.CreateOrReduce(vector);
+	case ast::function_body::vector_reduce_xor:
+		return context.builder.CreateXorReduce(vector);
+	default:
+		bz_unreachable;
+	}
+}
+
+static val_ptr emit_vector_intrinsic_call(
+	ast::expr_function_call const &func_call,
+	bitcode_context &context,
+	llvm::Value *result_address
+)
+{
+	auto const intrinsic_kind = func_call.func_body->intrinsic_kind;
+	switch (intrinsic_kind)
+	{
+	case ast::function_body::vector_select:
+	{
+		bz_assert(func_call.params.size() == 3);
+		auto const mask = emit_vector_load(emit_bitcode(func_call.params[0], context, nullptr), context);
+		auto const lhs  = emit_vector_load(emit_bitcode(func_call.params[1], context, nullptr), context);
+		auto const rhs  = emit_vector_load(emit_bitcode(func_call.params[2], context, nullptr), context);
+		auto const result = context.builder.CreateSelect(mask, lhs, rhs);
+		return emit_vector_store(result, get_llvm_type(func_call.func_body->return_type, context), context, result_address);
+	}
+	case ast::function_body::vector_shuffle:
+	{
+		bz_assert(func_call.params.size() == 2);
+		auto const value = emit_vector_load(emit_bitcode(func_call.params[0], context, nullptr), context);
+		// the indices are checked to be constant in src/ctx/parse_context.cpp
+		bz_assert(func_call.params[1].is_constant());
+		auto const &indices_value = func_call.params[1].get_constant_value();
+		bz::vector<int> mask;
+		if (indices_value.is_uint_array())
+		{
+			for (auto const index : indices_value.get_uint_array())
+			{
+				mask.push_back(static_cast<int>(index));
+			}
+		}
+		else
+		{
+			bz_assert(indices_value.is_array());
+			for (auto const &index : indices_value.get_array())
+			{
+				mask.push_back(static_cast<int>(index.get_uint()));
+			}
+		}
+		auto const result = context.builder.CreateShuffleVector(value, llvm::ArrayRef(mask.data(), mask.size()));
+		return emit_vector_store(result, get_llvm_type(func_call.func_body->return_type, context), context, result_address);
+	}
+	case ast::function_body::vector_reduce_add:
+	case ast::function_body::vector_reduce_mul:
+	case ast::function_body::vector_reduce_min:
+	case ast::function_body::vector_reduce_max:
+	case ast::function_body::vector_reduce_and:
+	case ast::function_body::vector_reduce_or:
+	case ast::function_body::vector_reduce_xor:
+	{
+		bz_assert(func_call.params.size() == 1);
+		auto const value = emit_vector_load(emit_bitcode(func_call.params[0], context, nullptr), context);
+		auto const elem_kind = get_vector_element_kind(func_call.params[0].get_expr_type());
+		auto const result = emit_vector_reduce(intrinsic_kind, value, elem_kind, context);
+		return value_or_result_address(result, result_address, context);
+	}
+	case ast::function_body::vector_masked_load:
+	{
+		bz_assert(func_call.params.size() == 3);
+		auto const ptr = emit_bitcode(func_call.params[0], context, nullptr).get_value(context.builder);
+		auto const mask = emit_vector_load(emit_bitcode(func_call.params[1], context, nullptr), context);
+		auto const passthru = emit_vector_load(emit_bitcode(func_call.params[2], context, nullptr), context);
+		auto const array_type = get_llvm_type(func_call.func_body->return_type, context);
+		auto const elem_type = array_type->getArrayElementType();
+		auto const memory_elem_type = get_vector_memory_element_type(elem_type, context);
+		auto const memory_vector_type = llvm::FixedVectorType::get(memory_elem_type, array_type->getArrayNumElements());
+		auto const memory_passthru = memory_elem_type == elem_type
+			? passthru
+			: context.builder.CreateZExt(passthru, memory_vector_type);
+		auto const memory_result = context.builder.CreateMaskedLoad(
+			memory_vector_type,
+			ptr,
+			llvm::Align(context.get_align(memory_elem_type)),
+			mask,
+			memory_passthru
+		);
+		auto const result = memory_elem_type == elem_type
+			? memory_result
+			: context.builder.CreateICmpNE(memory_result, llvm::Constant::getNullValue(memory_vector_type));
+		return emit_vector_store(result, array_type, context, result_address);
+	}
+	case ast::function_body::vector_masked_store:
+	{
+		bz_assert(func_call.params.size() == 3);
+		auto const ptr = emit_bitcode(func_call.params[0], context, nullptr).get_value(context.builder);
+		auto const mask = emit_vector_load(emit_bitcode(func_call.params[1], context, nullptr), context);
+		auto const value = emit_vector_load(emit_bitcode(func_call.params[2], context, nullptr), context);
+		auto const elem_type = value->getType()->getScalarType();
+		auto const memory_elem_type = get_vector_memory_element_type(elem_type, context);
+		auto const memory_value = memory_elem_type == elem_type
+			? value
+			: context.builder.CreateZExt(value, llvm::FixedVectorType::get(memory_elem_type, llvm::cast<llvm::FixedVectorType>(value->getType())->getNumElements()));
+		context.builder.CreateMaskedStore(memory_value, ptr, llvm::Align(context.get_align(memory_elem_type)), mask);
+		bz_assert(result_address == nullptr);
+		return val_ptr::get_none();
+	}
+	default:
+	{
+		bz_assert(func_call.params.size() == 2);
+		auto const lhs = emit_vector_load(emit_bitcode(func_call.params[0], context, nullptr), context);
+		auto const rhs = emit_vector_load(emit_bitcode(func_call.params[1], context, nullptr), context);
+		auto const elem_kind = get_vector_element_kind(func_call.params[0].get_expr_type());
+		auto const result = emit_vector_binary_op(intrinsic_kind, lhs, rhs, elem_kind, context);
+		return emit_vector_store(result, get_llvm_type(func_call.func_body->return_type, context), context, result_address);
+	}
+	}
+}
+
+
+static llvm::AtomicOrdering get_atomic_ordering(ast::memory_order order)
+{
+	switch (order)
+	{
+	case ast::memory_order::relaxed:
+		return llvm::AtomicOrdering::Monotonic;
+	case ast::memory_order::acquire:
+		return llvm::AtomicOrdering::Acquire;
+	case ast::memory_order::release:
+		return llvm::AtomicOrdering::Release;
+	case ast::memory_order::acq_rel:
+		return llvm::AtomicOrdering::AcquireRelease;
+	case ast::memory_order::seq_cst:
+		return llvm::AtomicOrdering::SequentiallyConsistent;
+	}
+	bz_unreachable;
+}
+
+static bz::array_view<ast::memory_order const> get_runtime_memory_orders(uint32_t intrinsic_kind)
+{
+	// seq_cst is always last, because it's also used for invalid memory order values
+	static constexpr ast::memory_order load_orders[] = {
+		ast::memory_order::relaxed, ast::memory_order::acquire, ast::memory_order::seq_cst,
+	};
+	static constexpr ast::memory_order store_orders[] = {
+		ast::memory_order::relaxed, ast::memory_order::release, ast::memory_order::seq_cst,
+	};
+	static constexpr ast::memory_order fence_orders[] = {
+		ast::memory_order::acquire, ast::memory_order::release, ast::memory_order::acq_rel, ast::memory_order::seq_cst,
+	};
+	static constexpr ast::memory_order all_orders[] = {
+		ast::memory_order::relaxed, ast::memory_order::acquire, ast::memory_order::release,
+		ast::memory_order::acq_rel, ast::memory_order::seq_cst,
+	};
+
+	switch (intrinsic_kind)
+	{
+	case ast::function_body::atomic_load:
+		return load_orders;
+	case ast::function_body::atomic_store:
+		return store_orders;
+	case ast::function_body::atomic_fence:
+		return fence_orders;
+	default:
+		return all_orders;
+	}
+}
+
+// emits the atomic operation with the memory order given by 'order_expr'.  if it's not a constant expression,
+// a switch is emitted on 'order_value' with a case for every valid memory order, and the rest are treated as seq_cst
+template<typename EmitOp>
+static llvm::Value *emit_with_memory_order(
+	ast::expression const &order_expr,
+	llvm::Value *order_value,
+	uint32_t intrinsic_kind,
+	bitcode_context &context,
+	EmitOp &&emit_op
+)
+{
+	if (order_expr.is_constant())
+	{
+		auto const order = static_cast<ast::memory_order>(order_expr.get_constant_value().get_uint());
+		return emit_op(get_atomic_ordering(order));
+	}
+
+	auto const orders = get_runtime_memory_orders(intrinsic_kind);
+	auto const end_bb = context.add_basic_block("atomic_order_end");
+	auto const seq_cst_bb = context.add_basic_block("atomic_order_seq_cst");
+	auto const switch_inst = context.builder.CreateSwitch(order_value, seq_cst_bb, static_cast<unsigned>(orders.size() - 1));
+
+	bz::vector<std::pair<llvm::BasicBlock *, llvm::Value *>> results;
+	results.reserve(orders.size());
+	for (auto const order : orders)
+	{
+		auto const bb = order == ast::memory_order::seq_cst ? seq_cst_bb : context.add_basic_block("atomic_order_case");
+		if (order != ast::memory_order::seq_cst)
+		{
+			auto const order_val = llvm::ConstantInt::get(order_value->getType(), static_cast<uint32_t>(order));
+			switch_inst->addCase(llvm::cast<llvm::ConstantInt>(order_val), bb);
+		}
+		context.builder.SetInsertPoint(bb);
+		auto const result = emit_op(get_atomic_ordering(order));
+		results.push_back({ context.builder.GetInsertBlock(), result });
+		context.builder.CreateBr(end_bb);
+	}
+
+	context.builder.SetInsertPoint(end_bb);
+	if (results[0].second == nullptr)
+	{
+		return nullptr;
+	}
+
+	auto const phi = context.builder.CreatePHI(results[0].second->getType(), static_cast<unsigned>(results.size()));
+	for (auto const &[bb, result] : results)
+	{
+		phi->addIncoming(result, bb);
+	}
+	return phi;
+}
+
+static llvm::AtomicRMWInst::BinOp get_atomic_rmw_op(uint32_t intrinsic_kind)
+{
+	switch (intrinsic_kind)
+	{
+	case ast::function_body::atomic_exchange:
+		return llvm::AtomicRMWInst::Xchg;
+	case ast::function_body::atomic_fetch_add:
+		return llvm::AtomicRMWInst::Add;
+	case ast::function_body::atomic_fetch_sub:
+		return llvm::AtomicRMWInst::Sub;
+	case ast::function_body::atomic_fetch_and:
+		return llvm::AtomicRMWInst::And;
+	case ast::function_body::atomic_fetch_or:
+		return llvm::AtomicRMWInst::Or;
+	case ast::function_body::atomic_fetch_xor:
+		return llvm::AtomicRMWInst::Xor;
+	default:
+		bz_unreachable;
+	}
+}
+
+static val_ptr emit_atomic_intrinsic_call(
+	ast::expr_function_call const &func_call,
+	bitcode_context &context,
+	llvm::Value *result_address
+)
+{
+	auto const intrinsic_kind = func_call.func_body->intrinsic_kind;
+	switch (intrinsic_kind)
+	{
+	case ast::function_body::atomic_load:
+	{
+		bz_assert(func_call.params.size() == 2);
+		auto const ptr = emit_bitcode(func_call.params[0], context, nullptr).get_value(context.builder);
+		auto const order = emit_bitcode(func_call.params[1], context, nullptr).get_value(context.builder);
+		auto const type = get_llvm_type(func_call.func_body->return_type, context);
+		auto const result = emit_with_memory_order(
+			func_call.params[1], order, intrinsic_kind, context,
+			[&](llvm::AtomicOrdering ordering) -> llvm::Value * {
+				auto const load = context.builder.CreateAlignedLoad(type, ptr, llvm::Align(context.get_align(type)));
+				load->setAtomic(ordering);
+				return load;
+			}
+		);
+		return value_or_result_address(result, result_address, context);
+	}
+	case ast::function_body::atomic_store:
+	{
+		bz_assert(func_call.params.size() == 3);
+		auto const ptr = emit_bitcode(func_call.params[0], context, nullptr).get_value(context.builder);
+		auto const value = emit_bitcode(func_call.params[1], context, nullptr).get_value(context.builder);
+		auto const order = emit_bitcode(func_call.params[2], context, nullptr).get_value(context.builder);
+		emit_with_memory_order(
+			func_call.params[2], order, intrinsic_kind, context,
+			[&](llvm::AtomicOrdering ordering) -> llvm::Value * {
+				auto const store = context.builder.CreateAlignedStore(value, ptr, llvm::Align(context.get_align(value->getType())));
+				store->setAtomic(ordering);
+				return nullptr;
+			}
+		);
+		bz_assert(result_address == nullptr);
+		return val_ptr::get_none();
+	}
+	case ast::function_body::atomic_compare_exchange:
+	{
+		bz_assert(func_call.params.size() == 5);
+		auto const ptr = emit_bitcode(func_call.params[0], context, nullptr).get_value(context.builder);
+		auto const expected_ref = emit_bitcode(func_call.params[1], context, nullptr);
+		bz_assert(expected_ref.kind == val_ptr::reference);
+		auto const desired = emit_bitcode(func_call.params[2], context, nullptr).get_value(context.builder);
+		auto const success_order = emit_bitcode(func_call.params[3], context, nullptr).get_value(context.builder);
+		emit_bitcode(func_call.params[4], context, nullptr);
+		auto const expected = expected_ref.get_value(context.builder);
+
+		// a failure order that isn't a constant expression is treated as seq_cst, llvm allows it to be
+		// stronger than the success order
+		auto const failure_ordering = func_call.params[4].is_constant()
+			? get_atomic_ordering(static_cast<ast::memory_order>(func_call.params[4].get_constant_value().get_uint()))
+			: llvm::AtomicOrdering::SequentiallyConsistent;
+		auto const result = emit_with_memory_order(
+			func_call.params[3], success_order, intrinsic_kind, context,
+			[&](llvm::AtomicOrdering ordering) -> llvm::Value * {
+				return context.builder.CreateAtomicCmpXchg(
+					ptr, expected, desired,
+					llvm::MaybeAlign(context.get_align(desired->getType())),
+					ordering, failure_ordering
+				);
+			}
+		);
+
+		// the old value is always written back, it's the same as 'expected' if the exchange succeeded
+		context.builder.CreateStore(context.builder.CreateExtractValue(result, 0), expected_ref.val);
+		auto const is_success = context.builder.CreateExtractValue(result, 1);
+		return value_or_result_address(is_success, result_address, context);
+	}
+	case ast::function_body::atomic_fence:
+	{
+		bz_assert(func_call.params.size() == 1);
+		auto const order = emit_bitcode(func_call.params[0], context, nullptr).get_value(context.builder);
+		emit_with_memory_order(
+			func_call.params[0], order, intrinsic_kind, context,
+			[&](llvm::AtomicOrdering ordering) -> llvm::Value * {
+				context.builder.CreateFence(ordering);
+				return nullptr;
+			}
+		);
+		bz_assert(result_address == nullptr);
+		return val_ptr::get_none();
+	}
+	default:
+	{
+		bz_assert(func_call.params.size() == 3);
+		auto const ptr = emit_bitcode(func_call.params[0], context, nullptr).get_value(context.builder);
+		auto const value = emit_bitcode(func_call.params[1], context, nullptr).get_value(context.builder);
+		auto const order = emit_bitcode(func_call.params[2], context, nullptr).get_value(context.builder);
+		auto const result = emit_with_memory_order(
+			func_call.params[2], order, intrinsic_kind, context,
+			[&](llvm::AtomicOrdering ordering) -> llvm::Value * {
+				return context.builder.CreateAtomicRMW(
+					get_atomic_rmw_op(intrinsic_kind),
+					ptr, value,
+					llvm::MaybeAlign(context.get_align(value->getType())),
+					ordering
+				);
+			}
+		);
+		return value_or_result_address(result, result_address, context);
+	}
+	}
+}
 
 static val_ptr emit_bitcode(
 	lex::src_tokens const &,
@@ -2551,7 +3093,7 @@ static val_ptr emit_bitcode(
 	{
 		switch (func_call.func_body->intrinsic_kind)
 		{
-		static_assert(ast::function_body::_builtin_last - ast::function_body::_builtin_first == 285);
+		static_assert(ast::function_body::_builtin_last - ast::function_body::_builtin_first == 325);
 		static_assert(ast::function_body::_builtin_default_constructor_last - ast::function_body::_builtin_default_constructor_first == 14);
 		static_assert(ast::function_body::_builtin_unary_operator_last - ast::function_body::_builtin_unary_operator_first == 7);
 		static_assert(ast::function_body::_builtin_binary_operator_last - ast::function_body::_builtin_binary_operator_first == 28);
@@ -3119,6 +3661,15 @@ static val_ptr emit_bitcode(
 		{
 			return value_or_result_address(context.builder.getFalse(), result_address, context);
 		}
+		case ast::function_body::builtin_expect:
+		{
+			bz_assert(func_call.params.size() == 2);
+			auto const value = emit_bitcode(func_call.params[0], context, nullptr).get_value(context.builder);
+			auto const expected = emit_bitcode(func_call.params[1], context, nullptr).get_value(context.builder);
+			// llvm.expect is turned into branch weights by LowerExpectIntrinsic
+			auto const result = context.builder.CreateIntrinsic(llvm::Intrinsic::expect, { value->getType() }, { value, expected });
+			return value_or_result_address(result, result_address, context);
+		}
 		case ast::function_body::builtin_panic:
 		{
 			auto const handler_fn = context.get_builtin_function(ast::function_body::builtin_panic_handler);
@@ -3605,6 +4156,47 @@ static val_ptr emit_bitcode(
 			auto const result = context.builder.CreateAShr(n, amount);
 			return value_or_result_address(result, result_address, context);
 		}
+		case ast::function_body::vector_add:
+		case ast::function_body::vector_sub:
+		case ast::function_body::vector_mul:
+		case ast::function_body::vector_div:
+		case ast::function_body::vector_rem:
+		case ast::function_body::vector_and:
+		case ast::function_body::vector_or:
+		case ast::function_body::vector_xor:
+		case ast::function_body::vector_shl:
+		case ast::function_body::vector_shr:
+		case ast::function_body::vector_min:
+		case ast::function_body::vector_max:
+		case ast::function_body::vector_eq:
+		case ast::function_body::vector_neq:
+		case ast::function_body::vector_lt:
+		case ast::function_body::vector_gt:
+		case ast::function_body::vector_lte:
+		case ast::function_body::vector_gte:
+		case ast::function_body::vector_select:
+		case ast::function_body::vector_shuffle:
+		case ast::function_body::vector_reduce_add:
+		case ast::function_body::vector_reduce_mul:
+		case ast::function_body::vector_reduce_min:
+		case ast::function_body::vector_reduce_max:
+		case ast::function_body::vector_reduce_and:
+		case ast::function_body::vector_reduce_or:
+		case ast::function_body::vector_reduce_xor:
+		case ast::function_body::vector_masked_load:
+		case ast::function_body::vector_masked_store:
+			return emit_vector_intrinsic_call(func_call, context, result_address);
+		case ast::function_body::atomic_load:
+		case ast::function_body::atomic_store:
+		case ast::function_body::atomic_exchange:
+		case ast::function_body::atomic_compare_exchange:
+		case ast::function_body::atomic_fetch_add:
+		case ast::function_body::atomic_fetch_sub:
+		case ast::function_body::atomic_fetch_and:
+		case ast::function_body::atomic_fetch_or:
+		case ast::function_body::atomic_fetch_xor:
+		case ast::function_body::atomic_fence:
+			return emit_atomic_intrinsic_call(func_call, context, result_address);
 
 		case ast::function_body::comptime_malloc:
 		case ast::function_body::comptime_free:
@@ -5842,6 +6434,24 @@ static val_ptr emit_bitcode(
 	}
 }
 
+// the same weights are used for '@likely' and '@unlikely' as for llvm.expect in LowerExpectIntrinsic
+static constexpr uint32_t likely_branch_weight = 2000;
+static constexpr uint32_t unlikely_branch_weight = 1;
+
+static llvm::MDNode *get_if_branch_weights(ast::branch_likelihood then_likelihood, bitcode_context &context)
+{
+	switch (then_likelihood)
+	{
+	case ast::branch_likelihood::none:
+		return nullptr;
+	case ast::branch_likelihood::likely:
+		return llvm::MDBuilder(context.get_llvm_context()).createBranchWeights(likely_branch_weight, unlikely_branch_weight);
+	case ast::branch_likelihood::unlikely:
+		return llvm::MDBuilder(context.get_llvm_context()).createBranchWeights(unlikely_branch_weight, likely_branch_weight);
+	}
+	bz_unreachable;
+}
+
 static val_ptr emit_bitcode(
 	lex::src_tokens const &,
 	ast::expr_if const &if_expr,
@@ -5898,7 +6508,7 @@ static val_ptr emit_bitcode(
 	{
 		context.builder.SetInsertPoint(entry_bb);
 		// else_bb must be valid here
-		context.builder.CreateCondBr(condition, then_bb, else_bb);
+		context.builder.CreateCondBr(condition, then_bb, else_bb, get_if_branch_weights(if_expr.then_likelihood, context));
 		return val_ptr::get_none();
 	}
 
@@ -5918,7 +6528,10 @@ static val_ptr emit_bitcode(
 	auto const end_bb = context.add_basic_block("endif");
 	// create branches for the entry block
 	context.builder.SetInsertPoint(entry_bb);
-	context.builder.CreateCondBr(condition, then_bb, else_bb != nullptr ? else_bb : end_bb);
+	context.builder.CreateCondBr(
+		condition, then_bb, else_bb != nullptr ? else_bb : end_bb,
+		get_if_branch_weights(if_expr.then_likelihood, context)
+	);
 
 	// create branches for the then and else blocks, if there's no return at the end
 	if (!context.has_terminator(then_bb_end))
@@ -6058,6 +6671,49 @@ static val_ptr emit_integral_switch(
 			case_result_vals.push_back({ context.builder.GetInsertBlock(), case_val });
 		}
 	}
+	if (switch_expr.case_likelihoods.not_empty())
+	{
+		bz_assert(switch_expr.case_likelihoods.size() == switch_expr.cases.size());
+		// cases without a hint are considered likely if there are only '@unlikely' hints, and unlikely otherwise
+		auto const has_likely = switch_expr.default_likelihood == ast::branch_likelihood::likely
+			|| switch_expr.case_likelihoods.contains(ast::branch_likelihood::likely);
+		auto const get_weight = [has_likely](ast::branch_likelihood likelihood) -> uint32_t {
+			switch (likelihood)
+			{
+			case ast::branch_likelihood::none:
+				return has_likely ? unlikely_branch_weight : likely_branch_weight;
+			case ast::branch_likelihood::likely:
+				return likely_branch_weight;
+			case ast::branch_likelihood::unlikely:
+				return unlikely_branch_weight;
+			}
+			bz_unreachable;
+		};
+
+		// the first weight is for the default destination
+		bz::vector<uint32_t> weights;
+		weights.reserve(case_count + 1);
+		if (has_default || !switch_expr.is_complete)
+		{
+			weights.push_back(get_weight(switch_expr.default_likelihood));
+		}
+		else
+		{
+			// an invalid value was used in the switch
+			weights.push_back(unlikely_branch_weight);
+		}
+		for (auto const &[switch_case, likelihood] : bz::zip(switch_expr.cases, switch_expr.case_likelihoods))
+		{
+			for ([[maybe_unused]] auto const &_ : switch_case.values)
+			{
+				weights.push_back(get_weight(likelihood));
+			}
+		}
+		switch_inst->setMetadata(
+			llvm::LLVMContext::MD_prof,
+			llvm::MDBuilder(context.get_llvm_context()).createBranchWeights(llvm::ArrayRef(weights.data(), weights.size()))
+		);
+	}
 	auto const end_bb = switch_expr.is_complete ? context.add_basic_block("switch_end") : default_bb;
 	auto const has_value = case_result_vals.not_empty() && case_result_vals.is_all([&](auto const &pair) {
 		return pair.second.val != nullptr || pair.second.consteval_val != nullptr;
@@ -7720,6 +8376,34 @@ static llvm::Function *create_function_from_symbol(
 		fn->addRetAttr(llvm::Attribute::ZExt);
 	}
 
+	// the target CPU and features are also needed on the functions, otherwise the optimizer
+	// (e.g. the vectorizers) only uses the baseline instruction set of the target
+	auto const &target_machine = context.get_target_machine();
+	fn->addFnAttr("target-cpu", target_machine.getTargetCPU());
+	if (!target_machine.getTargetFeatureString().empty())
+	{
+		fn->addFnAttr("target-features", target_machine.getTargetFeatureString());
+	}
+
+	if (func_body.is_always_inline())
+	{
+		fn->addFnAttr(llvm::Attribute::AlwaysInline);
+	}
+	else if (func_body.is_no_inline())
+	{
+		fn->addFnAttr(llvm::Attribute::NoInline);
+	}
+
+	// the panic handler is only called on error paths, which also makes the blocks calling it cold
+	if (func_body.is_cold() || &func_body == context.get_builtin_function(ast::function_body::builtin_panic_handler))
+	{
+		fn->addFnAttr(llvm::Attribute::Cold);
+	}
+	else if (func_body.is_hot())
+	{
+		fn->addFnAttr(llvm::Attribute::Hot);
+	}
+
 	switch (func_body.cc)
 	{
 	static_assert(static_cast<size_t>(::abi::calling_convention::_last) == 3);
@@ -7923,7 +8607,9 @@ void emit_function_bitcode(
 	// run the function pass manager on the generated function
 	if (context.function_pass_manager != nullptr)
 	{
+		auto const begin = timer::now();
 		context.function_pass_manager->run(*fn, *context.function_analysis_manager);
+		context.function_pass_manager_duration += timer::now() - begin;
 	}
 }
 
@@ -7966,7 +8652,8 @@ static void emit_global_variable_impl(ast::decl_variable const &var_decl, bitcod
 	{
 		global_var->setLinkage(llvm::GlobalValue::InternalLinkage);
 	}
-	if (!var_decl.is_extern())
+	// variables with external linkage are only defined in their own compilation unit
+	if (!var_decl.is_extern() && (!var_decl.is_external_linkage() || context.is_in_compilation_unit(var_decl.src_tokens)))
 	{
 		bz_assert(var_decl.init_expr.is_constant());
 		auto const &const_expr = var_decl.init_expr.get_constant();
@@ -8096,6 +8783,150 @@ void emit_necessary_functions(bitcode_context &context)
 	}
 }
 
+// emits the check of whether the CPU supports all features in 'feature_mask' in the same way as
+// clang's __builtin_cpu_supports, using the variables set by __cpu_indicator_init in libgcc or compiler-rt
+static llvm::Value *emit_cpu_supports_check(
+	std::array<uint32_t, 4> const &feature_mask,
+	llvm::IRBuilder<> &builder,
+	bitcode_context &context
+)
+{
+	auto &module = context.get_module();
+	auto const int32_t = context.get_int32_t();
+	llvm::Value *result = builder.getTrue();
+
+	if (feature_mask[0] != 0)
+	{
+		// struct { vendor: u32, type: u32, subtype: u32, features: [1: u32] }
+		auto const cpu_model_t = llvm::StructType::get(int32_t, int32_t, int32_t, llvm::ArrayType::get(int32_t, 1));
+		auto const cpu_model = llvm::cast<llvm::GlobalVariable>(module.getOrInsertGlobal("__cpu_model", cpu_model_t));
+		cpu_model->setDSOLocal(true);
+		auto const features_ptr = builder.CreateConstInBoundsGEP2_32(cpu_model_t, cpu_model, 0, 3);
+		auto const features = builder.CreateAlignedLoad(int32_t, features_ptr, llvm::Align(4));
+		auto const mask = builder.getInt32(feature_mask[0]);
+		result = builder.CreateAnd(result, builder.CreateICmpEQ(builder.CreateAnd(features, mask), mask));
+	}
+
+	auto const cpu_features2_t = llvm::ArrayType::get(int32_t, 3);
+	for (auto const i : bz::iota(1, feature_mask.size()))
+	{
+		if (feature_mask[i] == 0)
+		{
+			continue;
+		}
+
+		auto const cpu_features2 = llvm::cast<llvm::GlobalVariable>(module.getOrInsertGlobal("__cpu_features2", cpu_features2_t));
+		cpu_features2->setDSOLocal(true);
+		auto const features_ptr = builder.CreateConstInBoundsGEP2_32(cpu_features2_t, cpu_features2, 0, i - 1);
+		auto const features = builder.CreateAlignedLoad(int32_t, features_ptr, llvm::Align(4));
+		auto const mask = builder.getInt32(feature_mask[i]);
+		result = builder.CreateAnd(result, builder.CreateICmpEQ(builder.CreateAnd(features, mask), mask));
+	}
+
+	return result;
+}
+
+static void emit_target_clones_dispatch(ast::function_body &func_body, bitcode_context &context)
+{
+	struct clone_info_t
+	{
+		llvm::Function *fn;
+		std::array<uint32_t, 4> feature_mask;
+	};
+
+	auto &module = context.get_module();
+	auto const fn = context.get_function(&func_body);
+	bz_assert(fn != nullptr);
+	auto const name = fn->getName().str();
+	auto const linkage = fn->getLinkage();
+	auto const base_features = fn->getFnAttribute("target-features").getValueAsString().str();
+
+	bz::vector<clone_info_t> clones;
+	clones.reserve(func_body.target_clones.size());
+	for (auto const &features : func_body.target_clones)
+	{
+		auto const features_ref = llvm::StringRef(features.data_as_char_ptr(), features.size());
+		llvm::SmallVector<llvm::StringRef, 4> feature_names;
+		features_ref.split(feature_names, ',');
+
+		// the feature names were already checked when the attribute was resolved
+		std::string clone_features = base_features;
+		for (auto const feature : feature_names)
+		{
+			if (!clone_features.empty())
+			{
+				clone_features += ',';
+			}
+			clone_features += '+';
+			clone_features += feature.str();
+		}
+
+		// the body is cloned from the already emitted default version, so it's only emitted once
+		llvm::ValueToValueMapTy value_map;
+		auto const clone = llvm::CloneFunction(fn, value_map);
+		auto clone_suffix = features_ref.str();
+		std::replace(clone_suffix.begin(), clone_suffix.end(), ',', '_');
+		clone->setName(name + "." + clone_suffix);
+		clone->setLinkage(llvm::GlobalValue::InternalLinkage);
+		clone->addFnAttr("target-features", clone_features);
+		clones.push_back({ clone, llvm::X86::getCpuSupportsMask(feature_names) });
+	}
+
+	if (clones.empty())
+	{
+		return;
+	}
+
+	fn->setName(name + ".default");
+	fn->setLinkage(llvm::GlobalValue::InternalLinkage);
+
+	auto const resolver_t = llvm::FunctionType::get(context.get_opaque_pointer_t(), false);
+	auto const resolver = llvm::Function::Create(
+		resolver_t, llvm::GlobalValue::InternalLinkage,
+		name + ".resolver", module
+	);
+	auto const ifunc = llvm::GlobalIFunc::create(
+		fn->getFunctionType(), fn->getAddressSpace(),
+		linkage, name, resolver, &module
+	);
+	// all calls to the function, including the recursive calls in the clones, go through the ifunc.
+	// this has to be done before the resolver body is emitted, which uses the default version
+	fn->replaceAllUsesWith(ifunc);
+
+	// the versions are checked in the order they were given in '@target_clones'
+	llvm::IRBuilder<> builder(context.get_llvm_context());
+	builder.SetInsertPoint(llvm::BasicBlock::Create(context.get_llvm_context(), "entry", resolver));
+	// ifunc resolvers can run before global constructors, so the CPU info has to be initialized here
+	auto cpu_init = module.getOrInsertFunction("__cpu_indicator_init", builder.getVoidTy());
+	if (auto const cpu_init_fn = llvm::dyn_cast<llvm::Function>(cpu_init.getCallee()))
+	{
+		cpu_init_fn->setDSOLocal(true);
+	}
+	builder.CreateCall(cpu_init);
+	for (auto const &clone : clones)
+	{
+		auto const is_supported = emit_cpu_supports_check(clone.feature_mask, builder, context);
+		auto const return_bb = llvm::BasicBlock::Create(context.get_llvm_context(), "return_clone", resolver);
+		auto const next_bb = llvm::BasicBlock::Create(context.get_llvm_context(), "next_clone", resolver);
+		builder.CreateCondBr(is_supported, return_bb, next_bb);
+		builder.SetInsertPoint(return_bb);
+		builder.CreateRet(clone.fn);
+		builder.SetInsertPoint(next_bb);
+	}
+	builder.CreateRet(fn);
+}
+
+void emit_target_clones_dispatch(bitcode_context &context)
+{
+	for (auto const func_body : context.functions_to_compile)
+	{
+		if (func_body->target_clones.not_empty() && func_body->is_bitcode_emitted())
+		{
+			emit_target_clones_dispatch(*func_body, context);
+		}
+	}
+}
+
 static void emit_rvalue_array_destruct(
 	ast::expression const &elem_destruct_expr,
 	val_ptr array_value,
@@ -15,6 +15,9 @@ void emit_global_variable(ast::decl_variable const &var_decl, bitcode_context &c
 void emit_global_type_symbol(ast::type_info const &info, bitcode_context &context);
 void emit_global_type(ast::type_info const &info, bitcode_context &context);
 void emit_necessary_functions(bitcode_context &context);
+// replaces the functions with '@target_clones' with an ifunc, that selects one of the
+// versions based on the features of the CPU at load time
+void emit_target_clones_dispatch(bitcode_context &context);
 
 void emit_destruct_operation(
 	ast::destruct_operation const &destruct_op,
@@ -176,6 +176,60 @@ target_properties target_triple::get_target_properties(void) const
 	return result;
 }
 
+// the features accepted by __builtin_cpu_supports in both clang and gcc, which are the ones that have
+// a bit in __cpu_model or __cpu_features2 set by __cpu_indicator_init
+static constexpr bz::array x86_cpu_supports_features = {
+	bz::u8string_view("cmov"),
+	bz::u8string_view("mmx"),
+	bz::u8string_view("popcnt"),
+	bz::u8string_view("sse"),
+	bz::u8string_view("sse2"),
+	bz::u8string_view("sse3"),
+	bz::u8string_view("ssse3"),
+	bz::u8string_view("sse4.1"),
+	bz::u8string_view("sse4.2"),
+	bz::u8string_view("avx"),
+	bz::u8string_view("avx2"),
+	bz::u8string_view("sse4a"),
+	bz::u8string_view("fma4"),
+	bz::u8string_view("xop"),
+	bz::u8string_view("fma"),
+	bz::u8string_view("avx512f"),
+	bz::u8string_view("bmi"),
+	bz::u8string_view("bmi2"),
+	bz::u8string_view("aes"),
+	bz::u8string_view("pclmul"),
+	bz::u8string_view("avx512vl"),
+	bz::u8string_view("avx512bw"),
+	bz::u8string_view("avx512dq"),
+	bz::u8string_view("avx512cd"),
+	bz::u8string_view("avx512er"),
+	bz::u8string_view("avx512pf"),
+	bz::u8string_view("avx512vbmi"),
+	bz::u8string_view("avx512ifma"),
+	bz::u8string_view("avx5124vnniw"),
+	bz::u8string_view("avx5124fmaps"),
+	bz::u8string_view("avx512vpopcntdq"),
+	bz::u8string_view("avx512vbmi2"),
+	bz::u8string_view("gfni"),
+	bz::u8string_view("vpclmulqdq"),
+	bz::u8string_view("avx512vnni"),
+	bz::u8string_view("avx512bitalg"),
+	bz::u8string_view("avx512bf16"),
+	bz::u8string_view("avx512vp2intersect"),
+};
+
+bool target_triple::is_cpu_supports_feature(bz::u8string_view feature) const
+{
+	switch (this->arch)
+	{
+	case architecture_kind::x86_64:
+		return x86_cpu_supports_features.contains(feature);
+	default:
+		return false;
+	}
+}
+
 static bz::u8string_view get_arch_string(architecture_kind arch)
 {
 	switch (arch)
@@ -54,6 +54,8 @@ struct target_triple
 	static target_triple parse(bz::u8string_view triple);
 
 	target_properties get_target_properties(void) const;
+	// whether 'feature' can be checked at run time, e.g. in the dispatcher of '@target_clones'
+	bool is_cpu_supports_feature(bz::u8string_view feature) const;
 	bz::u8string get_normalized_target(void) const;
 };
 
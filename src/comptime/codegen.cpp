@@ -1887,8 +1887,8 @@ static expr_value generate_builtin_subscript_range(
 	auto const rhs_value = generate_expr_code(rhs, context, {});
 
 	bz_assert(rhs_type.is<ast::ts_base_type>());
-	bz_assert(rhs_type.get<ast::ts_base_type>().info->type_name.values.size() == 1);
-	auto const kind = range_kind_from_name(rhs_type.get<ast::ts_base_type>().info->type_name.values[0]);
+	bz_assert(rhs_type.get<ast::ts_base_type>().info->type_name.ids.size() == 1);
+	auto const kind = range_kind_from_name(rhs_type.get<ast::ts_base_type>().info->type_name.get_value(0));
 
 	auto const is_index_signed = [&]() {
 		if (kind == range_kind::unbounded)
@@ -2192,6 +2192,425 @@ static expr_value generate_builtin_subscript_range(
 	return result_value;
 }
 
+// the vector intrinsics are evaluated one lane at a time at compile time
+
+static uint8_t get_vector_element_kind(ast::typespec_view vector_type)
+{
+	vector_type = vector_type.remove_any_mut();
+	bz_assert(vector_type.is<ast::ts_array>());
+	auto const elem_type = vector_type.get<ast::ts_array>().elem_type.as_typespec_view();
+	bz_assert(elem_type.is<ast::ts_base_type>());
+	return elem_type.get<ast::ts_base_type>().info->kind;
+}
+
+static expr_value generate_vector_lane_code(
+	uint32_t intrinsic_kind,
+	lex::src_tokens const &src_tokens,
+	expr_value lhs,
+	expr_value rhs,
+	uint8_t elem_kind,
+	codegen_context &context
+)
+{
+	auto const is_signed = ast::is_signed_integer_kind(elem_kind);
+	auto const is_float = ast::is_floating_point_kind(elem_kind);
+	switch (intrinsic_kind)
+	{
+	case ast::function_body::vector_add:
+	case ast::function_body::vector_reduce_add:
+		return context.create_add(lhs, rhs);
+	case ast::function_body::vector_sub:
+		return context.create_sub(lhs, rhs);
+	case ast::function_body::vector_mul:
+	case ast::function_body::vector_reduce_mul:
+		return context.create_mul(lhs, rhs);
+	case ast::function_body::vector_div:
+		return context.create_div(src_tokens, lhs, rhs, is_signed);
+	case ast::function_body::vector_rem:
+		return context.create_rem(src_tokens, lhs, rhs, is_signed);
+	case ast::function_body::vector_and:
+	case ast::function_body::vector_reduce_and:
+		return context.create_and(lhs, rhs);
+	case ast::function_body::vector_or:
+	case ast::function_body::vector_reduce_or:
+		return context.create_or(lhs, rhs);
+	case ast::function_body::vector_xor:
+	case ast::function_body::vector_reduce_xor:
+		return context.create_xor(lhs, rhs);
+	case ast::function_body::vector_shl:
+		return context.create_shl(src_tokens, lhs, rhs, false);
+	case ast::function_body::vector_shr:
+		return context.create_shr(src_tokens, lhs, rhs, false);
+	case ast::function_body::vector_min:
+	case ast::function_body::vector_reduce_min:
+		return context.create_min(lhs, rhs, is_signed);
+	case ast::function_body::vector_max:
+	case ast::function_body::vector_reduce_max:
+		return context.create_max(lhs, rhs, is_signed);
+	case ast::function_body::vector_eq:
+		return is_float ? context.create_float_cmp_eq(lhs, rhs) : context.create_int_cmp_eq(lhs, rhs);
+	case ast::function_body::vector_neq:
+		return is_float ? context.create_float_cmp_neq(lhs, rhs) : context.create_int_cmp_neq(lhs, rhs);
+	case ast::function_body::vector_lt:
+		return is_float ? context.create_float_cmp_lt(lhs, rhs) : context.create_int_cmp_lt(lhs, rhs, is_signed);
+	case ast::function_body::vector_gt:
+		return is_float ? context.create_float_cmp_gt(lhs, rhs) : context.create_int_cmp_gt(lhs, rhs, is_signed);
+	case ast::function_body::vector_lte:
+		return is_float ? context.create_float_cmp_lte(lhs, rhs) : context.create_int_cmp_lte(lhs, rhs, is_signed);
+	case ast::function_body::vector_gte:
+		return is_float ? context.create_float_cmp_gte(lhs, rhs) : context.create_int_cmp_gte(lhs, rhs, is_signed);
+	default:
+		bz_unreachable;
+	}
+}
+
+static expr_value generate_vector_binary_op_code(
+	ast::expr_function_call const &func_call,
+	codegen_context &context,
+	bz::optional<expr_value> result_address
+)
+{
+	bz_assert(func_call.params.size() == 2);
+	auto const lhs = generate_expr_code(func_call.params[0], context, {});
+	auto const rhs = generate_expr_code(func_call.params[1], context, {});
+	bz_assert(lhs.is_reference() && rhs.is_reference());
+	auto const elem_kind = get_vector_element_kind(func_call.params[0].get_expr_type());
+
+	if (!result_address.has_value())
+	{
+		result_address = context.create_alloca(func_call.src_tokens, get_type(func_call.func_body->return_type, context));
+	}
+	auto const &result_value = result_address.get();
+	bz_assert(result_value.get_type()->is_array());
+
+	auto const loop_info = create_loop_start(result_value.get_type()->get_array_size(), context);
+	auto const lhs_elem = context.create_array_gep(lhs, loop_info.index).get_value(context);
+	auto const rhs_elem = context.create_array_gep(rhs, loop_info.index).get_value(context);
+	auto const result_elem = generate_vector_lane_code(
+		func_call.func_body->intrinsic_kind,
+		func_call.src_tokens,
+		lhs_elem,
+		rhs_elem,
+		elem_kind,
+		context
+	);
+	context.create_store(result_elem, context.create_array_gep(result_value, loop_info.index));
+	create_loop_end(loop_info, context);
+
+	context.create_start_lifetime(result_value);
+	return result_value;
+}
+
+static expr_value generate_vector_select_code(
+	ast::expr_function_call const &func_call,
+	codegen_context &context,
+	bz::optional<expr_value> result_address
+)
+{
+	bz_assert(func_call.params.size() == 3);
+	auto const mask = generate_expr_code(func_call.params[0], context, {});
+	auto const lhs  = generate_expr_code(func_call.params[1], context, {});
+	auto const rhs  = generate_expr_code(func_call.params[2], context, {});
+	bz_assert(mask.is_reference() && lhs.is_reference() && rhs.is_reference());
+
+	if (!result_address.has_value())
+	{
+		result_address = context.create_alloca(func_call.src_tokens, get_type(func_call.func_body->return_type, context));
+	}
+	auto const &result_value = result_address.get();
+	bz_assert(result_value.get_type()->is_array());
+
+	auto const loop_info = create_loop_start(result_value.get_type()->get_array_size(), context);
+	auto const result_elem = context.create_array_gep(result_value, loop_info.index);
+	auto const mask_elem = context.create_array_gep(mask, loop_info.index).get_value(context);
+	auto const lhs_bb = context.add_basic_block();
+	auto const rhs_bb = context.add_basic_block();
+	auto const end_bb = context.add_basic_block();
+	context.create_conditional_jump(mask_elem, lhs_bb, rhs_bb);
+
+	context.set_current_basic_block(lhs_bb);
+	context.create_store(context.create_array_gep(lhs, loop_info.index).get_value(context), result_elem);
+	context.create_jump(end_bb);
+
+	context.set_current_basic_block(rhs_bb);
+	context.create_store(context.create_array_gep(rhs, loop_info.index).get_value(context), result_elem);
+	context.create_jump(end_bb);
+
+	context.set_current_basic_block(end_bb);
+	create_loop_end(loop_info, context);
+
+	context.create_start_lifetime(result_value);
+	return result_value;
+}
+
+static expr_value generate_vector_shuffle_code(
+	ast::expr_function_call const &func_call,
+	codegen_context &context,
+	bz::optional<expr_value> result_address
+)
+{
+	bz_assert(func_call.params.size() == 2);
+	auto const value = generate_expr_code(func_call.params[0], context, {});
+	auto const indices = generate_expr_code(func_call.params[1], context, {});
+	bz_assert(value.is_reference() && indices.is_reference());
+
+	if (!result_address.has_value())
+	{
+		result_address = context.create_alloca(func_call.src_tokens, get_type(func_call.func_body->return_type, context));
+	}
+	auto const &result_value = result_address.get();
+	bz_assert(result_value.get_type()->is_array());
+
+	// the indices are checked in src/ctx/parse_context.cpp, so they are always in bounds
+	auto const loop_info = create_loop_start(result_value.get_type()->get_array_size(), context);
+	auto const index = context.create_array_gep(indices, loop_info.index).get_value(context);
+	auto const elem = context.create_array_gep(value, index).get_value(context);
+	context.create_store(elem, context.create_array_gep(result_value, loop_info.index));
+	create_loop_end(loop_info, context);
+
+	context.create_start_lifetime(result_value);
+	return result_value;
+}
+
+static expr_value generate_vector_reduce_code(
+	ast::expr_function_call const &func_call,
+	codegen_context &context,
+	bz::optional<expr_value> result_address
+)
+{
+	bz_assert(func_call.params.size() == 1);
+	auto const value = generate_expr_code(func_call.params[0], context, {});
+	bz_assert(value.is_reference());
+	bz_assert(value.get_type()->is_array());
+	auto const elem_kind = get_vector_element_kind(func_call.params[0].get_expr_type());
+
+	// the lanes are combined in order, which is the same as the llvm reductions without reassociation
+	auto const result_alloca = context.create_alloca_without_lifetime(value.get_type()->get_array_element_type());
+	context.create_store(context.create_struct_gep(value, 0).get_value(context), result_alloca);
+
+	auto const loop_info = create_loop_start(value.get_type()->get_array_size() - 1, context);
+	auto const index = context.create_add(loop_info.index, context.create_const_u64(1));
+	auto const elem = context.create_array_gep(value, index).get_value(context);
+	auto const result_elem = generate_vector_lane_code(
+		func_call.func_body->intrinsic_kind,
+		func_call.src_tokens,
+		result_alloca.get_value(context),
+		elem,
+		elem_kind,
+		context
+	);
+	context.create_store(result_elem, result_alloca);
+	create_loop_end(loop_info, context);
+
+	return value_or_result_address(result_alloca.get_value(context), result_address, context);
+}
+
+static expr_value generate_vector_masked_load_code(
+	ast::expr_function_call const &func_call,
+	codegen_context &context,
+	bz::optional<expr_value> result_address
+)
+{
+	bz_assert(func_call.params.size() == 3);
+	auto const ptr = generate_expr_code(func_call.params[0], context, {}).get_value(context);
+	auto const mask = generate_expr_code(func_call.params[1], context, {});
+	auto const passthru = generate_expr_code(func_call.params[2], context, {});
+	bz_assert(mask.is_reference() && passthru.is_reference());
+
+	auto const ptr_type = func_call.params[0].get_expr_type().remove_any_mut();
+	bz_assert(ptr_type.is<ast::ts_pointer>());
+	auto const elem_typespec = ptr_type.get<ast::ts_pointer>();
+	auto const elem_type = get_type(elem_typespec, context);
+
+	if (!result_address.has_value())
+	{
+		result_address = context.create_alloca(func_call.src_tokens, get_type(func_call.func_body->return_type, context));
+	}
+	auto const &result_value = result_address.get();
+	bz_assert(result_value.get_type()->is_array());
+
+	auto const loop_info = create_loop_start(result_value.get_type()->get_array_size(), context);
+	auto const result_elem = context.create_array_gep(result_value, loop_info.index);
+	auto const mask_elem = context.create_array_gep(mask, loop_info.index).get_value(context);
+	auto const load_bb = context.add_basic_block();
+	auto const passthru_bb = context.add_basic_block();
+	auto const end_bb = context.add_basic_block();
+	context.create_conditional_jump(mask_elem, load_bb, passthru_bb);
+
+	context.set_current_basic_block(load_bb);
+	auto const elem_ptr = context.create_ptr_add(func_call.src_tokens, ptr, loop_info.index, false, elem_type, ptr_type);
+	auto const elem_ref = expr_value::get_reference(elem_ptr.get_value_as_instruction(context), elem_type);
+	context.create_memory_access_check(func_call.src_tokens, elem_ref, elem_typespec);
+	context.create_store(elem_ref.get_value(context), result_elem);
+	context.create_jump(end_bb);
+
+	context.set_current_basic_block(passthru_bb);
+	context.create_store(context.create_array_gep(passthru, loop_info.index).get_value(context), result_elem);
+	context.create_jump(end_bb);
+
+	context.set_current_basic_block(end_bb);
+	create_loop_end(loop_info, context);
+
+	context.create_start_lifetime(result_value);
+	return result_value;
+}
+
+static expr_value generate_vector_masked_store_code(
+	ast::expr_function_call const &func_call,
+	codegen_context &context
+)
+{
+	bz_assert(func_call.params.size() == 3);
+	auto const ptr = generate_expr_code(func_call.params[0], context, {}).get_value(context);
+	auto const mask = generate_expr_code(func_call.params[1], context, {});
+	auto const value = generate_expr_code(func_call.params[2], context, {});
+	bz_assert(mask.is_reference() && value.is_reference());
+	bz_assert(value.get_type()->is_array());
+
+	auto const ptr_type = func_call.params[0].get_expr_type().remove_any_mut();
+	bz_assert(ptr_type.is<ast::ts_pointer>());
+	auto const elem_typespec = ptr_type.get<ast::ts_pointer>();
+	auto const elem_type = get_type(elem_typespec, context);
+
+	auto const loop_info = create_loop_start(value.get_type()->get_array_size(), context);
+	auto const mask_elem = context.create_array_gep(mask, loop_info.index).get_value(context);
+	auto const store_bb = context.add_basic_block();
+	auto const end_bb = context.add_basic_block();
+	context.create_conditional_jump(mask_elem, store_bb, end_bb);
+
+	context.set_current_basic_block(store_bb);
+	auto const elem_ptr = context.create_ptr_add(func_call.src_tokens, ptr, loop_info.index, false, elem_type, ptr_type);
+	auto const elem_ref = expr_value::get_reference(elem_ptr.get_value_as_instruction(context), elem_type);
+	context.create_memory_access_check(func_call.src_tokens, elem_ref, elem_typespec);
+	context.create_store(context.create_array_gep(value, loop_info.index).get_value(context), elem_ref);
+	context.create_jump(end_bb);
+
+	context.set_current_basic_block(end_bb);
+	create_loop_end(loop_info, context);
+
+	return expr_value::get_none();
+}
+
+// the atomic intrinsics have single-threaded semantics at compile time, so the memory orders are ignored
+
+static expr_value get_atomic_object_reference(
+	ast::expr_function_call const &func_call,
+	expr_value ptr,
+	codegen_context &context
+)
+{
+	auto const ptr_type = func_call.params[0].get_expr_type().remove_any_mut();
+	bz_assert(ptr_type.is<ast::ts_pointer>());
+	auto const object_typespec = ptr_type.get<ast::ts_pointer>();
+	auto const object_type = get_type(object_typespec, context);
+	auto const object_ref = expr_value::get_reference(ptr.get_value_as_instruction(context), object_type);
+	context.create_memory_access_check(func_call.src_tokens, object_ref, object_typespec);
+	return object_ref;
+}
+
+static expr_value generate_atomic_rmw_op_code(
+	uint32_t intrinsic_kind,
+	expr_value old_value,
+	expr_value value,
+	codegen_context &context
+)
+{
+	switch (intrinsic_kind)
+	{
+	case ast::function_body::atomic_exchange:
+		return value;
+	case ast::function_body::atomic_fetch_add:
+		return context.create_add(old_value, value);
+	case ast::function_body::atomic_fetch_sub:
+		return context.create_sub(old_value, value);
+	case ast::function_body::atomic_fetch_and:
+		return context.create_and(old_value, value);
+	case ast::function_body::atomic_fetch_or:
+		return context.create_or(old_value, value);
+	case ast::function_body::atomic_fetch_xor:
+		return context.create_xor(old_value, value);
+	default:
+		bz_unreachable;
+	}
+}
+
+static expr_value generate_atomic_intrinsic_code(
+	ast::expr_function_call const &func_call,
+	codegen_context &context,
+	bz::optional<expr_value> result_address
+)
+{
+	switch (func_call.func_body->intrinsic_kind)
+	{
+	case ast::function_body::atomic_load:
+	{
+		bz_assert(func_call.params.size() == 2);
+		auto const ptr = generate_expr_code(func_call.params[0], context, {}).get_value(context);
+		generate_expr_code(func_call.params[1], context, {});
+		auto const object_ref = get_atomic_object_reference(func_call, ptr, context);
+		return value_or_result_address(object_ref.get_value(context), result_address, context);
+	}
+	case ast::function_body::atomic_store:
+	{
+		bz_assert(func_call.params.size() == 3);
+		auto const ptr = generate_expr_code(func_call.params[0], context, {}).get_value(context);
+		auto const value = generate_expr_code(func_call.params[1], context, {}).get_value(context);
+		generate_expr_code(func_call.params[2], context, {});
+		auto const object_ref = get_atomic_object_reference(func_call, ptr, context);
+		context.create_store(value, object_ref);
+		bz_assert(!result_address.has_value());
+		return expr_value::get_none();
+	}
+	case ast::function_body::atomic_compare_exchange:
+	{
+		bz_assert(func_call.params.size() == 5);
+		auto const ptr = generate_expr_code(func_call.params[0], context, {}).get_value(context);
+		auto const expected_ref = generate_expr_code(func_call.params[1], context, {});
+		bz_assert(expected_ref.is_reference());
+		auto const desired = generate_expr_code(func_call.params[2], context, {}).get_value(context);
+		generate_expr_code(func_call.params[3], context, {});
+		generate_expr_code(func_call.params[4], context, {});
+		auto const object_ref = get_atomic_object_reference(func_call, ptr, context);
+
+		auto const old_value = object_ref.get_value(context);
+		auto const expected = expected_ref.get_value(context);
+		auto const is_equal = old_value.get_type()->is_pointer()
+			? context.create_pointer_cmp_eq(old_value, expected)
+			: context.create_int_cmp_eq(old_value, expected);
+
+		auto const store_bb = context.add_basic_block();
+		auto const end_bb = context.add_basic_block();
+		context.create_conditional_jump(is_equal, store_bb, end_bb);
+
+		context.set_current_basic_block(store_bb);
+		context.create_store(desired, object_ref);
+		context.create_jump(end_bb);
+
+		context.set_current_basic_block(end_bb);
+		context.create_store(old_value, expected_ref);
+		return value_or_result_address(is_equal, result_address, context);
+	}
+	case ast::function_body::atomic_fence:
+		bz_assert(func_call.params.size() == 1);
+		generate_expr_code(func_call.params[0], context, {});
+		bz_assert(!result_address.has_value());
+		return expr_value::get_none();
+	default:
+	{
+		bz_assert(func_call.params.size() == 3);
+		auto const ptr = generate_expr_code(func_call.params[0], context, {}).get_value(context);
+		auto const value = generate_expr_code(func_call.params[1], context, {}).get_value(context);
+		generate_expr_code(func_call.params[2], context, {});
+		auto const object_ref = get_atomic_object_reference(func_call, ptr, context);
+
+		auto const old_value = object_ref.get_value(context);
+		auto const new_value = generate_atomic_rmw_op_code(func_call.func_body->intrinsic_kind, old_value, value, context);
+		context.create_store(new_value, object_ref);
+		return value_or_result_address(old_value, result_address, context);
+	}
+	}
+}
+
 static expr_value generate_intrinsic_function_call_code(
 	ast::expression const &original_expression,
 	ast::expr_function_call const &func_call,
@@ -2201,7 +2620,7 @@ static expr_value generate_intrinsic_function_call_code(
 {
 	switch (func_call.func_body->intrinsic_kind)
 	{
-	static_assert(ast::function_body::_builtin_last - ast::function_body::_builtin_first == 285);
+	static_assert(ast::function_body::_builtin_last - ast::function_body::_builtin_first == 325);
 	static_assert(ast::function_body::_builtin_default_constructor_last - ast::function_body::_builtin_default_constructor_first == 14);
 	static_assert(ast::function_body::_builtin_unary_operator_last - ast::function_body::_builtin_unary_operator_first == 7);
 	static_assert(ast::function_body::_builtin_binary_operator_last - ast::function_body::_builtin_binary_operator_first == 28);
@@ -2852,6 +3271,14 @@ static expr_value generate_intrinsic_function_call_code(
 		bz_unreachable;
 	case ast::function_body::builtin_is_comptime:
 		return value_or_result_address(context.create_const_i1(true), result_address, context);
+	case ast::function_body::builtin_expect:
+	{
+		// the hint is only used by the optimizer, it is ignored at compile time
+		bz_assert(func_call.params.size() == 2);
+		auto const result = generate_expr_code(func_call.params[0], context, result_address);
+		generate_expr_code(func_call.params[1], context, {});
+		return result;
+	}
 	case ast::function_body::builtin_is_option_set:
 	{
 		bz_assert(func_call.params.size() == 1);
@@ -3667,6 +4094,53 @@ static expr_value generate_intrinsic_function_call_code(
 		auto const amount = generate_expr_code(func_call.params[1], context, {}).get_value(context);
 		return value_or_result_address(context.create_ashr(original_expression.src_tokens, n, amount), result_address, context);
 	}
+	case ast::function_body::vector_add:
+	case ast::function_body::vector_sub:
+	case ast::function_body::vector_mul:
+	case ast::function_body::vector_div:
+	case ast::function_body::vector_rem:
+	case ast::function_body::vector_and:
+	case ast::function_body::vector_or:
+	case ast::function_body::vector_xor:
+	case ast::function_body::vector_shl:
+	case ast::function_body::vector_shr:
+	case ast::function_body::vector_min:
+	case ast::function_body::vector_max:
+	case ast::function_body::vector_eq:
+	case ast::function_body::vector_neq:
+	case ast::function_body::vector_lt:
+	case ast::function_body::vector_gt:
+	case ast::function_body::vector_lte:
+	case ast::function_body::vector_gte:
+		return generate_vector_binary_op_code(func_call, context, result_address);
+	case ast::function_body::vector_select:
+		return generate_vector_select_code(func_call, context, result_address);
+	case ast::function_body::vector_shuffle:
+		return generate_vector_shuffle_code(func_call, context, result_address);
+	case ast::function_body::vector_reduce_add:
+	case ast::function_body::vector_reduce_mul:
+	case ast::function_body::vector_reduce_min:
+	case ast::function_body::vector_reduce_max:
+	case ast::function_body::vector_reduce_and:
+	case ast::function_body::vector_reduce_or:
+	case ast::function_body::vector_reduce_xor:
+		return generate_vector_reduce_code(func_call, context, result_address);
+	case ast::function_body::vector_masked_load:
+		return generate_vector_masked_load_code(func_call, context, result_address);
+	case ast::function_body::vector_masked_store:
+		bz_assert(!result_address.has_value());
+		return generate_vector_masked_store_code(func_call, context);
+	case ast::function_body::atomic_load:
+	case ast::function_body::atomic_store:
+	case ast::function_body::atomic_exchange:
+	case ast::function_body::atomic_compare_exchange:
+	case ast::function_body::atomic_fetch_add:
+	case ast::function_body::atomic_fetch_sub:
+	case ast::function_body::atomic_fetch_and:
+	case ast::function_body::atomic_fetch_or:
+	case ast::function_body::atomic_fetch_xor:
+	case ast::function_body::atomic_fence:
+		return generate_atomic_intrinsic_code(func_call, context, result_address);
 	case ast::function_body::i8_default_constructor:
 	case ast::function_body::i16_default_constructor:
 	case ast::function_body::i32_default_constructor:
@@ -5615,7 +6089,7 @@ static expr_value generate_expr_code(
 	{
 		context.create_error(
 			lex::src_tokens::from_single_token(type_member_access.member),
-			bz::format("member '{}' cannot be used in a constant expression", type_member_access.member->value)
+			bz::format("member '{}' cannot be used in a constant expression", type_member_access.member->get_value())
 		);
 		auto const type = get_type(type_member_access.var_decl->get_type(), context);
 		return context.get_dummy_value(type);
@@ -1,5 +1,6 @@
 #include "codegen_context.h"
 #include "codegen.h"
+#include "execute.h"
 #include "ast/statement.h"
 #include "global_data.h"
 #include "resolve/statement_resolver.h"
@@ -23,6 +24,128 @@ static constexpr memory::global_segment_info_t segment_info_32_bit = {
 	0xff00'0000,
 };
 
+static bool is_bitwise_equal(ast::constant_value const &lhs, ast::constant_value const &rhs);
+
+// floating point values are compared bitwise, so e.g. -0.0 and 0.0 are considered different arguments,
+// ast::constant_value_hash can still be used with this, because bitwise equal values always have the same hash
+template<typename T>
+static bool is_bitwise_equal_array(bz::array_view<T const> lhs, bz::array_view<T const> rhs)
+{
+	if (lhs.size() != rhs.size())
+	{
+		return false;
+	}
+
+	for (auto const &[lhs_value, rhs_value] : bz::zip(lhs, rhs))
+	{
+		if constexpr (bz::meta::is_same<T, ast::constant_value>)
+		{
+			if (!is_bitwise_equal(lhs_value, rhs_value))
+			{
+				return false;
+			}
+		}
+		else if constexpr (bz::meta::is_same<T, float32_t>)
+		{
+			if (bit_cast<uint32_t>(lhs_value) != bit_cast<uint32_t>(rhs_value))
+			{
+				return false;
+			}
+		}
+		else if constexpr (bz::meta::is_same<T, float64_t>)
+		{
+			if (bit_cast<uint64_t>(lhs_value) != bit_cast<uint64_t>(rhs_value))
+			{
+				return false;
+			}
+		}
+		else
+		{
+			if (lhs_value != rhs_value)
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+static bool is_bitwise_equal(ast::constant_value const &lhs, ast::constant_value const &rhs)
+{
+	if (lhs.kind() != rhs.kind())
+	{
+		return false;
+	}
+
+	switch (lhs.kind())
+	{
+	case ast::constant_value_kind::float32:
+		return bit_cast<uint32_t>(lhs.get_float32()) == bit_cast<uint32_t>(rhs.get_float32());
+	case ast::constant_value_kind::float64:
+		return bit_cast<uint64_t>(lhs.get_float64()) == bit_cast<uint64_t>(rhs.get_float64());
+	case ast::constant_value_kind::array:
+		return is_bitwise_equal_array(lhs.get_array(), rhs.get_array());
+	case ast::constant_value_kind::float32_array:
+		return is_bitwise_equal_array(lhs.get_float32_array(), rhs.get_float32_array());
+	case ast::constant_value_kind::float64_array:
+		return is_bitwise_equal_array(lhs.get_float64_array(), rhs.get_float64_array());
+	case ast::constant_value_kind::tuple:
+		return is_bitwise_equal_array(lhs.get_tuple(), rhs.get_tuple());
+	case ast::constant_value_kind::aggregate:
+		return is_bitwise_equal_array(lhs.get_aggregate(), rhs.get_aggregate());
+	default:
+		return lhs == rhs;
+	}
+}
+
+size_t consteval_call_key_hash::operator () (consteval_call_key_t const &key) const
+{
+	auto result = std::hash<void const *>()(key.func_body);
+	for (auto const &arg : key.args)
+	{
+		result = hash_combine(result, ast::constant_value_hash()(arg));
+	}
+	return result;
+}
+
+bool consteval_call_key_equal_to::operator () (consteval_call_key_t const &lhs, consteval_call_key_t const &rhs) const
+{
+	return lhs.func_body == rhs.func_body
+		&& is_bitwise_equal_array(lhs.args.as_array_view(), rhs.args.as_array_view());
+}
+
+bz::optional<consteval_call_key_t> get_consteval_call_key(ast::expression const &expr)
+{
+	if (!expr.is_dynamic())
+	{
+		return {};
+	}
+
+	auto const &dyn_expr = expr.get_dynamic();
+	if (!dyn_expr.expr.is<ast::expr_function_call>())
+	{
+		return {};
+	}
+
+	auto const &func_call = dyn_expr.expr.get<ast::expr_function_call>();
+	if (func_call.func_body == nullptr || func_call.func_body->is_intrinsic())
+	{
+		return {};
+	}
+
+	consteval_call_key_t result = { func_call.func_body, {} };
+	result.args.reserve(func_call.params.size());
+	for (auto const &param : func_call.params)
+	{
+		if (!param.is_constant())
+		{
+			return {};
+		}
+		result.args.push_back(param.get_constant_value());
+	}
+	return result;
+}
+
 static basic_block &get_current_block(codegen_context &context)
 {
 	return context.current_function_info.blocks[context.current_function_info.current_bb.bb_index];
@@ -371,6 +494,27 @@ ptr_t codegen_context::add_function_pointer(function *func)
 	return ptr;
 }
 
+ast::constant_value const *codegen_context::get_consteval_call_result(consteval_call_key_t const &key)
+{
+	auto const it = this->consteval_call_results.find(key);
+	if (it == this->consteval_call_results.end())
+	{
+		global_data::consteval_call_cache_miss_count += 1;
+		return nullptr;
+	}
+	else
+	{
+		global_data::consteval_call_cache_hit_count += 1;
+		return &it->second;
+	}
+}
+
+void codegen_context::add_consteval_call_result(consteval_call_key_t key, ast::constant_value result)
+{
+	bz_assert(result.not_null());
+	this->consteval_call_results.insert({ std::move(key), std::move(result) });
+}
+
 type const *codegen_context::get_builtin_type(builtin_type_kind kind)
 {
 	return this->type_set.get_builtin_type(kind);
@@ -6792,6 +6936,8 @@ void current_function_info_t::finalize_function(void)
 		bz_assert(it == func.instructions.end());
 	}
 
+	decode_instructions(func);
+
 #ifdef BOZON_PROFILE_COMPTIME
 	global_data::comptime_emitted_instructions_count += func.instructions.size();
 #endif // BOZON_PROFILE_COMPTIME
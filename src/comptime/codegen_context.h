@@ -194,6 +194,25 @@ struct typename_result_info_t
 	ast::typespec_view type;
 };
 
+// key of a compile time function call, where all of the arguments are constants
+struct consteval_call_key_t
+{
+	ast::function_body const *func_body;
+	bz::vector<ast::constant_value> args;
+};
+
+struct consteval_call_key_hash
+{
+	size_t operator () (consteval_call_key_t const &key) const;
+};
+
+struct consteval_call_key_equal_to
+{
+	bool operator () (consteval_call_key_t const &lhs, consteval_call_key_t const &rhs) const;
+};
+
+bz::optional<consteval_call_key_t> get_consteval_call_key(ast::expression const &expr);
+
 struct codegen_context
 {
 	current_function_info_t current_function_info{};
@@ -208,6 +227,13 @@ struct codegen_context
 	std::unordered_map<ast::decl_variable const *, uint32_t> global_variables{};
 	std::unordered_map<ast::function_body *, std::unique_ptr<function>> functions{};
 	std::unordered_map<function *, ptr_t> function_pointers{};
+	// results of compile time function calls that had no side effects, so they can be reused
+	std::unordered_map<
+		consteval_call_key_t,
+		ast::constant_value,
+		consteval_call_key_hash,
+		consteval_call_key_equal_to
+	> consteval_call_results{};
 
 	struct loop_info_t
 	{
@@ -243,6 +269,8 @@ struct codegen_context
 	bz::optional<uint32_t> get_global_variable(ast::decl_variable const *decl);
 	function *get_function(ast::function_body *body);
 	ptr_t add_function_pointer(function *func);
+	ast::constant_value const *get_consteval_call_result(consteval_call_key_t const &key);
+	void add_consteval_call_result(consteval_call_key_t key, ast::constant_value result);
 
 	type const *get_builtin_type(builtin_type_kind kind);
 	type const *get_pointer_type(void);
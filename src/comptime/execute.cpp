@@ -1,9 +1,14 @@
-#include "instructions.h"
-#include "executor_context.h"
+#include "execute.h"
 #include "overflow_operations.h"
+#include "global_data.h"
 #include "ast/statement.h"
 #include <bit>
 
+// labels as values are a GNU extension, which is supported by both GCC and Clang
+#ifdef __GNUC__
+#define BOZON_COMPTIME_COMPUTED_GOTO
+#endif // __GNUC__
+
 namespace comptime
 {
 
@@ -4268,6 +4273,7 @@ static void execute_print(instructions::print const &, ptr_t begin, ptr_t end, e
 	auto const end_ptr = context.get_memory(end);
 	auto const message = bz::u8string_view(begin_ptr, end_ptr);
 	bz::print(stdout, "{}", message);
+	context.is_result_reusable = false;
 }
 
 static bool execute_is_option_set(instructions::is_option_set const &, ptr_t begin, ptr_t end, executor_context &context)
@@ -4787,7 +4793,7 @@ static get_value_type_t<type> &get_value_ref(instruction_value &value)
 
 
 template<typename Inst, auto execute_func>
-static void execute(executor_context &context)
+[[gnu::always_inline]] static inline void execute(executor_context &context)
 {
 	auto const &inst = *context.current_instruction;
 	instruction_value result;
@@ -6382,4 +6388,684 @@ void execute_current_instruction(executor_context &context)
 	}
 }
 
+#ifndef NDEBUG
+static void print_current_instruction(executor_context const &context)
+{
+	bz::log(
+		">>> %{} in '{}'\n",
+		context.current_instruction_value - context.instruction_values.data(),
+		context.current_function->func_body != nullptr ? context.current_function->func_body->get_signature() : "anon-function"
+	);
+}
+#endif // !NDEBUG
+
+// returns false if execution has finished
+[[gnu::always_inline]] static inline bool start_current_instruction(executor_context &context)
+{
+	if (context.returned || context.has_error)
+	{
+		return false;
+	}
+
+#ifndef NDEBUG
+	if (global_data::debug_comptime_print_instructions)
+	{
+		print_current_instruction(context);
+	}
+#endif // !NDEBUG
+
+#ifdef BOZON_PROFILE_COMPTIME
+	global_data::comptime_executed_instructions_count += 1;
+	instruction_counts[context.current_instruction->index()] += 1;
+#endif // BOZON_PROFILE_COMPTIME
+
+	return true;
+}
+
+// moves on to the next instruction after the current one was executed, returns false if execution has finished
+[[gnu::always_inline]] static inline bool advance_to_next_instruction(executor_context &context)
+{
+	if (context.next_instruction == nullptr && !context.returned && !context.has_error)
+	{
+		// fast path for sequential execution, which is the most common case
+		bz_assert(!context.current_instruction->is_terminator());
+		context.current_instruction += 1;
+		context.current_instruction_value += 1;
+	}
+	else
+	{
+		context.advance();
+	}
+	return start_current_instruction(context);
+}
+
+#ifdef BOZON_COMPTIME_COMPUTED_GOTO
+
+[[gnu::always_inline]] static inline void *get_current_instruction_handler(executor_context const &context)
+{
+	auto const instruction_index = context.current_instruction - context.instructions.data();
+	bz_assert(context.current_function->instruction_handlers.size() == context.instructions.size());
+	return context.current_function->instruction_handlers[instruction_index];
+}
+
+// every instruction in index order, this is used to generate both the labels and the table of their addresses
+#define threaded_instruction_list(x) \
+	x(const_i1) \
+	x(const_i8) \
+	x(const_i16) \
+	x(const_i32) \
+	x(const_i64) \
+	x(const_u8) \
+	x(const_u16) \
+	x(const_u32) \
+	x(const_u64) \
+	x(const_f32) \
+	x(const_f64) \
+	x(const_ptr_null) \
+	x(const_func_ptr) \
+	x(get_global_address) \
+	x(get_function_arg) \
+	x(load_i1_be) \
+	x(load_i8_be) \
+	x(load_i16_be) \
+	x(load_i32_be) \
+	x(load_i64_be) \
+	x(load_f32_be) \
+	x(load_f64_be) \
+	x(load_ptr32_be) \
+	x(load_ptr64_be) \
+	x(load_i1_le) \
+	x(load_i8_le) \
+	x(load_i16_le) \
+	x(load_i32_le) \
+	x(load_i64_le) \
+	x(load_f32_le) \
+	x(load_f64_le) \
+	x(load_ptr32_le) \
+	x(load_ptr64_le) \
+	x(store_i1_be) \
+	x(store_i8_be) \
+	x(store_i16_be) \
+	x(store_i32_be) \
+	x(store_i64_be) \
+	x(store_f32_be) \
+	x(store_f64_be) \
+	x(store_ptr32_be) \
+	x(store_ptr64_be) \
+	x(store_i1_le) \
+	x(store_i8_le) \
+	x(store_i16_le) \
+	x(store_i32_le) \
+	x(store_i64_le) \
+	x(store_f32_le) \
+	x(store_f64_le) \
+	x(store_ptr32_le) \
+	x(store_ptr64_le) \
+	x(check_dereference) \
+	x(check_inplace_construct) \
+	x(check_destruct_value) \
+	x(cast_zext_i1_to_i8) \
+	x(cast_zext_i1_to_i16) \
+	x(cast_zext_i1_to_i32) \
+	x(cast_zext_i1_to_i64) \
+	x(cast_zext_i8_to_i16) \
+	x(cast_zext_i8_to_i32) \
+	x(cast_zext_i8_to_i64) \
+	x(cast_zext_i16_to_i32) \
+	x(cast_zext_i16_to_i64) \
+	x(cast_zext_i32_to_i64) \
+	x(cast_sext_i8_to_i16) \
+	x(cast_sext_i8_to_i32) \
+	x(cast_sext_i8_to_i64) \
+	x(cast_sext_i16_to_i32) \
+	x(cast_sext_i16_to_i64) \
+	x(cast_sext_i32_to_i64) \
+	x(cast_trunc_i64_to_i8) \
+	x(cast_trunc_i64_to_i16) \
+	x(cast_trunc_i64_to_i32) \
+	x(cast_trunc_i32_to_i8) \
+	x(cast_trunc_i32_to_i16) \
+	x(cast_trunc_i16_to_i8) \
+	x(cast_f32_to_f64) \
+	x(cast_f64_to_f32) \
+	x(cast_f32_to_i8) \
+	x(cast_f32_to_i16) \
+	x(cast_f32_to_i32) \
+	x(cast_f32_to_i64) \
+	x(cast_f32_to_u8) \
+	x(cast_f32_to_u16) \
+	x(cast_f32_to_u32) \
+	x(cast_f32_to_u64) \
+	x(cast_f64_to_i8) \
+	x(cast_f64_to_i16) \
+	x(cast_f64_to_i32) \
+	x(cast_f64_to_i64) \
+	x(cast_f64_to_u8) \
+	x(cast_f64_to_u16) \
+	x(cast_f64_to_u32) \
+	x(cast_f64_to_u64) \
+	x(cast_i8_to_f32) \
+	x(cast_i16_to_f32) \
+	x(cast_i32_to_f32) \
+	x(cast_i64_to_f32) \
+	x(cast_u8_to_f32) \
+	x(cast_u16_to_f32) \
+	x(cast_u32_to_f32) \
+	x(cast_u64_to_f32) \
+	x(cast_i8_to_f64) \
+	x(cast_i16_to_f64) \
+	x(cast_i32_to_f64) \
+	x(cast_i64_to_f64) \
+	x(cast_u8_to_f64) \
+	x(cast_u16_to_f64) \
+	x(cast_u32_to_f64) \
+	x(cast_u64_to_f64) \
+	x(cmp_i1) \
+	x(cmp_i8) \
+	x(cmp_i16) \
+	x(cmp_i32) \
+	x(cmp_i64) \
+	x(cmp_f32) \
+	x(cmp_f64) \
+	x(cmp_f32_check) \
+	x(cmp_f64_check) \
+	x(cmp_ptr) \
+	x(neg_i8) \
+	x(neg_i16) \
+	x(neg_i32) \
+	x(neg_i64) \
+	x(neg_f32) \
+	x(neg_f64) \
+	x(neg_i8_check) \
+	x(neg_i16_check) \
+	x(neg_i32_check) \
+	x(neg_i64_check) \
+	x(add_i8) \
+	x(add_i16) \
+	x(add_i32) \
+	x(add_i64) \
+	x(add_f32) \
+	x(add_f64) \
+	x(add_ptr_i32) \
+	x(add_ptr_u32) \
+	x(add_ptr_i64) \
+	x(add_ptr_u64) \
+	x(add_ptr_const_unchecked) \
+	x(add_i8_check) \
+	x(add_i16_check) \
+	x(add_i32_check) \
+	x(add_i64_check) \
+	x(add_u8_check) \
+	x(add_u16_check) \
+	x(add_u32_check) \
+	x(add_u64_check) \
+	x(add_f32_check) \
+	x(add_f64_check) \
+	x(sub_i8) \
+	x(sub_i16) \
+	x(sub_i32) \
+	x(sub_i64) \
+	x(sub_f32) \
+	x(sub_f64) \
+	x(sub_ptr_i32) \
+	x(sub_ptr_u32) \
+	x(sub_ptr_i64) \
+	x(sub_ptr_u64) \
+	x(sub_i8_check) \
+	x(sub_i16_check) \
+	x(sub_i32_check) \
+	x(sub_i64_check) \
+	x(sub_u8_check) \
+	x(sub_u16_check) \
+	x(sub_u32_check) \
+	x(sub_u64_check) \
+	x(sub_f32_check) \
+	x(sub_f64_check) \
+	x(ptr32_diff) \
+	x(ptr64_diff) \
+	x(ptr32_diff_unchecked) \
+	x(ptr64_diff_unchecked) \
+	x(mul_i8) \
+	x(mul_i16) \
+	x(mul_i32) \
+	x(mul_i64) \
+	x(mul_f32) \
+	x(mul_f64) \
+	x(mul_i8_check) \
+	x(mul_i16_check) \
+	x(mul_i32_check) \
+	x(mul_i64_check) \
+	x(mul_u8_check) \
+	x(mul_u16_check) \
+	x(mul_u32_check) \
+	x(mul_u64_check) \
+	x(mul_f32_check) \
+	x(mul_f64_check) \
+	x(div_i8) \
+	x(div_i16) \
+	x(div_i32) \
+	x(div_i64) \
+	x(div_u8) \
+	x(div_u16) \
+	x(div_u32) \
+	x(div_u64) \
+	x(div_f32) \
+	x(div_f64) \
+	x(div_i8_check) \
+	x(div_i16_check) \
+	x(div_i32_check) \
+	x(div_i64_check) \
+	x(div_f32_check) \
+	x(div_f64_check) \
+	x(rem_i8) \
+	x(rem_i16) \
+	x(rem_i32) \
+	x(rem_i64) \
+	x(rem_u8) \
+	x(rem_u16) \
+	x(rem_u32) \
+	x(rem_u64) \
+	x(not_i1) \
+	x(not_i8) \
+	x(not_i16) \
+	x(not_i32) \
+	x(not_i64) \
+	x(and_i1) \
+	x(and_i8) \
+	x(and_i16) \
+	x(and_i32) \
+	x(and_i64) \
+	x(xor_i1) \
+	x(xor_i8) \
+	x(xor_i16) \
+	x(xor_i32) \
+	x(xor_i64) \
+	x(or_i1) \
+	x(or_i8) \
+	x(or_i16) \
+	x(or_i32) \
+	x(or_i64) \
+	x(shl_i8_signed) \
+	x(shl_i16_signed) \
+	x(shl_i32_signed) \
+	x(shl_i64_signed) \
+	x(shl_i8_unsigned) \
+	x(shl_i16_unsigned) \
+	x(shl_i32_unsigned) \
+	x(shl_i64_unsigned) \
+	x(shr_i8_signed) \
+	x(shr_i16_signed) \
+	x(shr_i32_signed) \
+	x(shr_i64_signed) \
+	x(shr_i8_unsigned) \
+	x(shr_i16_unsigned) \
+	x(shr_i32_unsigned) \
+	x(shr_i64_unsigned) \
+	x(isnan_f32) \
+	x(isnan_f64) \
+	x(isinf_f32) \
+	x(isinf_f64) \
+	x(isfinite_f32) \
+	x(isfinite_f64) \
+	x(isnormal_f32) \
+	x(isnormal_f64) \
+	x(issubnormal_f32) \
+	x(issubnormal_f64) \
+	x(iszero_f32) \
+	x(iszero_f64) \
+	x(nextafter_f32) \
+	x(nextafter_f64) \
+	x(abs_i8) \
+	x(abs_i16) \
+	x(abs_i32) \
+	x(abs_i64) \
+	x(abs_f32) \
+	x(abs_f64) \
+	x(abs_i8_check) \
+	x(abs_i16_check) \
+	x(abs_i32_check) \
+	x(abs_i64_check) \
+	x(abs_f32_check) \
+	x(abs_f64_check) \
+	x(min_i8) \
+	x(min_i16) \
+	x(min_i32) \
+	x(min_i64) \
+	x(min_u8) \
+	x(min_u16) \
+	x(min_u32) \
+	x(min_u64) \
+	x(min_f32) \
+	x(min_f64) \
+	x(min_f32_check) \
+	x(min_f64_check) \
+	x(max_i8) \
+	x(max_i16) \
+	x(max_i32) \
+	x(max_i64) \
+	x(max_u8) \
+	x(max_u16) \
+	x(max_u32) \
+	x(max_u64) \
+	x(max_f32) \
+	x(max_f64) \
+	x(max_f32_check) \
+	x(max_f64_check) \
+	x(exp_f32) \
+	x(exp_f64) \
+	x(exp_f32_check) \
+	x(exp_f64_check) \
+	x(exp2_f32) \
+	x(exp2_f64) \
+	x(exp2_f32_check) \
+	x(exp2_f64_check) \
+	x(expm1_f32) \
+	x(expm1_f64) \
+	x(expm1_f32_check) \
+	x(expm1_f64_check) \
+	x(log_f32) \
+	x(log_f64) \
+	x(log_f32_check) \
+	x(log_f64_check) \
+	x(log10_f32) \
+	x(log10_f64) \
+	x(log10_f32_check) \
+	x(log10_f64_check) \
+	x(log2_f32) \
+	x(log2_f64) \
+	x(log2_f32_check) \
+	x(log2_f64_check) \
+	x(log1p_f32) \
+	x(log1p_f64) \
+	x(log1p_f32_check) \
+	x(log1p_f64_check) \
+	x(sqrt_f32) \
+	x(sqrt_f64) \
+	x(sqrt_f32_check) \
+	x(sqrt_f64_check) \
+	x(pow_f32) \
+	x(pow_f64) \
+	x(pow_f32_check) \
+	x(pow_f64_check) \
+	x(cbrt_f32) \
+	x(cbrt_f64) \
+	x(cbrt_f32_check) \
+	x(cbrt_f64_check) \
+	x(hypot_f32) \
+	x(hypot_f64) \
+	x(hypot_f32_check) \
+	x(hypot_f64_check) \
+	x(sin_f32) \
+	x(sin_f64) \
+	x(sin_f32_check) \
+	x(sin_f64_check) \
+	x(cos_f32) \
+	x(cos_f64) \
+	x(cos_f32_check) \
+	x(cos_f64_check) \
+	x(tan_f32) \
+	x(tan_f64) \
+	x(tan_f32_check) \
+	x(tan_f64_check) \
+	x(asin_f32) \
+	x(asin_f64) \
+	x(asin_f32_check) \
+	x(asin_f64_check) \
+	x(acos_f32) \
+	x(acos_f64) \
+	x(acos_f32_check) \
+	x(acos_f64_check) \
+	x(atan_f32) \
+	x(atan_f64) \
+	x(atan_f32_check) \
+	x(atan_f64_check) \
+	x(atan2_f32) \
+	x(atan2_f64) \
+	x(atan2_f32_check) \
+	x(atan2_f64_check) \
+	x(sinh_f32) \
+	x(sinh_f64) \
+	x(sinh_f32_check) \
+	x(sinh_f64_check) \
+	x(cosh_f32) \
+	x(cosh_f64) \
+	x(cosh_f32_check) \
+	x(cosh_f64_check) \
+	x(tanh_f32) \
+	x(tanh_f64) \
+	x(tanh_f32_check) \
+	x(tanh_f64_check) \
+	x(asinh_f32) \
+	x(asinh_f64) \
+	x(asinh_f32_check) \
+	x(asinh_f64_check) \
+	x(acosh_f32) \
+	x(acosh_f64) \
+	x(acosh_f32_check) \
+	x(acosh_f64_check) \
+	x(atanh_f32) \
+	x(atanh_f64) \
+	x(atanh_f32_check) \
+	x(atanh_f64_check) \
+	x(erf_f32) \
+	x(erf_f64) \
+	x(erf_f32_check) \
+	x(erf_f64_check) \
+	x(erfc_f32) \
+	x(erfc_f64) \
+	x(erfc_f32_check) \
+	x(erfc_f64_check) \
+	x(tgamma_f32) \
+	x(tgamma_f64) \
+	x(tgamma_f32_check) \
+	x(tgamma_f64_check) \
+	x(lgamma_f32) \
+	x(lgamma_f64) \
+	x(lgamma_f32_check) \
+	x(lgamma_f64_check) \
+	x(bitreverse_u8) \
+	x(bitreverse_u16) \
+	x(bitreverse_u32) \
+	x(bitreverse_u64) \
+	x(popcount_u8) \
+	x(popcount_u16) \
+	x(popcount_u32) \
+	x(popcount_u64) \
+	x(byteswap_u16) \
+	x(byteswap_u32) \
+	x(byteswap_u64) \
+	x(clz_u8) \
+	x(clz_u16) \
+	x(clz_u32) \
+	x(clz_u64) \
+	x(ctz_u8) \
+	x(ctz_u16) \
+	x(ctz_u32) \
+	x(ctz_u64) \
+	x(fshl_u8) \
+	x(fshl_u16) \
+	x(fshl_u32) \
+	x(fshl_u64) \
+	x(fshr_u8) \
+	x(fshr_u16) \
+	x(fshr_u32) \
+	x(fshr_u64) \
+	x(ashr_u8) \
+	x(ashr_u16) \
+	x(ashr_u32) \
+	x(ashr_u64) \
+	x(const_gep) \
+	x(array_gep_i32) \
+	x(array_gep_i64) \
+	x(const_memcpy) \
+	x(const_memset_zero) \
+	x(copy_values) \
+	x(copy_overlapping_values) \
+	x(relocate_values) \
+	x(set_values_i1_be) \
+	x(set_values_i8_be) \
+	x(set_values_i16_be) \
+	x(set_values_i32_be) \
+	x(set_values_i64_be) \
+	x(set_values_f32_be) \
+	x(set_values_f64_be) \
+	x(set_values_ptr32_be) \
+	x(set_values_ptr64_be) \
+	x(set_values_i1_le) \
+	x(set_values_i8_le) \
+	x(set_values_i16_le) \
+	x(set_values_i32_le) \
+	x(set_values_i64_le) \
+	x(set_values_f32_le) \
+	x(set_values_f64_le) \
+	x(set_values_ptr32_le) \
+	x(set_values_ptr64_le) \
+	x(set_values_ref) \
+	x(function_call) \
+	x(indirect_function_call) \
+	x(malloc) \
+	x(free) \
+	x(jump) \
+	x(conditional_jump) \
+	x(switch_i1) \
+	x(switch_i8) \
+	x(switch_i16) \
+	x(switch_i32) \
+	x(switch_i64) \
+	x(switch_str) \
+	x(ret) \
+	x(ret_void) \
+	x(unreachable) \
+	x(error) \
+	x(diagnostic_str) \
+	x(print) \
+	x(is_option_set) \
+	x(add_global_array_data) \
+	x(range_bounds_check_i64) \
+	x(range_bounds_check_u64) \
+	x(array_bounds_check_i32) \
+	x(array_bounds_check_u32) \
+	x(array_bounds_check_i64) \
+	x(array_bounds_check_u64) \
+	x(array_range_bounds_check_i32) \
+	x(array_range_bounds_check_u32) \
+	x(array_range_bounds_check_i64) \
+	x(array_range_bounds_check_u64) \
+	x(array_range_begin_bounds_check_i32) \
+	x(array_range_begin_bounds_check_u32) \
+	x(array_range_begin_bounds_check_i64) \
+	x(array_range_begin_bounds_check_u64) \
+	x(array_range_end_bounds_check_i32) \
+	x(array_range_end_bounds_check_u32) \
+	x(array_range_end_bounds_check_i64) \
+	x(array_range_end_bounds_check_u64) \
+	x(optional_get_value_check) \
+	x(str_construction_check) \
+	x(slice_construction_check) \
+	x(start_lifetime) \
+	x(end_lifetime)
+
+#define threaded_instruction_index(inst_name) instruction::inst_name,
+static constexpr uint64_t threaded_instruction_indices[] = {
+	threaded_instruction_list(threaded_instruction_index)
+};
+#undef threaded_instruction_index
+
+static_assert(std::size(threaded_instruction_indices) == instruction_list_t::size());
+static_assert(instruction_list_t::size() == 514);
+// the position of every label in the table is checked here, index 0 is the invalid instruction
+static_assert([]() {
+	for (size_t i = 0; i < std::size(threaded_instruction_indices); ++i)
+	{
+		if (threaded_instruction_indices[i] != i + 1)
+		{
+			return false;
+		}
+	}
+	return true;
+}());
+
+// Every instruction kind has its own label here, and the handler at the end of each of them jumps
+// directly to the next instruction's label, which is looked up from 'function::instruction_handlers'.
+// If 'context' is null, the table of label addresses is returned, which is used by 'decode_instructions'.
+static void *const *execute_instructions_threaded(executor_context *context)
+{
+#define threaded_label_address(inst_name) &&inst_name ## _label,
+	static void *const handlers[] = {
+		&&invalid_instruction_label,
+		threaded_instruction_list(threaded_label_address)
+	};
+#undef threaded_label_address
+	static_assert(std::size(handlers) == instruction_list_t::size() + 1);
+
+	if (context == nullptr)
+	{
+		return handlers;
+	}
+
+	goto *get_current_instruction_handler(*context);
+
+#define threaded_case(inst_name)                                                \
+inst_name ## _label:                                                            \
+	bz_assert(context->current_instruction->index() == instruction::inst_name);  \
+	execute<instructions::inst_name, &execute_ ## inst_name>(*context);         \
+	if (!advance_to_next_instruction(*context))                                 \
+	{                                                                           \
+		return nullptr;                                                         \
+	}                                                                           \
+	goto *get_current_instruction_handler(*context);
+
+	threaded_instruction_list(threaded_case)
+
+#undef threaded_case
+
+invalid_instruction_label:
+	bz_unreachable;
+}
+
+#undef threaded_instruction_list
+
+static bool use_threaded_dispatch(void)
+{
+#ifdef BOZON_PROFILE_COMPTIME
+	// '--debug-comptime-switch-dispatch' can be used to compare the two dispatch methods
+	return !global_data::debug_comptime_switch_dispatch;
+#else
+	return true;
+#endif // BOZON_PROFILE_COMPTIME
+}
+
+#endif // BOZON_COMPTIME_COMPUTED_GOTO
+
+void decode_instructions(function &func)
+{
+#ifdef BOZON_COMPTIME_COMPUTED_GOTO
+	auto const handlers = execute_instructions_threaded(nullptr);
+	func.instruction_handlers = bz::fixed_vector<void *>(
+		func.instructions.transform([handlers](auto const &inst) { return handlers[inst.index()]; })
+	);
+#endif // BOZON_COMPTIME_COMPUTED_GOTO
+}
+
+void execute_instructions(executor_context &context)
+{
+	if (!start_current_instruction(context))
+	{
+		return;
+	}
+
+#ifdef BOZON_COMPTIME_COMPUTED_GOTO
+	if (use_threaded_dispatch())
+	{
+		execute_instructions_threaded(&context);
+		return;
+	}
+#endif // BOZON_COMPTIME_COMPUTED_GOTO
+
+	do
+	{
+		execute_current_instruction(context);
+	} while (advance_to_next_instruction(context));
+}
+
 } // namespace comptime
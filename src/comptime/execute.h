@@ -8,6 +8,8 @@ namespace comptime
 {
 
 void execute_current_instruction(executor_context &context);
+void execute_instructions(executor_context &context);
+void decode_instructions(function &func);
 
 } // namespace comptime
 
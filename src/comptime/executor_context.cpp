@@ -7,6 +7,10 @@
 #include "ast/statement.h"
 #include "resolve/consteval.h"
 
+#ifdef BOZON_PROFILE_COMPTIME
+#include "timer.h"
+#endif // BOZON_PROFILE_COMPTIME
+
 namespace comptime
 {
 
@@ -16,12 +20,12 @@ static ctx::source_highlight make_source_highlight(
 )
 {
 	return ctx::source_highlight{
-		.file_id = src_tokens.pivot->src_pos.file_id,
-		.line = src_tokens.pivot->src_pos.line,
+		.file_id = src_tokens.pivot->get_file_id(),
+		.line = src_tokens.pivot->get_line(),
 
-		.src_begin = src_tokens.begin->src_pos.begin,
-		.src_pivot = src_tokens.pivot->src_pos.begin,
-		.src_end = (src_tokens.end - 1)->src_pos.end,
+		.src_begin = src_tokens.begin->get_begin(),
+		.src_pivot = src_tokens.pivot->get_begin(),
+		.src_end = (src_tokens.end - 1)->get_end(),
 
 		.first_suggestion = ctx::suggestion_range{},
 		.second_suggestion = ctx::suggestion_range{},
@@ -56,16 +60,6 @@ uint8_t *executor_context::get_memory(ptr_t address)
 	return this->memory.get_memory(address);
 }
 
-void executor_context::set_current_instruction_value(instruction_value value)
-{
-	*this->current_instruction_value = value;
-}
-
-instruction_value executor_context::get_instruction_value(instruction_value_index index)
-{
-	return this->instruction_values[index.index];
-}
-
 void executor_context::add_call_stack_notes(bz::vector<ctx::source_highlight> &notes) const
 {
 	bz::vector<ctx::source_highlight> new_notes = {};
@@ -159,6 +153,7 @@ ptr_t executor_context::get_global(uint32_t index)
 ptr_t executor_context::add_global_array_data(lex::src_tokens const &src_tokens, type const *elem_type, bz::array_view<uint8_t const> data)
 {
 	bz_assert(data.size() % elem_type->size == 0);
+	this->is_result_reusable = false;
 	auto const size = data.size() / elem_type->size;
 	auto const array_type = this->codegen_ctx->get_array_type(elem_type, size);
 	auto const index = this->memory.global_memory->add_object(src_tokens, array_type, data);
@@ -242,7 +237,7 @@ void executor_context::call_function(uint32_t call_src_tokens_index, function *f
 	this->alloca_offset = static_cast<uint32_t>(func->allocas.size());
 	this->call_src_tokens_index = call_src_tokens_index;
 
-	auto const &alloca_objects = this->memory.stack.stack_frames.back().objects;
+	auto const alloca_objects = this->memory.stack.get_stack_frame_objects(this->memory.stack.stack_frames.back());
 	bz_assert(alloca_objects.size() == this->alloca_offset);
 
 	for (auto const i : bz::iota(0, this->alloca_offset))
@@ -366,6 +361,7 @@ static bz::vector<ctx::source_highlight> get_notes(
 
 ptr_t executor_context::malloc(uint32_t src_tokens_index, type const *type, uint64_t count)
 {
+	this->is_result_reusable = false;
 	auto const result = this->memory.allocate(this->get_call_stack_info(src_tokens_index), type, count);
 	if (result == 0)
 	{
@@ -1228,7 +1224,7 @@ void executor_context::advance(void)
 bool executor_context::check_memory_leaks(void)
 {
 	bool result = false;
-	for (auto const &allocation : this->memory.heap.allocations)
+	for (auto const &[address, allocation] : this->memory.heap.allocations)
 	{
 		if (!allocation.is_freed)
 		{
@@ -1294,34 +1290,28 @@ ast::constant_value executor_context::execute_expression(ast::expression const &
 
 	[[maybe_unused]] auto const good = this->memory.push_stack_frame(func.allocas);
 	bz_assert(good);
-	auto const &alloca_objects = this->memory.stack.stack_frames.back().objects;
+	auto const alloca_objects = this->memory.stack.get_stack_frame_objects(this->memory.stack.stack_frames.back());
 	bz_assert(alloca_objects.size() == this->alloca_offset);
 	for (auto const i : bz::iota(0, this->alloca_offset))
 	{
 		this->instruction_values[i].ptr = alloca_objects[i].address;
 	}
 
-	while (!this->returned && !this->has_error)
-	{
-#ifndef NDEBUG
-		if (global_data::debug_comptime_print_instructions)
-		{
-			bz::log(
-				">>> %{} in '{}'\n",
-				this->current_instruction_value - this->instruction_values.data(),
-				this->current_function->func_body != nullptr ? this->current_function->func_body->get_signature() : "anon-function"
-			);
-		}
-#endif // !NDEBUG
-
 #ifdef BOZON_PROFILE_COMPTIME
-		global_data::comptime_executed_instructions_count += 1;
-		instruction_counts[this->current_instruction->index()] += 1;
+	auto const execution_begin = timer::now();
+	global_data::comptime_execution_depth += 1;
 #endif // BOZON_PROFILE_COMPTIME
 
-		execute_current_instruction(*this);
-		this->advance();
+	execute_instructions(*this);
+
+#ifdef BOZON_PROFILE_COMPTIME
+	global_data::comptime_execution_depth -= 1;
+	// nested executions are already included in the outermost one
+	if (global_data::comptime_execution_depth == 0)
+	{
+		global_data::comptime_execution_time += timer::now() - execution_begin;
 	}
+#endif // BOZON_PROFILE_COMPTIME
 
 	if (this->has_error)
 	{
@@ -1362,7 +1352,7 @@ ast::constant_value executor_context::execute_expression(ast::expression const &
 
 		auto [result, error_reasons] = memory::constant_value_from_object(
 			result_object->object_type,
-			result_object->memory.data(),
+			result_object->get_object_memory().data(),
 			expr.get_expr_type(),
 			this->codegen_ctx->machine_parameters.endianness,
 			*this
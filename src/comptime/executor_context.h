@@ -32,6 +32,9 @@ struct executor_context
 	instruction_value ret_value = { .none = none_t{} };
 	bool returned = false;
 	bool has_error = false;
+	// set to false if the execution had side effects, e.g. heap allocations or printing,
+	// which means that the result can't be reused for another call with the same arguments
+	bool is_result_reusable = true;
 
 	function const *current_function = nullptr;
 	bz::fixed_vector<instruction_value> args{};
@@ -53,8 +56,15 @@ struct executor_context
 
 	uint8_t *get_memory(ptr_t address);
 
-	void set_current_instruction_value(instruction_value value);
-	instruction_value get_instruction_value(instruction_value_index index);
+	void set_current_instruction_value(instruction_value value)
+	{
+		*this->current_instruction_value = value;
+	}
+
+	instruction_value get_instruction_value(instruction_value_index index)
+	{
+		return this->instruction_values[index.index];
+	}
 
 	void add_call_stack_notes(bz::vector<ctx::source_highlight> &notes) const;
 	void report_error(uint32_t error_index);
@@ -101,6 +101,8 @@ struct copy_values_info_t
 struct function
 {
 	bz::fixed_vector<instruction> instructions;
+	// handler addresses of the instructions for threaded dispatch, set by 'decode_instructions'
+	bz::fixed_vector<void *> instruction_handlers;
 	bz::fixed_vector<type const *> arg_types;
 	type const *return_type = nullptr;
 
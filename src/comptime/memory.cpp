@@ -10,7 +10,11 @@ static constexpr uint8_t heap_object_align = 16;
 
 static void add_allocation_info(bz::vector<error_reason_t> &reasons, call_stack_info_t const &alloc_info)
 {
-	bz_assert(alloc_info.call_stack.not_empty());
+	if (alloc_info.call_stack.empty())
+	{
+		// the allocation was dropped from the freed allocation history
+		return;
+	}
 	if (alloc_info.call_stack.back().body != nullptr)
 	{
 		reasons.push_back({
@@ -41,6 +45,12 @@ static void add_allocation_info(bz::vector<error_reason_t> &reasons, call_stack_
 
 static void add_free_info(bz::vector<error_reason_t> &reasons, call_stack_info_t const &free_info)
 {
+	if (free_info.src_tokens.pivot == nullptr)
+	{
+		// the allocation was dropped from the freed allocation history
+		return;
+	}
+
 	reasons.push_back({ free_info.src_tokens, "allocation was freed here" });
 	for (auto const &call : free_info.call_stack.reversed())
 	{
@@ -127,9 +137,9 @@ memory_properties::memory_properties(type const *object_type, size_t size, uint8
 	}
 }
 
-bool memory_properties::is_all(size_t begin, size_t end, uint8_t bits, uint8_t exception_bits) const
+static bool is_all_properties(bz::array_view<uint8_t const> properties, uint8_t bits, uint8_t exception_bits)
 {
-	for (auto const value : this->data.slice(begin, end))
+	for (auto const value : properties)
 	{
 		if ((value & (bits | exception_bits)) == 0)
 		{
@@ -139,9 +149,9 @@ bool memory_properties::is_all(size_t begin, size_t end, uint8_t bits, uint8_t e
 	return true;
 }
 
-bool memory_properties::is_none(size_t begin, size_t end, uint8_t bits, uint8_t exception_bits) const
+static bool is_none_properties(bz::array_view<uint8_t const> properties, uint8_t bits, uint8_t exception_bits)
 {
-	for (auto const value : this->data.slice(begin, end))
+	for (auto const value : properties)
 	{
 		if ((value & (bits | exception_bits)) == bits)
 		{
@@ -151,61 +161,105 @@ bool memory_properties::is_none(size_t begin, size_t end, uint8_t bits, uint8_t
 	return true;
 }
 
-void memory_properties::set_range(size_t begin, size_t end, uint8_t bits)
+static void set_properties(bz::array_view<uint8_t> properties, uint8_t bits)
 {
-	for (auto &value : this->data.slice(begin, end))
+	for (auto &value : properties)
 	{
 		value |= bits;
 	}
 }
 
-void memory_properties::erase_range(size_t begin, size_t end, uint8_t bits)
+static void erase_properties(bz::array_view<uint8_t> properties, uint8_t bits)
 {
-	for (auto &value : this->data.slice(begin, end))
+	for (auto &value : properties)
 	{
 		value &= ~bits;
 	}
 }
 
+bool memory_properties::is_all(size_t begin, size_t end, uint8_t bits, uint8_t exception_bits) const
+{
+	return is_all_properties(this->data.slice(begin, end), bits, exception_bits);
+}
+
+bool memory_properties::is_none(size_t begin, size_t end, uint8_t bits, uint8_t exception_bits) const
+{
+	return is_none_properties(this->data.slice(begin, end), bits, exception_bits);
+}
+
+void memory_properties::set_range(size_t begin, size_t end, uint8_t bits)
+{
+	set_properties(this->data.slice(begin, end), bits);
+}
+
+void memory_properties::erase_range(size_t begin, size_t end, uint8_t bits)
+{
+	erase_properties(this->data.slice(begin, end), bits);
+}
+
 void memory_properties::clear(void)
 {
 	this->data.clear();
 }
 
-stack_object::stack_object(lex::src_tokens const &_object_src_tokens, ptr_t _address, type const *_object_type, bool is_always_initialized)
+stack_object::stack_object(
+	lex::src_tokens const &_object_src_tokens,
+	ptr_t _address,
+	type const *_object_type,
+	stack_manager *_manager,
+	size_t _offset
+)
 	: address(_address),
 	  object_type(_object_type),
-	  memory(_object_type->size, 0),
-	  properties(_object_type, _object_type->size, is_always_initialized ? memory_properties::is_alive : 0),
+	  manager(_manager),
+	  offset(_offset),
 	  object_src_tokens(_object_src_tokens)
 {}
 
 size_t stack_object::object_size(void) const
 {
-	return this->memory.size();
+	return this->object_type->size;
+}
+
+bz::array_view<uint8_t> stack_object::get_object_memory(void)
+{
+	return this->manager->memory.slice(this->offset, this->offset + this->object_size());
+}
+
+bz::array_view<uint8_t const> stack_object::get_object_memory(void) const
+{
+	return this->manager->memory.slice(this->offset, this->offset + this->object_size());
+}
+
+bz::array_view<uint8_t> stack_object::get_object_properties(void)
+{
+	return this->manager->properties.slice(this->offset, this->offset + this->object_size());
+}
+
+bz::array_view<uint8_t const> stack_object::get_object_properties(void) const
+{
+	return this->manager->properties.slice(this->offset, this->offset + this->object_size());
 }
 
 void stack_object::start_lifetime(ptr_t begin, ptr_t end)
 {
-	bz_assert(this->properties.is_none(
-		begin - this->address,
-		end - this->address,
-		memory_properties::is_alive,
-		memory_properties::is_padding
-	));
-	this->properties.set_range(begin - this->address, end - this->address, memory_properties::is_alive);
+	auto const properties = this->get_object_properties().slice(begin - this->address, end - this->address);
+	bz_assert(is_none_properties(properties, memory_properties::is_alive, memory_properties::is_padding));
+	set_properties(properties, memory_properties::is_alive);
 }
 
 void stack_object::end_lifetime(ptr_t begin, ptr_t end)
 {
-	this->properties.erase_range(begin - this->address, end - this->address, memory_properties::is_alive);
+	erase_properties(
+		this->get_object_properties().slice(begin - this->address, end - this->address),
+		memory_properties::is_alive
+	);
 }
 
 bool stack_object::is_alive(ptr_t begin, ptr_t end) const
 {
-	return this->properties.is_all(
-		begin - this->address,
-		end - this->address,
+	return is_all_properties(
+		this->get_object_properties().slice(begin - this->address, end - this->address),
 		memory_properties::is_alive,
 		memory_properties::is_padding
 	);
@@ -214,20 +268,18 @@ bool stack_object::is_alive(ptr_t begin, ptr_t end) const
 uint8_t *stack_object::get_memory(ptr_t address)
 {
 	bz_assert(address >= this->address && address <= this->address + this->object_size());
-	bz_assert(this->memory.not_empty());
-	return this->memory.data() + (address - this->address);
+	return this->get_object_memory().data() + (address - this->address);
 }
 
 uint8_t const *stack_object::get_memory(ptr_t address) const
 {
 	bz_assert(address >= this->address && address <= this->address + this->object_size());
-	bz_assert(this->memory.not_empty());
-	return this->memory.data() + (address - this->address);
+	return this->get_object_memory().data() + (address - this->address);
 }
 
 bool stack_object::check_dereference(ptr_t address, type const *subobject_type) const
 {
-	if (address < this->address || address >= this->address + this->object_size() || this->memory.empty())
+	if (address < this->address || address >= this->address + this->object_size())
 	{
 		bz_unreachable;
 	}
@@ -254,8 +306,7 @@ bool stack_object::check_slice_construction(ptr_t begin, ptr_t end, bool end_is_
 	}
 
 	if (
-		this->memory.empty()
-		|| begin < this->address || begin >= this->address + this->object_size()
+		begin < this->address || begin >= this->address + this->object_size()
 		|| end <= this->address || end > this->address + this->object_size()
 	)
 	{
@@ -606,7 +657,7 @@ copy_values_memory_t stack_object::get_dest_memory(ptr_t address, size_t count,
 	}
 	else
 	{
-		return { this->memory.slice(begin_offset, end_offset) };
+		return { this->get_object_memory().slice(begin_offset, end_offset) };
 	}
 }
 
@@ -673,7 +724,7 @@ copy_values_memory_t stack_object::get_copy_source_memory(ptr_t address, size_t
 	}
 	else
 	{
-		return { this->memory.slice(begin_offset, end_offset) };
+		return { this->get_object_memory().slice(begin_offset, end_offset) };
 	}
 }
 
@@ -762,11 +813,11 @@ copy_overlapping_values_data_t stack_object::get_copy_overlapping_memory(
 
 	return {
 		.dest = {
-			this->memory.slice(dest_offset, dest_end_offset),
-			this->properties.data.slice(dest_offset, dest_end_offset),
+			this->get_object_memory().slice(dest_offset, dest_end_offset),
+			this->get_object_properties().slice(dest_offset, dest_end_offset),
 		},
 		.source = {
-			this->memory.slice(source_offset, source_end_offset),
+			this->get_object_memory().slice(source_offset, source_end_offset),
 			{},
 		},
 	};
@@ -1954,10 +2005,14 @@ bz::vector<bz::u8string> heap_object::get_get_relocate_overlapping_memory_error_
 	return result;
 }
 
-stack_manager::stack_manager(ptr_t stack_begin)
-	: head(stack_begin),
+stack_manager::stack_manager(ptr_t _stack_begin)
+	: stack_begin(_stack_begin),
+	  head(_stack_begin),
 	  stack_frames(),
-	  stack_frame_id(0)
+	  stack_frame_id(0),
+	  objects(),
+	  memory(),
+	  properties()
 {}
 
 void stack_manager::push_stack_frame(bz::array_view<alloca const> allocas)
@@ -1969,31 +2024,63 @@ void stack_manager::push_stack_frame(bz::array_view<alloca const> allocas)
 	new_frame.id = this->stack_frame_id;
 	this->stack_frame_id += 1;
 
+	new_frame.objects_begin = this->objects.size();
+	this->objects.reserve(this->objects.size() + allocas.size());
 	auto object_address = begin_address;
-	new_frame.objects = bz::fixed_vector<stack_object>(
-		allocas.transform([&object_address, begin_address](alloca const &a) {
-			auto const &[object_type, is_always_initialized, src_tokens] = a;
-			object_address = object_address == begin_address
-				? begin_address
-				: object_address + (object_type->align - object_address % object_type->align);
-			bz_assert(object_address % object_type->align == 0);
-			auto result = stack_object(src_tokens, object_address, object_type, is_always_initialized);
-			object_address += object_type->size;
-			return result;
-		})
-	);
+	for (auto const &[object_type, is_always_initialized, src_tokens] : allocas)
+	{
+		object_address = object_address == begin_address
+			? begin_address
+			: object_address + (object_type->align - object_address % object_type->align);
+		bz_assert(object_address % object_type->align == 0);
+		this->objects.emplace_back(src_tokens, object_address, object_type, this, object_address - this->stack_begin);
+		object_address += object_type->size;
+	}
+	new_frame.objects_end = this->objects.size();
 	new_frame.total_size = object_address - begin_address;
 
 	this->head = object_address + (max_object_align - object_address % max_object_align);
+
+	// the buffers are never shrunk, so previously popped frames can leave data behind
+	auto const frame_begin_offset = begin_address - this->stack_begin;
+	auto const frame_end_offset = this->head - this->stack_begin;
+	if (this->memory.size() < frame_end_offset)
+	{
+		this->memory.resize(frame_end_offset);
+		this->properties.resize(frame_end_offset);
+	}
+	std::memset(this->memory.data() + frame_begin_offset, 0, frame_end_offset - frame_begin_offset);
+	std::memset(this->properties.data() + frame_begin_offset, 0, frame_end_offset - frame_begin_offset);
+
+	auto const new_objects = this->objects.slice(new_frame.objects_begin);
+	for (auto const &[object, a] : bz::zip(new_objects, allocas))
+	{
+		auto const object_properties = object.get_object_properties();
+		if (a.is_always_initialized)
+		{
+			set_properties(object_properties, memory_properties::is_alive);
+		}
+		fill_padding_single(object_properties, object.object_type);
+	}
 }
 
 void stack_manager::pop_stack_frame(void)
 {
 	bz_assert(this->stack_frames.not_empty());
-	this->head = this->stack_frames.back().begin_address;
+	auto const &frame = this->stack_frames.back();
+	this->head = frame.begin_address;
+	while (this->objects.size() != frame.objects_begin)
+	{
+		this->objects.pop_back();
+	}
 	this->stack_frames.pop_back();
 }
 
+bz::array_view<stack_object const> stack_manager::get_stack_frame_objects(stack_frame const &frame) const
+{
+	return this->objects.slice(frame.objects_begin, frame.objects_end);
+}
+
 stack_frame *stack_manager::get_stack_frame(ptr_t address)
 {
 	if (
@@ -2062,8 +2149,9 @@ stack_object *stack_manager::get_stack_object(ptr_t address)
 	// find the last element that has an address that is less than or equal to address.
 	// we do this by finding the first element, whose address is greater than address
 	// and taking the element before that
+	auto const frame_objects = this->objects.slice(frame->objects_begin, frame->objects_end);
 	auto const it = std::upper_bound(
-		frame->objects.begin(), frame->objects.end(),
+		frame_objects.begin(), frame_objects.end(),
 		address,
 		[](ptr_t address, auto const &object) {
 			return address < object.address;
@@ -2084,8 +2172,9 @@ stack_object const *stack_manager::get_stack_object(ptr_t address) const
 	// find the last element that has an address that is less than or equal to address.
 	// we do this by finding the first element, whose address is greater than address
 	// and taking the element before that
+	auto const frame_objects = this->objects.slice(frame->objects_begin, frame->objects_end);
 	auto const it = std::upper_bound(
-		frame->objects.begin(), frame->objects.end(),
+		frame_objects.begin(), frame_objects.end(),
 		address,
 		[](ptr_t address, auto const &object) {
 			return address < object.address;
@@ -2346,66 +2435,131 @@ free_result allocation::free(call_stack_info_t free_info)
 
 heap_manager::heap_manager(ptr_t heap_begin)
 	: head(heap_begin),
-	  allocations()
+	  allocations(),
+	  freed_history(),
+	  freed_history_begin(0),
+	  untracked_allocations(),
+	  untracked_history(),
+	  untracked_history_begin(0),
+	  untracked_allocation_objects(),
+	  live_allocation_count(0)
 {}
 
-allocation *heap_manager::get_allocation(ptr_t address)
+static uint64_t get_rounded_allocation_size(type const *object_type, uint64_t count)
 {
-	if (this->allocations.empty() || address < this->allocations[0].object.address)
-	{
-		return nullptr;
-	}
-	else if (address >= this->allocations.back().object.address)
-	{
-		return &this->allocations.back();
-	}
+	auto const allocation_size = object_type->size * count;
+	// we round up the allocation size to the nearest 16-byte boundary (heap_object_align == 16)
+	// if it's already at such a boundary, then we simply add 16 to add some padding
+	return allocation_size + (heap_object_align - allocation_size % heap_object_align);
+}
 
+allocation *heap_manager::get_allocation(ptr_t address)
+{
 	// find the first element that has an address that is less than or equal to address.
 	// we do this by finding the first element, whose address is greater than address
 	// and taking the element before that
-	auto const it = std::upper_bound(
-		this->allocations.begin(), this->allocations.end(),
-		address,
-		[](ptr_t address, auto const &allocation) {
-			return address < allocation.object.address;
+	auto const it = this->allocations.upper_bound(address);
+	if (it != this->allocations.begin())
+	{
+		auto &[allocation_address, allocation] = *std::prev(it);
+		auto const end_address = allocation_address
+			+ get_rounded_allocation_size(allocation.object.elem_type, allocation.object.count);
+		if (address < end_address)
+		{
+			return &allocation;
 		}
-	);
-	return &*(it - 1);
+	}
+
+	return this->get_untracked_allocation(address);
 }
 
 allocation const *heap_manager::get_allocation(ptr_t address) const
 {
-	if (this->allocations.empty() || address < this->allocations[0].object.address)
+	return const_cast<heap_manager *>(this)->get_allocation(address);
+}
+
+// element type of the allocation objects recreated for addresses in evicted allocations
+static type const evicted_allocation_elem_type = type(ast::builtin_type{ builtin_type_kind::i8 }, 1, 1);
+
+allocation *heap_manager::get_untracked_allocation(ptr_t address) const
+{
+	auto const get_allocation_object = [this](ptr_t allocation_address, type const *elem_type, uint64_t count) {
+		// the call stacks of the allocation are not available anymore, so the
+		// recreated allocation only has enough information for error checking
+		auto const [object_it, inserted] = this->untracked_allocation_objects.try_emplace(
+			allocation_address,
+			call_stack_info_t{}, allocation_address, elem_type, count
+		);
+		if (inserted)
+		{
+			object_it->second.free(call_stack_info_t{});
+		}
+		return &object_it->second;
+	};
+
+	auto const it = this->untracked_allocations.upper_bound(address);
+	if (it != this->untracked_allocations.begin())
 	{
-		return nullptr;
+		auto const &[info_address, info] = *std::prev(it);
+		if (address < info_address + get_rounded_allocation_size(info.elem_type, info.count))
+		{
+			return get_allocation_object(info_address, info.elem_type, info.count);
+		}
 	}
-	else if (address >= this->allocations.back().object.address)
+
+	if (address >= this->head)
 	{
-		return &this->allocations.back();
+		return nullptr;
 	}
 
-	// find the first element that has an address that is less than or equal to address.
-	// we do this by finding the first element, whose address is greater than address
-	// and taking the element before that
-	auto const it = std::upper_bound(
-		this->allocations.begin(), this->allocations.end(),
+	// the allocation containing 'address' was evicted from 'untracked_allocations', so its
+	// bounds are not known anymore; the address is treated as the start of an empty freed allocation
+	return get_allocation_object(address, &evicted_allocation_elem_type, 0);
+}
+
+void heap_manager::drop_freed_allocation(ptr_t address)
+{
+	auto const it = this->allocations.find(address);
+	bz_assert(it != this->allocations.end() && it->second.is_freed);
+
+	// allocations are usually freed in a similar order to which they were made,
+	// so this is most often an insertion at the end
+	this->untracked_allocations.emplace_hint(
+		this->untracked_allocations.end(),
 		address,
-		[](ptr_t address, auto const &allocation) {
-			return address < allocation.object.address;
+		untracked_allocation_info_t{
+			.elem_type = it->second.object.elem_type,
+			.count = it->second.object.count,
 		}
 	);
-	return &*(it - 1);
+	this->allocations.erase(it);
+
+	if (this->untracked_history.size() < max_untracked_allocation_count)
+	{
+		this->untracked_history.push_back(address);
+	}
+	else
+	{
+		auto const evicted_address = this->untracked_history[this->untracked_history_begin];
+		this->untracked_history[this->untracked_history_begin] = address;
+		this->untracked_history_begin = (this->untracked_history_begin + 1) % max_untracked_allocation_count;
+		this->untracked_allocations.erase(evicted_address);
+		this->untracked_allocation_objects.erase(evicted_address);
+	}
 }
 
 ptr_t heap_manager::allocate(call_stack_info_t alloc_info, type const *object_type, uint64_t count)
 {
 	auto const address = this->head;
-	auto const allocation_size = object_type->size * count;
-	// we round up the allocation size to the nearest 16-byte boundary (heap_object_align == 16)
-	// if it's already at such a boundary, then we simply add 16 to add some padding
-	auto const rounded_allocation_size = allocation_size + (heap_object_align - allocation_size % heap_object_align);
-	this->head += rounded_allocation_size;
-	this->allocations.emplace_back(std::move(alloc_info), address, object_type, count);
+	this->head += get_rounded_allocation_size(object_type, count);
+	// addresses are increasing, so the new allocation is always the last one
+	this->allocations.try_emplace(this->allocations.end(), address, std::move(alloc_info), address, object_type, count);
+	this->live_allocation_count += 1;
+	global_data::comptime_heap_allocation_count += 1;
+	global_data::comptime_max_live_heap_allocation_count = std::max(
+		global_data::comptime_max_live_heap_allocation_count,
+		this->live_allocation_count
+	);
 	return address;
 }
 
@@ -2416,10 +2570,28 @@ free_result heap_manager::free(call_stack_info_t free_info, ptr_t address)
 	{
 		return free_result::invalid_pointer;
 	}
+
+	auto const result = allocation->free(std::move(free_info));
+	if (result != free_result::good)
+	{
+		return result;
+	}
+
+	this->live_allocation_count -= 1;
+	global_data::comptime_heap_free_count += 1;
+
+	if (this->freed_history.size() < max_freed_history_size)
+	{
+		this->freed_history.push_back(address);
+	}
 	else
 	{
-		return allocation->free(std::move(free_info));
+		auto const dropped_address = this->freed_history[this->freed_history_begin];
+		this->freed_history[this->freed_history_begin] = address;
+		this->freed_history_begin = (this->freed_history_begin + 1) % max_freed_history_size;
+		this->drop_freed_allocation(dropped_address);
 	}
+	return free_result::good;
 }
 
 bool heap_manager::check_dereference(ptr_t address, type const *object_type) const
@@ -44,18 +44,25 @@ struct copy_overlapping_values_data_t
 	copy_values_memory_and_properties_t source;
 };
 
+struct stack_manager;
+
 struct stack_object
 {
 	ptr_t address;
 	type const *object_type;
-	bz::fixed_vector<uint8_t> memory;
-	memory_properties properties;
+	// the memory and memory properties of the object are stored in 'manager', starting at 'offset'
+	stack_manager *manager;
+	size_t offset;
 
 	lex::src_tokens object_src_tokens;
 
-	stack_object(lex::src_tokens const &object_src_tokens, ptr_t address, type const *object_type, bool is_always_initialized);
+	stack_object(lex::src_tokens const &object_src_tokens, ptr_t address, type const *object_type, stack_manager *manager, size_t offset);
 
 	size_t object_size(void) const;
+	bz::array_view<uint8_t> get_object_memory(void);
+	bz::array_view<uint8_t const> get_object_memory(void) const;
+	bz::array_view<uint8_t> get_object_properties(void);
+	bz::array_view<uint8_t const> get_object_properties(void) const;
 
 	void start_lifetime(ptr_t begin, ptr_t end);
 	void end_lifetime(ptr_t begin, ptr_t end);
@@ -199,7 +206,8 @@ struct heap_object
 
 struct stack_frame
 {
-	bz::fixed_vector<stack_object> objects;
+	size_t objects_begin;
+	size_t objects_end;
 	ptr_t begin_address;
 	size_t total_size;
 	uint32_t id;
@@ -207,15 +215,29 @@ struct stack_frame
 
 struct stack_manager
 {
+	ptr_t stack_begin;
 	ptr_t head;
 	bz::vector<stack_frame> stack_frames;
 	uint32_t stack_frame_id;
 
+	// the objects of all stack frames, and the memory and memory properties of the whole stack,
+	// with 'stack_begin' being at index 0.  The memory is reused by later frames after a frame is popped.
+	bz::vector<stack_object> objects;
+	bz::vector<uint8_t> memory;
+	bz::vector<uint8_t> properties;
+
 	explicit stack_manager(ptr_t stack_begin);
+	// stack objects refer back to their stack manager
+	stack_manager(stack_manager const &other) = delete;
+	stack_manager(stack_manager &&other) = delete;
+	stack_manager &operator = (stack_manager const &other) = delete;
+	stack_manager &operator = (stack_manager &&other) = delete;
 
 	void push_stack_frame(bz::array_view<alloca const> types);
 	void pop_stack_frame(void);
 
+	bz::array_view<stack_object const> get_stack_frame_objects(stack_frame const &frame) const;
+
 	stack_frame *get_stack_frame(ptr_t address);
 	stack_frame const *get_stack_frame(ptr_t address) const;
 	stack_object *get_stack_object(ptr_t address);
@@ -301,15 +323,44 @@ struct allocation
 	free_result free(call_stack_info_t free_info);
 };
 
+// minimal information kept about a freed allocation after it has been dropped from the freed allocation history
+struct untracked_allocation_info_t
+{
+	type const *elem_type;
+	uint64_t count;
+};
+
 struct heap_manager
 {
+	static constexpr size_t max_freed_history_size = 1024;
+	static constexpr size_t max_untracked_allocation_count = 16 * 1024;
+
 	ptr_t head;
-	bz::vector<allocation> allocations;
+	// live allocations and the most recently freed ones, keyed by their address
+	// freed allocations are removed in the order they were freed, so a sorted vector would have to
+	// shift its elements on every free
+	std::map<ptr_t, allocation> allocations;
+	// addresses of the freed allocations in 'allocations' in the order they were freed;
+	// once full, this is used as a ring buffer starting at 'freed_history_begin'
+	bz::vector<ptr_t> freed_history;
+	size_t freed_history_begin;
+	// freed allocations that were dropped from 'allocations', keyed by their address
+	std::map<ptr_t, untracked_allocation_info_t> untracked_allocations;
+	// addresses in 'untracked_allocations' in the order they were dropped, used as a ring buffer
+	// like 'freed_history'.  the oldest entry is evicted once this is full; allocations cover the heap
+	// without gaps, so an address below 'head' that isn't found anywhere is in an evicted allocation
+	bz::vector<ptr_t> untracked_history;
+	size_t untracked_history_begin;
+	// allocation objects recreated from 'untracked_allocations' or for evicted addresses on demand for diagnostics
+	mutable std::unordered_map<ptr_t, allocation> untracked_allocation_objects;
+	size_t live_allocation_count;
 
 	explicit heap_manager(ptr_t heap_begin);
 
 	allocation *get_allocation(ptr_t address);
 	allocation const *get_allocation(ptr_t address) const;
+	allocation *get_untracked_allocation(ptr_t address) const;
+	void drop_freed_allocation(ptr_t address);
 
 	ptr_t allocate(call_stack_info_t alloc_info, type const *object_type, uint64_t count);
 	free_result free(call_stack_info_t free_info, ptr_t address);
@@ -230,7 +230,7 @@ static ast::expression get_type_op_unary_auto_ref_const(
 		context.report_error(src_tokens, "auto reference-mut to mut type is not allowed", {}, {
 			context.make_suggestion_before(
 				src_tokens.pivot,
-				src_tokens.pivot->src_pos.begin, src_tokens.pivot->src_pos.end, "#",
+				src_tokens.pivot->get_begin(), src_tokens.pivot->get_end(), "#",
 				"use auto reference instead"
 			)
 		});
@@ -1,9 +1,12 @@
 #include "global_context.h"
+#include "parse_context.h"
 #include "ast/statement.h"
+#include "resolve/statement_resolver.h"
 #include "cl_options.h"
 #include "colors.h"
 #include "comptime/codegen_context.h"
 #include "comptime/codegen.h"
+#include "src_file_prefetcher.h"
 
 namespace ctx
 {
@@ -42,18 +45,9 @@ src_file *global_context::get_src_file(fs::path const &file_path)
 	}
 }
 
-bz::array_view<bz::u8string_view const> global_context::get_scope_in_persistent_storage(bz::array_view<bz::u8string const> scope)
+bz::array_view<uint32_t const> global_context::get_scope_in_persistent_storage(bz::array_view<uint32_t const> scope)
 {
-	auto &result = this->_src_scopes_storage.emplace_back();
-
-	for (auto const &fragment : scope)
-	{
-		auto &fragment_storage = this->_src_scope_fragments.push_back(std::make_unique<char[]>(fragment.size()));
-		std::memcpy(fragment_storage.get(), fragment.data_as_char_ptr(), fragment.size());
-		result.push_back(bz::u8string_view(fragment_storage.get(), fragment_storage.get() + fragment.size()));
-	}
-
-	return result;
+	return this->_src_scopes_storage.emplace_back(scope);
 }
 
 ast::type_info *global_context::get_builtin_type_info(uint32_t kind) const
@@ -91,7 +85,7 @@ ast::decl_function *global_context::get_builtin_function(uint32_t kind)
 	return this->_builtin_functions[kind];
 }
 
-bz::array_view<uint32_t const> global_context::get_builtin_universal_functions(bz::u8string_view id)
+bz::array_view<uint32_t const> global_context::get_builtin_universal_functions(uint32_t id)
 {
 	auto const it = std::find_if(
 		this->_builtin_universal_functions.begin(), this->_builtin_universal_functions.end(),
@@ -294,8 +288,8 @@ void global_context::report_error(
 	this->_errors.push_back(error{
 		warning_kind::_last,
 		{
-			src_tokens.pivot->src_pos.file_id, src_tokens.pivot->src_pos.line,
-			src_tokens.begin->src_pos.begin, src_tokens.pivot->src_pos.begin, (src_tokens.end - 1)->src_pos.end,
+			src_tokens.pivot->get_file_id(), src_tokens.pivot->get_line(),
+			src_tokens.begin->get_begin(), src_tokens.pivot->get_begin(), (src_tokens.end - 1)->get_end(),
 			suggestion_range{}, suggestion_range{},
 			std::move(message),
 		},
@@ -341,8 +335,8 @@ void global_context::report_warning(warning_kind kind, bz::u8string message)
 [[nodiscard]] source_highlight global_context::make_note(lex::src_tokens const &src_tokens, bz::u8string message)
 {
 	return source_highlight{
-		src_tokens.pivot->src_pos.file_id, src_tokens.pivot->src_pos.line,
-		src_tokens.begin->src_pos.begin, src_tokens.pivot->src_pos.begin, (src_tokens.end - 1)->src_pos.end,
+		src_tokens.pivot->get_file_id(), src_tokens.pivot->get_line(),
+		src_tokens.begin->get_begin(), src_tokens.pivot->get_begin(), (src_tokens.end - 1)->get_end(),
 		{}, {},
 		std::move(message)
 	};
@@ -388,6 +382,27 @@ bool global_context::is_library_file(uint32_t file_id) const noexcept
 	return file_id == compiler_file_id || file_id == command_line_file_id || this->get_src_file(file_id)._is_library_file;
 }
 
+uint32_t global_context::get_compilation_unit_file_id(uint32_t file_id) const noexcept
+{
+	bz_assert(this->_source_file_ids.not_empty());
+	if (this->_source_file_ids.contains(file_id))
+	{
+		return file_id;
+	}
+
+	// everything that doesn't come from a source file given on the command line (e.g. the standard library)
+	// goes into the compilation unit of 'main', or the first compilation unit if there's no 'main'
+	if (this->_main != nullptr && this->_main->src_tokens.pivot != nullptr)
+	{
+		auto const main_file_id = this->_main->src_tokens.pivot->get_file_id();
+		if (this->_source_file_ids.contains(main_file_id))
+		{
+			return main_file_id;
+		}
+	}
+	return this->_source_file_ids[0];
+}
+
 
 bool global_context::has_errors(void) const
 {
@@ -444,6 +459,30 @@ void global_context::add_compile_function(ast::function_body &func_body)
 	this->_compile_decls.funcs.push_back(&func_body);
 }
 
+void global_context::add_deferred_library_function(ast::function_body &func_body)
+{
+	this->_deferred_library_functions.push_back(&func_body);
+}
+
+void global_context::require_function_body(ast::function_body &func_body)
+{
+	if (
+		global_data::check_library
+		|| func_body.state != ast::resolve_state::symbol
+		|| !func_body.body.is<lex::token_range>()
+		|| func_body.src_tokens.pivot == nullptr
+		|| !this->get_src_file(func_body.src_tokens.pivot->get_file_id())._is_library_file
+	)
+	{
+		return;
+	}
+
+	if (this->_required_library_functions_set.insert(&func_body).second)
+	{
+		this->_required_library_functions.push_back(&func_body);
+	}
+}
+
 static std::pair<fs::path, bool> search_for_source_file(
 	ast::identifier const &id,
 	fs::path const &current_path,
@@ -453,7 +492,7 @@ static std::pair<fs::path, bool> search_for_source_file(
 	bz::u8string module_file_name;
 	bool allow_library = true;
 	bool first = true;
-	for (auto const value : id.values)
+	for (auto const value : id.get_values())
 	{
 		if (first)
 		{
@@ -510,7 +549,7 @@ static uint32_t add_module_file(
 	src_file const &current_file,
 	fs::path module_path,
 	bool is_library_file,
-	bz::vector<bz::u8string> scope,
+	bz::vector<uint32_t> scope,
 	global_context &context
 )
 {
@@ -542,7 +581,7 @@ static bz::vector<global_context::module_info_t> add_module_folder(
 	src_file const &current_file,
 	fs::path module_path,
 	bool is_library_folder,
-	bz::vector<bz::u8string> &scope,
+	bz::vector<uint32_t> &scope,
 	global_context &context
 )
 {
@@ -576,7 +615,7 @@ static bz::vector<global_context::module_info_t> add_module_folder(
 			}();
 			if (is_identifier)
 			{
-				scope.push_back(folder_name);
+				scope.push_back(lex::intern_identifier(folder_name));
 				result.append(add_module_folder(current_file, p.path(), is_library_folder, scope, context));
 				scope.pop_back();
 			}
@@ -611,8 +650,8 @@ bz::vector<global_context::module_info_t> global_context::add_module(uint32_t cu
 		this->report_error(error{
 			warning_kind::_last,
 			{
-				id.tokens.begin->src_pos.file_id, id.tokens.begin->src_pos.line,
-				id.tokens.begin->src_pos.begin, id.tokens.begin->src_pos.begin, (id.tokens.end - 1)->src_pos.end,
+				id.tokens.begin->get_file_id(), id.tokens.begin->get_line(),
+				id.tokens.begin->get_begin(), id.tokens.begin->get_begin(), (id.tokens.end - 1)->get_end(),
 				suggestion_range{}, suggestion_range{},
 				bz::format("unable to find module '{}'", id.as_string()),
 			},
@@ -626,14 +665,14 @@ bz::vector<global_context::module_info_t> global_context::add_module(uint32_t cu
 		auto scope = [&, is_library_path = is_library_path]() {
 			if (is_library_path)
 			{
-				auto result = bz::vector<bz::u8string>();
-				result.append(bz::array_view(id.values.begin(), id.values.end() - 1));
+				auto result = bz::vector<uint32_t>();
+				result.append(bz::array_view(id.ids.begin(), id.ids.end() - 1));
 				return result;
 			}
 			else
 			{
-				auto result = this->get_src_file(current_file_id)._scope_container;
-				result.append(bz::array_view(id.values.begin(), id.values.end() - 1));
+				auto result = this->get_src_file(current_file_id)._scope;
+				result.append(bz::array_view(id.ids.begin(), id.ids.end() - 1));
 				return result;
 			}
 		}();
@@ -644,7 +683,7 @@ bz::vector<global_context::module_info_t> global_context::add_module(uint32_t cu
 		}
 		else
 		{
-			return { module_info_t{ result, id.values.slice(0, id.values.size() - 1) } };
+			return { module_info_t{ result, id.ids.slice(0, id.ids.size() - 1) } };
 		}
 	}
 	else
@@ -652,14 +691,14 @@ bz::vector<global_context::module_info_t> global_context::add_module(uint32_t cu
 		auto scope = [&, is_library_path = is_library_path]() {
 			if (is_library_path)
 			{
-				auto result = bz::vector<bz::u8string>();
-				result.append(bz::array_view(id.values.begin(), id.values.end()));
+				auto result = bz::vector<uint32_t>();
+				result.append(bz::array_view(id.ids.begin(), id.ids.end()));
 				return result;
 			}
 			else
 			{
-				auto result = this->get_src_file(current_file_id)._scope_container;
-				result.append(bz::array_view(id.values.begin(), id.values.end()));
+				auto result = this->get_src_file(current_file_id)._scope;
+				result.append(bz::array_view(id.ids.begin(), id.ids.end()));
 				return result;
 			}
 		}();
@@ -667,6 +706,79 @@ bz::vector<global_context::module_info_t> global_context::add_module(uint32_t cu
 	}
 }
 
+static void prefetch_module_folder(fs::path const &module_path, bool is_library_folder, global_context &context)
+{
+	std::error_code ec;
+	for (auto const &p : bz::basic_range(fs::directory_iterator(module_path, ec), fs::directory_iterator()))
+	{
+		auto const filename = p.path().filename().generic_string();
+		if (is_library_folder && filename.starts_with('_'))
+		{
+			continue;
+		}
+
+		// folders that are not identifiers are skipped by add_module_folder, so prefetching them
+		// only wastes some work, but doesn't change the result
+		if (p.is_directory())
+		{
+			prefetch_module_folder(p.path(), is_library_folder, context);
+		}
+		else if (filename.ends_with(".bz"))
+		{
+			auto path = p.path();
+			path.make_preferred();
+			if (context.get_src_file(path) == nullptr)
+			{
+				context._src_file_prefetcher->prefetch(path);
+			}
+		}
+	}
+}
+
+void global_context::prefetch_module(uint32_t current_file_id, ast::identifier const &id)
+{
+	if (this->_src_file_prefetcher == nullptr)
+	{
+		auto const worker_count = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+		this->_src_file_prefetcher = std::make_unique<src_file_prefetcher>(*this, this->target_triple.triple, worker_count);
+	}
+
+	auto &current_file = this->get_src_file(current_file_id);
+	auto const [module_path, is_library_path] = search_for_source_file(
+		id,
+		current_file.get_file_path().parent_path(),
+		this->_import_dirs
+	);
+	if (module_path.empty())
+	{
+		// the error is reported later by add_module
+		return;
+	}
+	else if (module_path.filename().generic_string().ends_with(".bz"))
+	{
+		if (this->get_src_file(module_path) == nullptr)
+		{
+			this->_src_file_prefetcher->prefetch(module_path);
+		}
+	}
+	else
+	{
+		prefetch_module_folder(module_path, is_library_path, *this);
+	}
+}
+
+bz::optional<tokenized_file_t> global_context::get_prefetched_file(fs::path const &file_path)
+{
+	if (this->_src_file_prefetcher == nullptr)
+	{
+		return {};
+	}
+	else
+	{
+		return this->_src_file_prefetcher->get(file_path);
+	}
+}
+
 ast::scope_t &global_context::get_file_global_scope(uint32_t file_id)
 {
 	return this->get_src_file(file_id)._global_scope;
@@ -688,17 +800,17 @@ bz::u8string global_context::get_file_name(uint32_t file_id)
 bz::u8string global_context::get_location_string(lex::token_pos t)
 {
 	bz_assert(t != nullptr);
-	return bz::format("{}:{}", this->get_file_name(t->src_pos.file_id), t->src_pos.line);
+	return bz::format("{}:{}", this->get_file_name(t->get_file_id()), t->get_line());
 }
 
 bool global_context::add_builtin_function(ast::decl_function *func_decl)
 {
-	if (!func_decl->id.is_qualified || func_decl->id.values.size() != 1)
+	if (!func_decl->id.is_qualified || func_decl->id.ids.size() != 1)
 	{
 		return false;
 	}
 
-	auto const id = func_decl->id.values[0];
+	auto const id = func_decl->id.get_value(0);
 
 	auto const it = std::find_if(
 		ast::intrinsic_info.begin(), ast::intrinsic_info.end(),
@@ -901,12 +1013,12 @@ bool global_context::add_builtin_operator(ast::decl_operator *op_decl)
 
 bool global_context::add_builtin_type_alias(ast::decl_type_alias *alias_decl)
 {
-	if (alias_decl->id.values.back() == "isize" && this->_builtin_isize_type_alias == nullptr)
+	if (alias_decl->id.get_value(alias_decl->id.ids.size() - 1) == "isize" && this->_builtin_isize_type_alias == nullptr)
 	{
 		this->_builtin_isize_type_alias = alias_decl;
 		return true;
 	}
-	else if (alias_decl->id.values.back() == "usize" && this->_builtin_usize_type_alias == nullptr)
+	else if (alias_decl->id.get_value(alias_decl->id.ids.size() - 1) == "usize" && this->_builtin_usize_type_alias == nullptr)
 	{
 		this->_builtin_usize_type_alias = alias_decl;
 		return true;
@@ -942,7 +1054,7 @@ static constexpr bz::array builtin_type_info_infos = {
 
 bool global_context::add_builtin_type_info(ast::type_info *info)
 {
-	auto const name = info->type_name.values.back();
+	auto const name = lex::get_identifier_value(info->type_name.ids.back());
 	auto const it = std::find_if(
 		builtin_type_info_infos.begin(), builtin_type_info_infos.end(),
 		[name](auto const &info) {
@@ -1122,14 +1234,98 @@ void global_context::report_and_clear_errors_and_warnings(void)
 	}
 
 	auto &positional_args = ctcli::positional_arguments<ctcli::options_id_t::def>;
-	if (positional_args.size() >= 2)
+	for (auto const &arg : positional_args)
+	{
+		global_data::source_files.push_back(arg);
+	}
+
+	if (global_data::source_files.size() >= 2)
 	{
-		this->report_error("only one source file may be provided");
+		if (global_data::output_file_name != "")
+		{
+			this->report_error("option '--output' can't be used with multiple source files");
+		}
+		if (global_data::source_files.contains("-"))
+		{
+			this->report_error("standard input can't be used as a source file with multiple source files");
+		}
 	}
 
-	if (positional_args.size() == 1)
+	if (global_data::codegen_units == 0)
 	{
-		global_data::source_file = positional_args[0];
+		this->report_error("the number of codegen units must be at least 1");
+	}
+
+	if (global_data::thinlto_backend)
+	{
+		if (global_data::emit_file_type != emit_type::obj)
+		{
+			this->report_error("option '--thinlto-backend' can only be used with '--emit=obj'");
+		}
+		if (global_data::source_files.contains("-"))
+		{
+			this->report_error("standard input can't be used as an input file with option '--thinlto-backend'");
+		}
+		for (auto const &source_file : global_data::source_files)
+		{
+			if (source_file != "-" && !source_file.ends_with(".bc"))
+			{
+				this->report_error(bz::format("ThinLTO bitcode input file '{}' must have the file extension '.bc'", source_file));
+			}
+		}
+	}
+
+	if (global_data::target_features != "")
+	{
+		auto const features = global_data::target_features.as_string_view();
+		auto it = features.begin();
+		while (true)
+		{
+			auto const next = features.find(it, ',');
+			auto const feature = bz::u8string_view(it, next);
+			if (feature.size() < 2 || (!feature.starts_with('+') && !feature.starts_with('-')))
+			{
+				this->report_error(bz::format(
+					"invalid target feature '{}', target features must start with '+' or '-'", feature
+				));
+			}
+
+			if (next == features.end())
+			{
+				break;
+			}
+			it = next;
+			++it;
+		}
+	}
+
+	if (global_data::profile_generate_dir != "" && global_data::profile_use_file != "")
+	{
+		this->report_error("options '-C profile-generate' and '-C profile-use' can't be used together");
+	}
+	else if (global_data::profile_generate_dir != "" && global_data::max_opt_iter_count == 0)
+	{
+		this->report_error("option '-C profile-generate' can't be used with '--opt max-iter-count=0'");
+	}
+	else if (global_data::profile_use_file != "" && global_data::max_opt_iter_count == 0)
+	{
+		// the profile is only read by the optimizer, so it would be silently ignored
+		this->report_error("option '-C profile-use' can't be used with '--opt max-iter-count=0'");
+	}
+	else if (
+		(global_data::profile_generate_dir != "" || global_data::profile_use_file != "")
+		&& global_data::opt_pipeline == opt_pipeline_kind::eager
+	)
+	{
+		this->report_error("profile-guided optimization can't be used with '--opt pipeline=eager'");
+	}
+	else if (global_data::profile_use_file != "")
+	{
+		auto const profile_use_file = std::string_view(global_data::profile_use_file.data_as_char_ptr(), global_data::profile_use_file.size());
+		if (!fs::is_regular_file(profile_use_file))
+		{
+			this->report_error(bz::format("unable to find profile file '{}'", global_data::profile_use_file));
+		}
 	}
 
 	if (this->has_errors())
@@ -1307,7 +1503,7 @@ void global_context::report_and_clear_errors_and_warnings(void)
 		if (fs::exists(builtins_file_path) && fs::is_regular_file(builtins_file_path))
 		{
 			auto &builtins_file = this->emplace_src_file(
-				builtins_file_path, this->_src_files.size(), bz::vector<bz::u8string>(), true
+				builtins_file_path, this->_src_files.size(), bz::vector<uint32_t>(), true
 			);
 			this->_builtin_global_scope = &builtins_file._global_scope;
 			if (!builtins_file.parse_global_symbols(*this))
@@ -1328,7 +1524,7 @@ void global_context::report_and_clear_errors_and_warnings(void)
 		if (fs::exists(builtins_file_path) && fs::is_regular_file(builtins_file_path))
 		{
 			auto &builtins_file = this->emplace_src_file(
-				builtins_file_path, this->_src_files.size(), bz::vector<bz::u8string>(), true
+				builtins_file_path, this->_src_files.size(), bz::vector<uint32_t>(), true
 			);
 			if (!builtins_file.parse_global_symbols(*this))
 			{
@@ -1347,7 +1543,7 @@ void global_context::report_and_clear_errors_and_warnings(void)
 			if (fs::exists(main_file_path) && fs::is_regular_file(main_file_path))
 			{
 				auto &main_file = this->emplace_src_file(
-					main_file_path, this->_src_files.size(), bz::vector<bz::u8string>(), true
+					main_file_path, this->_src_files.size(), bz::vector<uint32_t>(), true
 				);
 				if (!main_file.parse_global_symbols(*this))
 				{
@@ -1365,35 +1561,47 @@ void global_context::report_and_clear_errors_and_warnings(void)
 	return true;
 }
 
-[[nodiscard]] bool global_context::parse_global_symbols(void)
+[[nodiscard]] bool global_context::parse_global_symbols(size_t source_file_index)
 {
-	if (global_data::source_file == "")
-	{
-		this->report_error("no source file was provided");
-		return false;
-	}
-	else if (global_data::source_file != "-" && !global_data::source_file.ends_with(".bz"))
+	bz_assert(source_file_index < global_data::source_files.size());
+	auto const &source_file = global_data::source_files[source_file_index];
+	if (source_file != "-" && !source_file.ends_with(".bz"))
 	{
-		this->report_error("source file name must end in '.bz'");
+		this->report_error(bz::format("source file name '{}' must end in '.bz'", source_file));
 		return false;
 	}
 
-	auto source_file_path = fs::canonical(fs::path(std::string_view(global_data::source_file.data_as_char_ptr(), global_data::source_file.size())));
+	auto source_file_path = fs::canonical(fs::path(std::string_view(source_file.data_as_char_ptr(), source_file.size())));
 	source_file_path.make_preferred();
 	if (!fs::exists(source_file_path))
 	{
-		this->report_error(bz::format("invalid source file '{}': file does not exist", global_data::source_file));
+		this->report_error(bz::format("invalid source file '{}': file does not exist", source_file));
 		return false;
 	}
 	else if (!fs::is_regular_file(source_file_path))
 	{
-		this->report_error(bz::format("invalid source file '{}': file is not a regular file", global_data::source_file));
+		this->report_error(bz::format("invalid source file '{}': file is not a regular file", source_file));
 		return false;
 	}
 
+	// the file may have already been imported by a previous source file
+	auto const existing_file = this->get_src_file(source_file_path);
+	if (existing_file != nullptr)
+	{
+		if (this->_source_file_ids.contains(existing_file->_file_id))
+		{
+			this->report_error(bz::format("source file '{}' was provided multiple times", source_file));
+			return false;
+		}
+
+		this->_source_file_ids.push_back(existing_file->_file_id);
+		return true;
+	}
+
 	auto &file = this->emplace_src_file(
-		std::move(source_file_path), this->_src_files.size(), bz::vector<bz::u8string>(), false
+		std::move(source_file_path), this->_src_files.size(), bz::vector<uint32_t>(), false
 	);
+	this->_source_file_ids.push_back(file._file_id);
 	if (!file.parse_global_symbols(*this))
 	{
 		return false;
@@ -1412,7 +1620,39 @@ void global_context::report_and_clear_errors_and_warnings(void)
 		}
 	}
 
-	return true;
+	// resolving a library function can require more of them, so the size is checked in every iteration
+	for (size_t i = 0; i < this->_required_library_functions.size(); ++i)
+	{
+		auto &func_body = *this->_required_library_functions[i];
+		auto &file = this->get_src_file(func_body.src_tokens.pivot->get_file_id());
+
+		parse_context context(*this);
+		context.current_global_scope = &file._global_scope;
+
+		context.add_to_resolve_queue({}, func_body);
+		resolve::resolve_function({}, func_body, context);
+		context.pop_resolve_queue();
+		for (size_t j = 0; j < context.generic_functions.size(); ++j)
+		{
+			context.add_to_resolve_queue({}, *context.generic_functions[j]);
+			resolve::resolve_function({}, *context.generic_functions[j], context);
+			context.pop_resolve_queue();
+		}
+	}
+
+	for (auto const func_body : this->_deferred_library_functions)
+	{
+		if (func_body->state == ast::resolve_state::symbol)
+		{
+			global_data::library_function_skipped_count += 1;
+		}
+		else
+		{
+			global_data::library_function_resolved_count += 1;
+		}
+	}
+
+	return !this->has_errors();
 }
 
 [[nodiscard]] bool global_context::initialize_backend(void)
@@ -1426,8 +1666,25 @@ void global_context::report_and_clear_errors_and_warnings(void)
 	return this->backend_context != nullptr;
 }
 
-[[nodiscard]] bool global_context::generate_and_output_code(void)
+static bz::u8string get_default_output_path(bz::u8string_view source_file, bz::u8string_view file_extension)
 {
+	auto const slash_it = source_file.rfind_any("/\\");
+	auto const dot = source_file.rfind('.');
+	bz_assert(dot != bz::u8iterator{});
+	return bz::format(
+		"{}{}",
+		bz::u8string(
+			slash_it == bz::u8iterator{} ? source_file.begin() : slash_it + 1,
+			dot
+		),
+		file_extension
+	);
+}
+
+[[nodiscard]] bool global_context::generate_and_output_code(size_t source_file_index)
+{
+	bz_assert(source_file_index < this->_source_file_ids.size());
+	auto const file_id = this->_source_file_ids[source_file_index];
 	if (global_data::emit_file_type == emit_type::null)
 	{
 		return true;
@@ -1435,12 +1692,12 @@ void global_context::report_and_clear_errors_and_warnings(void)
 #ifndef NDEBUG
 	else if (global_data::debug_no_emit_file)
 	{
-		return this->backend_context->generate_and_output_code(*this, {});
+		return this->backend_context->generate_and_output_code(*this, file_id, {});
 	}
 #endif // !NDEBUG
 	else if (global_data::output_file_name != "")
 	{
-		return this->backend_context->generate_and_output_code(*this, global_data::output_file_name);
+		return this->backend_context->generate_and_output_code(*this, file_id, global_data::output_file_name);
 	}
 	else
 	{
@@ -1455,24 +1712,45 @@ void global_context::report_and_clear_errors_and_warnings(void)
 				return ".bc";
 			case emit_type::llvm_ir:
 				return ".ll";
+			case emit_type::thinlto_bc:
+				return ".bc";
 			case emit_type::null:
 				bz_unreachable;
 			}
 		}();
 
-		auto const slash_it = global_data::source_file.rfind_any("/\\");
-		auto const dot = global_data::source_file.rfind('.');
-		bz_assert(dot != bz::u8iterator{});
-		auto const output_path = bz::format(
-			"{}{}",
-			bz::u8string(
-				slash_it == bz::u8iterator{} ? global_data::source_file.begin() : slash_it + 1,
-				dot
-			),
-			file_extension
-		);
-		return this->backend_context->generate_and_output_code(*this, output_path);
+		auto const output_path = get_default_output_path(global_data::source_files[source_file_index], file_extension);
+		return this->backend_context->generate_and_output_code(*this, file_id, output_path);
 	}
 }
 
+[[nodiscard]] bool global_context::run_thinlto_backend(void)
+{
+	bz_assert(global_data::thinlto_backend);
+	bz_assert(global_data::emit_file_type == emit_type::obj);
+
+	this->backend_context = codegen::create_backend_context(*this);
+	if (this->backend_context == nullptr)
+	{
+		return false;
+	}
+
+	bz::vector<bz::u8string> output_files;
+	output_files.reserve(global_data::source_files.size());
+	if (global_data::output_file_name != "")
+	{
+		bz_assert(global_data::source_files.size() == 1);
+		output_files.push_back(global_data::output_file_name);
+	}
+	else
+	{
+		for (auto const &source_file : global_data::source_files)
+		{
+			output_files.push_back(get_default_output_path(source_file, ".o"));
+		}
+	}
+
+	return this->backend_context->run_thinlto_backend(*this, global_data::source_files, output_files);
+}
+
 } // namespace ctx
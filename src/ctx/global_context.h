@@ -4,6 +4,7 @@
 #include "core.h"
 
 #include <bz/enum_array.h>
+#include <unordered_set>
 
 #include "context_forward.h"
 #include "lex/token.h"
@@ -19,6 +20,9 @@
 #include "codegen/target.h"
 #include "codegen/backend_context.h"
 
+struct src_file_prefetcher;
+struct timer;
+
 namespace ctx
 {
 
@@ -148,6 +152,8 @@ struct global_context
 {
 	static constexpr uint32_t compiler_file_id     = std::numeric_limits<uint32_t>::max();
 	static constexpr uint32_t command_line_file_id = std::numeric_limits<uint32_t>::max() - 1;
+	// used for files that are tokenized before they are given a file id
+	static constexpr uint32_t prefetch_file_id     = std::numeric_limits<uint32_t>::max() - 2;
 
 	decl_list         _compile_decls;
 	bz::vector<error> _errors;
@@ -169,12 +175,19 @@ struct global_context
 
 	ast::function_body *_main = nullptr;
 
+	// bodies of library functions that are only resolved if they are used, unless '--check-library' is given
+	bz::vector<ast::function_body *> _deferred_library_functions;
+	// used library functions with unresolved bodies, these are resolved at the end of global_context::parse
+	bz::vector<ast::function_body *> _required_library_functions;
+	std::unordered_set<ast::function_body *> _required_library_functions_set;
+
 	bz::vector<fs::path> _import_dirs;
 	bz::vector<std::unique_ptr<src_file>> _src_files;
+	// file ids of the source files given on the command line, each one is compiled into a separate output file
+	bz::vector<uint32_t> _source_file_ids;
 	std::unordered_map<fs::path, src_file *> _src_files_map;
 
-	bz::vector<std::unique_ptr<char[]>> _src_scope_fragments;
-	bz::vector<bz::vector<bz::u8string_view>> _src_scopes_storage;
+	bz::vector<bz::vector<uint32_t>> _src_scopes_storage;
 
 	bz::vector<bz::fixed_vector<char>>                 constant_string_storage;
 	bz::vector<ast::arena_vector<ast::constant_value>> constant_aggregate_storage;
@@ -190,6 +203,11 @@ struct global_context
 	codegen::target_triple target_triple;
 	std::unique_ptr<comptime::codegen_context> comptime_codegen_context;
 	std::unique_ptr<codegen::backend_context> backend_context;
+	// the timer of the compilation with '--profile', used to time the stages of code generation
+	timer *profile_timer = nullptr;
+
+	// declared last, so the worker threads are stopped before anything else is destroyed
+	std::unique_ptr<src_file_prefetcher> _src_file_prefetcher;
 
 	global_context(void);
 	global_context(global_context const &) = delete;
@@ -208,13 +226,13 @@ struct global_context
 
 	src_file *get_src_file(fs::path const &file_path);
 
-	bz::array_view<bz::u8string_view const> get_scope_in_persistent_storage(bz::array_view<bz::u8string const> scope);
+	bz::array_view<uint32_t const> get_scope_in_persistent_storage(bz::array_view<uint32_t const> scope);
 
 	ast::type_info *get_builtin_type_info(uint32_t kind) const;
 	ast::type_info *get_usize_type_info(void) const;
 	ast::type_info *get_isize_type_info(void) const;
 	ast::decl_function *get_builtin_function(uint32_t kind);
-	bz::array_view<uint32_t const> get_builtin_universal_functions(bz::u8string_view id);
+	bz::array_view<uint32_t const> get_builtin_universal_functions(uint32_t id);
 	resolve::attribute_info_t *get_builtin_attribute(bz::u8string_view name);
 	ast::decl_operator *get_builtin_operator(uint32_t op_kind, uint8_t expr_type_kind);
 	ast::decl_operator *get_builtin_operator(uint32_t op_kind, uint8_t lhs_type_kind, uint8_t rhs_type_kind);
@@ -248,6 +266,7 @@ struct global_context
 	std::pair<char_pos, char_pos> get_file_begin_and_end(uint32_t file_id) const noexcept;
 
 	bool is_library_file(uint32_t file_id) const noexcept;
+	uint32_t get_compilation_unit_file_id(uint32_t file_id) const noexcept;
 
 	bool has_errors(void) const;
 	bool has_warnings(void) const;
@@ -269,15 +288,19 @@ struct global_context
 
 	void add_compile_variable(ast::decl_variable &var_decl);
 	void add_compile_function(ast::function_body &func_body);
+	void add_deferred_library_function(ast::function_body &func_body);
+	void require_function_body(ast::function_body &func_body);
 	void add_compile_struct(ast::decl_struct &struct_decl);
 
 	struct module_info_t
 	{
 		uint32_t id;
-		bz::array_view<bz::u8string_view const> scope;
+		bz::array_view<uint32_t const> scope;
 	};
 
 	bz::vector<module_info_t> add_module(uint32_t current_file_id, ast::identifier const &id);
+	void prefetch_module(uint32_t current_file_id, ast::identifier const &id);
+	bz::optional<tokenized_file_t> get_prefetched_file(fs::path const &file_path);
 	ast::scope_t &get_file_global_scope(uint32_t file_id);
 
 	bz::u8string get_file_name(uint32_t file_id);
@@ -309,10 +332,11 @@ struct global_context
 	[[nodiscard]] bool parse_command_line(int argc, char const * const*argv);
 	[[nodiscard]] bool initialize_target_info(void);
 	[[nodiscard]] bool initialize_builtins(void);
-	[[nodiscard]] bool parse_global_symbols(void);
+	[[nodiscard]] bool parse_global_symbols(size_t source_file_index);
 	[[nodiscard]] bool parse(void);
 	[[nodiscard]] bool initialize_backend(void);
-	[[nodiscard]] bool generate_and_output_code(void);
+	[[nodiscard]] bool generate_and_output_code(size_t source_file_index);
+	[[nodiscard]] bool run_thinlto_backend(void);
 };
 
 } // namespace ctx
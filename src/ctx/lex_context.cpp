@@ -4,10 +4,31 @@
 namespace ctx
 {
 
-// void lex_context::report_error(error &&err)
-// {
-// 	this->global_ctx.report_error(std::move(err));
-// }
+void lex_context::report_error(error &&err) const
+{
+	this->has_diagnostics = true;
+	if (this->deferred_errors != nullptr)
+	{
+		this->deferred_errors->push_back(std::move(err));
+	}
+	else
+	{
+		this->global_ctx.report_error(std::move(err));
+	}
+}
+
+void lex_context::report_warning(error &&err) const
+{
+	this->has_diagnostics = true;
+	if (this->deferred_errors != nullptr)
+	{
+		this->deferred_errors->push_back(std::move(err));
+	}
+	else
+	{
+		this->global_ctx.report_warning(std::move(err));
+	}
+}
 
 void lex_context::bad_char(
 	file_iterator const &stream,
@@ -15,7 +36,7 @@ void lex_context::bad_char(
 	bz::vector<source_highlight> notes, bz::vector<source_highlight> suggestions
 ) const
 {
-	this->global_ctx.report_error(error{
+	this->report_error(error{
 		warning_kind::_last,
 		{
 			stream.file_id, stream.line,
@@ -34,7 +55,7 @@ void lex_context::bad_char(
 	bz::vector<source_highlight> notes, bz::vector<source_highlight> suggestions
 ) const
 {
-	this->global_ctx.report_error(ctx::error{
+	this->report_error(ctx::error{
 		warning_kind::_last,
 		{
 			stream.file_id, stream.line,
@@ -53,7 +74,7 @@ void lex_context::bad_chars(
 	bz::vector<source_highlight> notes, bz::vector<source_highlight> suggestions
 ) const
 {
-	this->global_ctx.report_error(ctx::error{
+	this->report_error(ctx::error{
 		warning_kind::_last,
 		{
 			file_id, line,
@@ -71,7 +92,7 @@ void lex_context::bad_eof(
 	bz::vector<source_highlight> notes, bz::vector<source_highlight> suggestions
 ) const
 {
-	this->global_ctx.report_error(ctx::error{
+	this->report_error(ctx::error{
 		warning_kind::_last,
 		{
 			stream.file_id, stream.line,
@@ -91,7 +112,7 @@ void lex_context::report_warning(
 	bz::vector<source_highlight> notes, bz::vector<source_highlight> suggestions
 ) const
 {
-	this->global_ctx.report_warning(ctx::error{
+	this->report_warning(ctx::error{
 		kind,
 		{
 			file_id, line,
@@ -111,7 +132,7 @@ void lex_context::report_warning(
 	bz::vector<source_highlight> notes, bz::vector<source_highlight> suggestions
 ) const
 {
-	this->global_ctx.report_warning(ctx::error{
+	this->report_warning(ctx::error{
 		kind,
 		{
 			file_id, line,
@@ -13,12 +13,25 @@ namespace ctx
 struct lex_context
 {
 	global_context &global_ctx;
+	// if not null, errors and warnings are collected here instead of being reported to global_ctx,
+	// which allows tokenizing files on a separate thread
+	bz::vector<error> *deferred_errors = nullptr;
+	// set even if the reported warning is disabled, so that tokens are only cached if
+	// they would produce no diagnostics with any set of command line options
+	mutable bool has_diagnostics = false;
 
 	lex_context(global_context &_global_ctx)
 		: global_ctx(_global_ctx)
 	{}
 
-//	void report_error(error &&err);
+	lex_context(global_context &_global_ctx, bz::vector<error> &_deferred_errors)
+		: global_ctx(_global_ctx),
+		  deferred_errors(&_deferred_errors)
+	{}
+
+	void report_error(error &&err) const;
+	void report_warning(error &&err) const;
+
 	void bad_char(
 		file_iterator const &stream,
 		bz::u8string message,
@@ -165,7 +165,7 @@ ast::decl_operator *parse_context::get_builtin_operator(uint32_t op_kind, uint8_
 	return this->global_ctx.get_builtin_operator(op_kind, lhs_type_kind, rhs_type_kind);
 }
 
-bz::array_view<uint32_t const> parse_context::get_builtin_universal_functions(bz::u8string_view id)
+bz::array_view<uint32_t const> parse_context::get_builtin_universal_functions(uint32_t id)
 {
 	return this->global_ctx.get_builtin_universal_functions(id);
 }
@@ -418,7 +418,7 @@ void parse_context::pop_local_scope(bool report_unused) noexcept
 		auto const &symbols = this->current_local_scope.scope->get_local().symbols.slice(0, this->current_local_scope.symbol_count);
 		for (auto const var_decl : var_decl_range(symbols))
 		{
-			if (!var_decl->is_used() && !var_decl->is_maybe_unused() && var_decl->get_id().values.not_empty())
+			if (!var_decl->is_used() && !var_decl->is_maybe_unused() && var_decl->get_id().ids.not_empty())
 			{
 				this->report_warning(
 					warning_kind::unused_variable,
@@ -747,7 +747,7 @@ static ast::arena_vector<ast::generic_required_from_t> get_generic_requirements(
 
 void parse_context::report_error(lex::token_pos it) const
 {
-	this->report_error(it, bz::format("unexpected token '{}'", it->value));
+	this->report_error(it, bz::format("unexpected token '{}'", it->get_value()));
 }
 
 void parse_context::report_error(
@@ -769,8 +769,8 @@ void parse_context::report_error(
 	this->global_ctx.report_error(error{
 		warning_kind::_last,
 		{
-			src_tokens.pivot->src_pos.file_id, src_tokens.pivot->src_pos.line,
-			src_tokens.begin->src_pos.begin, src_tokens.pivot->src_pos.begin, (src_tokens.end - 1)->src_pos.end,
+			src_tokens.pivot->get_file_id(), src_tokens.pivot->get_line(),
+			src_tokens.begin->get_begin(), src_tokens.pivot->get_begin(), (src_tokens.end - 1)->get_end(),
 			suggestion_range{}, suggestion_range{},
 			std::move(message),
 		},
@@ -798,19 +798,19 @@ void parse_context::report_paren_match_error(
 		case lex::token::paren_open:
 			return it->kind == lex::token::eof
 				? bz::u8string("expected closing ) before end-of-file")
-				: bz::format("expected closing ) before '{}'", it->value);
+				: bz::format("expected closing ) before '{}'", it->get_value());
 		case lex::token::square_open:
 			return it->kind == lex::token::eof
 				? bz::u8string("expected closing ] before end-of-file")
-				: bz::format("expected closing ] before '{}'", it->value);
+				: bz::format("expected closing ] before '{}'", it->get_value());
 		case lex::token::curly_open:
 			return it->kind == lex::token::eof
 				? bz::u8string("expected closing } before end-of-file")
-				: bz::format("expected closing } before '{}'", it->value);
+				: bz::format("expected closing } before '{}'", it->get_value());
 		case lex::token::angle_open:
 			return it->kind == lex::token::eof
 				? bz::u8string("expected closing > before end-of-file")
-				: bz::format("expected closing > before '{}'", it->value);
+				: bz::format("expected closing > before '{}'", it->get_value());
 		default:
 			bz_unreachable;
 		}
@@ -1008,8 +1008,8 @@ void parse_context::report_warning(
 	this->global_ctx.report_warning(error{
 		kind,
 		{
-			src_tokens.pivot->src_pos.file_id, src_tokens.pivot->src_pos.line,
-			src_tokens.begin->src_pos.begin, src_tokens.pivot->src_pos.begin, (src_tokens.end - 1)->src_pos.end,
+			src_tokens.pivot->get_file_id(), src_tokens.pivot->get_line(),
+			src_tokens.begin->get_begin(), src_tokens.pivot->get_begin(), (src_tokens.end - 1)->get_end(),
 			suggestion_range{}, suggestion_range{},
 			std::move(message),
 		},
@@ -1068,8 +1068,8 @@ void parse_context::report_parenthesis_suppressed_warning(
 [[nodiscard]] source_highlight parse_context::make_note(lex::token_pos it, bz::u8string message)
 {
 	return source_highlight{
-		it->src_pos.file_id, it->src_pos.line,
-		it->src_pos.begin, it->src_pos.begin, it->src_pos.end,
+		it->get_file_id(), it->get_line(),
+		it->get_begin(), it->get_begin(), it->get_end(),
 		{}, {},
 		std::move(message)
 	};
@@ -1078,8 +1078,8 @@ void parse_context::report_parenthesis_suppressed_warning(
 [[nodiscard]] source_highlight parse_context::make_note(lex::src_tokens const &src_tokens, bz::u8string message)
 {
 	return source_highlight{
-		src_tokens.pivot->src_pos.file_id, src_tokens.pivot->src_pos.line,
-		src_tokens.begin->src_pos.begin, src_tokens.pivot->src_pos.begin, (src_tokens.end - 1)->src_pos.end,
+		src_tokens.pivot->get_file_id(), src_tokens.pivot->get_line(),
+		src_tokens.begin->get_begin(), src_tokens.pivot->get_begin(), (src_tokens.end - 1)->get_end(),
 		{}, {},
 		std::move(message)
 	};
@@ -1091,8 +1091,8 @@ void parse_context::report_parenthesis_suppressed_warning(
 )
 {
 	return source_highlight{
-		it->src_pos.file_id, it->src_pos.line,
-		it->src_pos.begin, it->src_pos.begin, it->src_pos.end,
+		it->get_file_id(), it->get_line(),
+		it->get_begin(), it->get_begin(), it->get_end(),
 		{ char_pos(), char_pos(), suggestion_pos, std::move(suggestion_str) },
 		{},
 		std::move(message)
@@ -1130,39 +1130,39 @@ void parse_context::report_parenthesis_suppressed_warning(
 		switch (it->kind)
 		{
 		case lex::token::paren_close:
-			if ((open_paren_it - 1)->kind == lex::token::paren_open && (open_paren_it - 1)->src_pos.end == open_paren_it->src_pos.begin)
+			if ((open_paren_it - 1)->kind == lex::token::paren_open && (open_paren_it - 1)->get_end() == open_paren_it->get_begin())
 			{
-				return std::make_pair(it->src_pos.begin, it->src_pos.line);
+				return std::make_pair(it->get_begin(), it->get_line());
 			}
 			else
 			{
-				return std::make_pair((it - 1)->src_pos.end, (it - 1)->src_pos.line);
+				return std::make_pair((it - 1)->get_end(), (it - 1)->get_line());
 			}
 		case lex::token::square_close:
-			if ((open_paren_it - 1)->kind == lex::token::square_open && (open_paren_it - 1)->src_pos.end == open_paren_it->src_pos.begin)
+			if ((open_paren_it - 1)->kind == lex::token::square_open && (open_paren_it - 1)->get_end() == open_paren_it->get_begin())
 			{
-				return std::make_pair(it->src_pos.begin, it->src_pos.line);
+				return std::make_pair(it->get_begin(), it->get_line());
 			}
 			else
 			{
-				return std::make_pair((it - 1)->src_pos.end, (it - 1)->src_pos.line);
+				return std::make_pair((it - 1)->get_end(), (it - 1)->get_line());
 			}
 		case lex::token::angle_close:
-			if ((open_paren_it - 1)->kind == lex::token::angle_open && (open_paren_it - 1)->src_pos.end == open_paren_it->src_pos.begin)
+			if ((open_paren_it - 1)->kind == lex::token::angle_open && (open_paren_it - 1)->get_end() == open_paren_it->get_begin())
 			{
-				return std::make_pair(it->src_pos.begin, it->src_pos.line);
+				return std::make_pair(it->get_begin(), it->get_line());
 			}
 			else
 			{
-				return std::make_pair((it - 1)->src_pos.end, (it - 1)->src_pos.line);
+				return std::make_pair((it - 1)->get_end(), (it - 1)->get_line());
 			}
 		case lex::token::semi_colon:
-			return std::make_pair(it->src_pos.begin, it->src_pos.line);
+			return std::make_pair(it->get_begin(), it->get_line());
 		default:
-			return std::make_pair((it - 1)->src_pos.end, (it - 1)->src_pos.line);
+			return std::make_pair((it - 1)->get_end(), (it - 1)->get_line());
 		}
 	}();
-	auto const open_paren_line = open_paren_it->src_pos.line;
+	auto const open_paren_line = open_paren_it->get_line();
 	bz_assert(open_paren_line <= suggested_paren_line);
 	if (suggested_paren_line - open_paren_line > 1)
 	{
@@ -1184,9 +1184,9 @@ void parse_context::report_parenthesis_suppressed_warning(
 	if (src_tokens.pivot == nullptr)
 	{
 		return source_highlight{
-			it->src_pos.file_id, it->src_pos.line,
+			it->get_file_id(), it->get_line(),
 			char_pos(), char_pos(), char_pos(),
-			{ char_pos(), char_pos(), it->src_pos.begin, std::move(suggestion) },
+			{ char_pos(), char_pos(), it->get_begin(), std::move(suggestion) },
 			{},
 			std::move(message)
 		};
@@ -1194,9 +1194,9 @@ void parse_context::report_parenthesis_suppressed_warning(
 	else
 	{
 		return source_highlight{
-			src_tokens.pivot->src_pos.file_id, src_tokens.pivot->src_pos.line,
-			src_tokens.begin->src_pos.begin, src_tokens.pivot->src_pos.begin, (src_tokens.end - 1)->src_pos.end,
-			{ char_pos(), char_pos(), it->src_pos.begin, std::move(suggestion) },
+			src_tokens.pivot->get_file_id(), src_tokens.pivot->get_line(),
+			src_tokens.begin->get_begin(), src_tokens.pivot->get_begin(), (src_tokens.end - 1)->get_end(),
+			{ char_pos(), char_pos(), it->get_begin(), std::move(suggestion) },
 			{},
 			std::move(message)
 		};
@@ -1214,20 +1214,20 @@ void parse_context::report_parenthesis_suppressed_warning(
 	if (src_tokens.pivot == nullptr)
 	{
 		return source_highlight{
-			begin->src_pos.file_id, begin->src_pos.line,
+			begin->get_file_id(), begin->get_line(),
 			char_pos(), char_pos(), char_pos(),
-			{ char_pos(), char_pos(), begin->src_pos.begin, std::move(first_suggestion) },
-			{ char_pos(), char_pos(), (end - 1)->src_pos.end, std::move(second_suggestion) },
+			{ char_pos(), char_pos(), begin->get_begin(), std::move(first_suggestion) },
+			{ char_pos(), char_pos(), (end - 1)->get_end(), std::move(second_suggestion) },
 			std::move(message)
 		};
 	}
 	else
 	{
 		return source_highlight{
-			src_tokens.pivot->src_pos.file_id, src_tokens.pivot->src_pos.line,
-			src_tokens.begin->src_pos.begin, src_tokens.pivot->src_pos.begin, (src_tokens.end - 1)->src_pos.end,
-			{ char_pos(), char_pos(), begin->src_pos.begin, std::move(first_suggestion) },
-			{ char_pos(), char_pos(), (end - 1)->src_pos.end, std::move(second_suggestion) },
+			src_tokens.pivot->get_file_id(), src_tokens.pivot->get_line(),
+			src_tokens.begin->get_begin(), src_tokens.pivot->get_begin(), (src_tokens.end - 1)->get_end(),
+			{ char_pos(), char_pos(), begin->get_begin(), std::move(first_suggestion) },
+			{ char_pos(), char_pos(), (end - 1)->get_end(), std::move(second_suggestion) },
 			std::move(message)
 		};
 	}
@@ -1242,9 +1242,9 @@ void parse_context::report_parenthesis_suppressed_warning(
 )
 {
 	return source_highlight{
-		it->src_pos.file_id, it->src_pos.line,
+		it->get_file_id(), it->get_line(),
 		char_pos(), char_pos(), char_pos(),
-		{ erase_begin, erase_end, it->src_pos.begin, std::move(suggestion_str) },
+		{ erase_begin, erase_end, it->get_begin(), std::move(suggestion_str) },
 		{},
 		std::move(message)
 	};
@@ -1261,10 +1261,10 @@ void parse_context::report_parenthesis_suppressed_warning(
 )
 {
 	return source_highlight{
-		first_it->src_pos.file_id, first_it->src_pos.line,
+		first_it->get_file_id(), first_it->get_line(),
 		char_pos(), char_pos(), char_pos(),
-		{ first_erase_begin, first_erase_end, first_it->src_pos.begin, std::move(first_suggestion_str) },
-		{ second_erase_begin, second_erase_end, second_it->src_pos.begin, std::move(second_suggestion_str) },
+		{ first_erase_begin, first_erase_end, first_it->get_begin(), std::move(first_suggestion_str) },
+		{ second_erase_begin, second_erase_end, second_it->get_begin(), std::move(second_suggestion_str) },
 		std::move(message)
 	};
 }
@@ -1277,9 +1277,9 @@ void parse_context::report_parenthesis_suppressed_warning(
 )
 {
 	return source_highlight{
-		it->src_pos.file_id, it->src_pos.line,
+		it->get_file_id(), it->get_line(),
 		char_pos(), char_pos(), char_pos(),
-		{ erase_begin, erase_end, it->src_pos.end, std::move(suggestion_str) },
+		{ erase_begin, erase_end, it->get_end(), std::move(suggestion_str) },
 		{},
 		std::move(message)
 	};
@@ -1296,10 +1296,10 @@ void parse_context::report_parenthesis_suppressed_warning(
 )
 {
 	return source_highlight{
-		first->src_pos.file_id, first->src_pos.line,
+		first->get_file_id(), first->get_line(),
 		char_pos(), char_pos(), char_pos(),
-		{ first_erase_begin, first_erase_end, first->src_pos.begin, std::move(first_suggestion_str) },
-		{ second_erase_begin, second_erase_end, (last - 1)->src_pos.end, std::move(last_suggestion_str) },
+		{ first_erase_begin, first_erase_end, first->get_begin(), std::move(first_suggestion_str) },
+		{ second_erase_begin, second_erase_end, (last - 1)->get_end(), std::move(last_suggestion_str) },
 		std::move(message)
 	};
 }
@@ -1361,7 +1361,7 @@ lex::token_pos parse_context::assert_token(lex::token_pos &stream, uint32_t kind
 
 void parse_context::report_ambiguous_id_error(lex::token_pos id) const
 {
-	this->report_error(id, bz::format("identifier '{}' is ambiguous", id->value));
+	this->report_error(id, bz::format("identifier '{}' is ambiguous", id->get_value()));
 }
 
 bool parse_context::has_main(void) const
@@ -1410,10 +1410,10 @@ void parse_context::remove_unresolved_scope(size_t prev_size)
 void parse_context::add_unresolved_local(ast::identifier const &id)
 {
 	bz_assert(!id.is_qualified);
-	if (id.values.not_empty())
+	if (id.ids.not_empty())
 	{
-		bz_assert(id.values.size() == 1);
-		this->current_unresolved_locals.push_back(id.values[0]);
+		bz_assert(id.ids.size() == 1);
+		this->current_unresolved_locals.push_back(id.ids[0]);
 	}
 }
 
@@ -1659,7 +1659,8 @@ struct function_overload_set_decls
 static ast::expression make_function_name_expression(
 	lex::src_tokens const &src_tokens,
 	ast::identifier id,
-	ast::decl_function *func_decl
+	ast::decl_function *func_decl,
+	parse_context &context
 )
 {
 	if (func_decl->body.is_generic())
@@ -1673,8 +1674,12 @@ static ast::expression make_function_name_expression(
 	}
 	else
 	{
+		// the function can be declared in a file that hasn't been parsed yet
+		context.add_to_resolve_queue(src_tokens, func_decl->body);
+		resolve::resolve_function_symbol(func_decl, func_decl->body, context);
+		context.pop_resolve_queue();
 		auto func_type = get_function_type(func_decl->body);
-		if (func_type.is_empty())
+		if (func_decl->body.state == ast::resolve_state::error || func_type.is_empty())
 		{
 			return ast::make_error_expression(
 				src_tokens,
@@ -1683,6 +1688,8 @@ static ast::expression make_function_name_expression(
 		}
 		else
 		{
+			// the function may be used as a function pointer without being called
+			context.global_ctx.require_function_body(func_decl->body);
 			return ast::make_constant_expression(
 				src_tokens,
 				ast::expression_type_kind::function_name, std::move(func_type),
@@ -1696,14 +1703,18 @@ static ast::expression make_function_name_expression(
 static ast::expression make_function_name_expression(
 	lex::src_tokens const &src_tokens,
 	ast::identifier id,
-	ast::decl_function_alias *alias_decl
+	ast::decl_function_alias *alias_decl,
+	parse_context &context
 )
 {
 	if (alias_decl->aliased_decls.size() == 1 && !alias_decl->aliased_decls[0]->body.is_generic())
 	{
 		auto const decl = alias_decl->aliased_decls[0];
+		context.add_to_resolve_queue(src_tokens, decl->body);
+		resolve::resolve_function_symbol(decl, decl->body, context);
+		context.pop_resolve_queue();
 		auto func_type = get_function_type(decl->body);
-		if (func_type.is_empty())
+		if (decl->body.state == ast::resolve_state::error || func_type.is_empty())
 		{
 			return ast::make_error_expression(
 				src_tokens,
@@ -1712,6 +1723,7 @@ static ast::expression make_function_name_expression(
 		}
 		else
 		{
+			context.global_ctx.require_function_body(decl->body);
 			return ast::make_constant_expression(
 				src_tokens,
 				ast::expression_type_kind::function_alias_name, std::move(func_type),
@@ -1734,18 +1746,19 @@ static ast::expression make_function_name_expression(
 static ast::expression make_function_name_expression(
 	lex::src_tokens const &src_tokens,
 	ast::identifier id,
-	function_overload_set_decls const &fn_set
+	function_overload_set_decls const &fn_set,
+	parse_context &context
 )
 {
 	if (fn_set.alias_decls.size() == 0 && fn_set.func_decls.size() == 1)
 	{
 		auto const decl = fn_set.func_decls[0];
-		return make_function_name_expression(src_tokens, std::move(id), decl);
+		return make_function_name_expression(src_tokens, std::move(id), decl, context);
 	}
 	else if (fn_set.alias_decls.size() == 1 && fn_set.func_decls.size() == 0)
 	{
 		auto const decl = fn_set.alias_decls[0];
-		return make_function_name_expression(src_tokens, std::move(id), decl);
+		return make_function_name_expression(src_tokens, std::move(id), decl, context);
 	}
 	else if (fn_set.alias_decls.size() == 0 && fn_set.func_decls.size() == 0)
 	{
@@ -1949,7 +1962,7 @@ static ast::expression expression_from_symbol(
 	case symbol_t::index_of<ast::decl_function *>:
 	{
 		auto const func_decl = symbol.get<ast::decl_function *>();
-		return make_function_name_expression(src_tokens, std::move(id), func_decl);
+		return make_function_name_expression(src_tokens, std::move(id), func_decl, context);
 	}
 	case symbol_t::index_of<ast::decl_function_alias *>:
 	{
@@ -1957,7 +1970,7 @@ static ast::expression expression_from_symbol(
 		context.add_to_resolve_queue(src_tokens, *alias_decl);
 		resolve::resolve_function_alias(*alias_decl, context);
 		context.pop_resolve_queue();
-		return make_function_name_expression(src_tokens, std::move(id), alias_decl);
+		return make_function_name_expression(src_tokens, std::move(id), alias_decl, context);
 	}
 	case symbol_t::index_of<function_overload_set_decls>:
 	{
@@ -1968,7 +1981,7 @@ static ast::expression expression_from_symbol(
 			resolve::resolve_function_alias(*alias_decl, context);
 			context.pop_resolve_queue();
 		}
-		return make_function_name_expression(src_tokens, std::move(id), func_set);
+		return make_function_name_expression(src_tokens, std::move(id), func_set, context);
 	}
 	case symbol_t::index_of<ast::decl_type_alias *>:
 	{
@@ -1990,28 +2003,24 @@ static ast::expression expression_from_symbol(
 	}
 }
 
-static bz::vector<source_highlight> get_ambiguous_notes(
-	ast::global_scope_symbol_list_t const &symbols,
-	bz::array_view<ast::global_scope_symbol_index_t const> ambiguous_ids
-)
+static bz::vector<source_highlight> get_ambiguous_notes(bz::array_view<ast::global_scope_symbol_t const> ambiguous_symbols)
 {
 	auto notes = bz::vector<source_highlight>();
-	notes.reserve(ambiguous_ids.size());
-	for (auto const [kind, index] : ambiguous_ids)
+	notes.reserve(ambiguous_symbols.size());
+	for (auto const &symbol : ambiguous_symbols)
 	{
-		switch (kind)
+		switch (symbol.symbol_kind)
 		{
 		case ast::global_scope_symbol_kind::function_set:
 		{
-			auto const &set = symbols.function_sets[index];
-			for (auto const func_decl : set.func_decls)
+			for (auto const func_decl : symbol.get_func_decls())
 			{
 				notes.push_back(parse_context::make_note(
 					func_decl->body.src_tokens,
 					bz::format("it may refer to '{}'", func_decl->body.get_signature())
 				));
 			}
-			for (auto const alias_decl : set.alias_decls)
+			for (auto const alias_decl : symbol.get_alias_decls())
 			{
 				notes.push_back(parse_context::make_note(
 					alias_decl->src_tokens,
@@ -2022,7 +2031,7 @@ static bz::vector<source_highlight> get_ambiguous_notes(
 		}
 		case ast::global_scope_symbol_kind::variable:
 		{
-			auto const var_decl = symbols.variables[index];
+			auto const var_decl = symbol.symbols->variables[symbol.index];
 			notes.push_back(parse_context::make_note(
 				var_decl->src_tokens,
 				bz::format("it may refer to the variable '{}'", var_decl->get_id().format_as_unqualified())
@@ -2031,7 +2040,7 @@ static bz::vector<source_highlight> get_ambiguous_notes(
 		}
 		case ast::global_scope_symbol_kind::variadic_variable:
 		{
-			auto const &[var_decl, _] = symbols.variadic_variables[index];
+			auto const &[var_decl, _] = symbol.symbols->variadic_variables[symbol.index];
 			notes.push_back(parse_context::make_note(
 				var_decl->src_tokens,
 				bz::format("it may refer to the variable '{}'", var_decl->get_id().format_as_unqualified())
@@ -2040,7 +2049,7 @@ static bz::vector<source_highlight> get_ambiguous_notes(
 		}
 		case ast::global_scope_symbol_kind::type_alias:
 		{
-			auto const alias_decl = symbols.type_aliases[index];
+			auto const alias_decl = symbol.symbols->type_aliases[symbol.index];
 			notes.push_back(parse_context::make_note(
 				alias_decl->src_tokens,
 				bz::format("it may refer to the alias 'type {}'", alias_decl->id.format_as_unqualified())
@@ -2049,7 +2058,7 @@ static bz::vector<source_highlight> get_ambiguous_notes(
 		}
 		case ast::global_scope_symbol_kind::struct_:
 		{
-			auto const struct_decl = symbols.structs[index];
+			auto const struct_decl = symbol.symbols->structs[symbol.index];
 			notes.push_back(parse_context::make_note(
 				struct_decl->info.src_tokens,
 				bz::format("it may refer to the type 'struct {}'", struct_decl->id.format_as_unqualified())
@@ -2058,7 +2067,7 @@ static bz::vector<source_highlight> get_ambiguous_notes(
 		}
 		case ast::global_scope_symbol_kind::enum_:
 		{
-			auto const enum_decl = symbols.enums[index];
+			auto const enum_decl = symbol.symbols->enums[symbol.index];
 			notes.push_back(parse_context::make_note(
 				enum_decl->src_tokens,
 				bz::format("it may refer to the type 'enum {}'", enum_decl->id.format_as_unqualified())
@@ -2077,57 +2086,53 @@ static bz::vector<source_highlight> get_ambiguous_notes(
 template<bool only_export>
 static symbol_t find_id_in_global_scope(ast::global_scope_t &scope, ast::identifier const &id, parse_context &context)
 {
-	if (id.values.empty())
+	if (id.ids.empty())
 	{
 		return {};
 	}
 
-	auto &symbols = only_export ? scope.export_symbols : scope.all_symbols;
-
 	if (id.is_qualified && scope.parent.scope != nullptr)
 	{
 		// in this case the scope must be inside a struct, meaning the symbols can't be accessed with a qualified lookup
 		return {};
 	}
 
-	static_assert(sizeof (ast::global_scope_t) == 624 || sizeof (ast::global_scope_t) == 560);
+	static_assert(sizeof (ast::global_scope_t) == 712 || sizeof (ast::global_scope_t) == 632);
 	static_assert(symbol_t::variant_count == 8);
-	auto const [kind, index] = symbols.get_symbol_index_by_id(id);
-	switch (kind)
+	auto const [symbol, ambiguous_symbols] = only_export ? scope.find_export_by_id(id.ids) : scope.find_by_id(id.ids);
+	switch (symbol.symbol_kind)
 	{
 	case ast::global_scope_symbol_kind::function_set:
 	{
 		symbol_t result;
-		auto const &set = symbols.function_sets[index];
 		auto &decls = result.emplace<function_overload_set_decls>();
-		decls.func_decls.append(set.func_decls);
-		decls.alias_decls.append(set.alias_decls);
+		decls.func_decls.append(symbol.get_func_decls());
+		decls.alias_decls.append(symbol.get_alias_decls());
 		return result;
 	}
 	case ast::global_scope_symbol_kind::variable:
-		return symbols.variables[index];
+		return symbol.symbols->variables[symbol.index];
 	case ast::global_scope_symbol_kind::variadic_variable:
 	{
 		symbol_t result;
-		auto const &variadic_var_decl = symbols.variadic_variables[index];
+		auto const &variadic_var_decl = symbol.symbols->variadic_variables[symbol.index];
 		auto &decl_ref = result.emplace<ast::variadic_var_decl_ref>();
 		decl_ref.original_decl = variadic_var_decl.original_decl;
 		decl_ref.variadic_decls = variadic_var_decl.variadic_decls;
 		return result;
 	}
 	case ast::global_scope_symbol_kind::type_alias:
-		return symbols.type_aliases[index];
+		return symbol.symbols->type_aliases[symbol.index];
 	case ast::global_scope_symbol_kind::struct_:
-		return symbols.structs[index];
+		return symbol.symbols->structs[symbol.index];
 	case ast::global_scope_symbol_kind::enum_:
-		return symbols.enums[index];
+		return symbol.symbols->enums[symbol.index];
 	case ast::global_scope_symbol_kind::ambiguous:
 	{
-		auto const ambiguous_ids = symbols.get_ambiguous_symbols_by_id(id);
 		context.report_error(
 			lex::src_tokens::from_range(id.tokens),
 			bz::format("identifier '{}' is ambiguous", id.as_string()),
-			get_ambiguous_notes(symbols, ambiguous_ids)
+			get_ambiguous_notes(ambiguous_symbols)
 		);
 		return {};
 	}
@@ -2218,7 +2223,7 @@ ast::expression parse_context::make_identifier_expression(ast::identifier id)
 	// in case there's shadowing
 	auto const src_tokens = lex::src_tokens::from_range(id.tokens);
 
-	if (!id.is_qualified && id.values.size() == 1 && this->current_unresolved_locals.contains(id.values[0]))
+	if (!id.is_qualified && id.ids.size() == 1 && this->current_unresolved_locals.contains(id.ids[0]))
 	{
 		return ast::make_unresolved_expression(
 			src_tokens,
@@ -2250,9 +2255,9 @@ ast::expression parse_context::make_identifier_expression(ast::identifier id)
 
 	// builtin types
 	// qualification doesn't matter here, they act as globally defined types
-	if (id.values.size() == 1)
+	if (id.ids.size() == 1)
 	{
-		auto const id_value = id.values.front();
+		auto const id_value = id.get_value(0);
 		if (id_value == "void")
 		{
 			return ast::make_constant_expression(
@@ -2636,7 +2641,7 @@ ast::expression parse_context::make_literal(lex::token_pos literal) const
 	{
 	case lex::token::integer_literal:
 	{
-		auto const number_string = literal->value;
+		auto const number_string = literal->get_value();
 		auto [value, good] = parse_int<10>(number_string);
 
 		if (!good)
@@ -2649,7 +2654,7 @@ ast::expression parse_context::make_literal(lex::token_pos literal) const
 			value = 0;
 		}
 
-		auto const postfix = literal->postfix;
+		auto const postfix = literal->get_postfix();
 
 		return get_literal_expr(src_tokens, value, postfix, true, *this);
 	}
@@ -2658,7 +2663,7 @@ ast::expression parse_context::make_literal(lex::token_pos literal) const
 	case lex::token::bin_literal:
 	{
 		// number_string_ contains the leading 0x or 0X
-		auto const number_string_ = literal->value;
+		auto const number_string_ = literal->get_value();
 		bz_assert(number_string_.starts_with('0'));
 		auto const number_string = number_string_.substring(2);
 		auto [value, good] =
@@ -2672,16 +2677,16 @@ ast::expression parse_context::make_literal(lex::token_pos literal) const
 			value = 0;
 		}
 
-		auto const postfix = literal->postfix;
+		auto const postfix = literal->get_postfix();
 
 		return get_literal_expr(src_tokens, value, postfix, false, *this);
 	}
 	case lex::token::floating_point_literal:
 	{
-		bz::u8string number_string = literal->value;
+		bz::u8string number_string = literal->get_value();
 		number_string.erase('\'');
 
-		auto const postfix = literal->postfix;
+		auto const postfix = literal->get_postfix();
 		if (postfix == "f32")
 		{
 			auto const num = bz::parse_float(number_string);
@@ -2751,7 +2756,7 @@ ast::expression parse_context::make_literal(lex::token_pos literal) const
 	}
 	case lex::token::character_literal:
 	{
-		auto const char_string = literal->value;
+		auto const char_string = literal->get_value();
 		auto it = char_string.begin();
 		auto const value = get_character(it);
 		bz_assert(it == char_string.end());
@@ -2779,7 +2784,7 @@ ast::expression parse_context::make_literal(lex::token_pos literal) const
 			);
 		}
 
-		auto const postfix = literal->postfix;
+		auto const postfix = literal->get_postfix();
 		if (postfix != "")
 		{
 			this->report_error(literal, bz::format("unknown postfix '{}'", postfix));
@@ -2836,7 +2841,7 @@ ast::expression parse_context::make_string_literal(lex::token_pos const begin, l
 	auto it = begin;
 	auto const get_string_value = [](lex::token_pos token) -> bz::u8string {
 		bz::u8string result = "";
-		auto const value = token->value;
+		auto const value = token->get_value();
 		auto it = value.begin();
 		auto const end = value.end();
 
@@ -2860,7 +2865,7 @@ ast::expression parse_context::make_string_literal(lex::token_pos const begin, l
 	{
 		if (it->kind == lex::token::raw_string_literal)
 		{
-			result += it->value;
+			result += it->get_value();
 		}
 		else
 		{
@@ -2868,7 +2873,7 @@ ast::expression parse_context::make_string_literal(lex::token_pos const begin, l
 		}
 	}
 
-	auto const postfix = (end - 1)->postfix;
+	auto const postfix = (end - 1)->get_postfix();
 	if (postfix != "")
 	{
 		this->report_error({ begin, begin, end }, bz::format("unknown postfix '{}'", postfix));
@@ -2943,7 +2948,7 @@ ast::expression parse_context::make_tuple(lex::src_tokens const &src_tokens, ast
 ast::expression parse_context::make_unreachable(lex::token_pos t)
 {
 	auto const panic_fn_body = &this->get_builtin_function(ast::function_body::builtin_panic)->body;
-	auto message = bz::format("unreachable hit at {}:{}\n", this->global_ctx.get_file_name(t->src_pos.file_id), t->src_pos.line);
+	auto message = bz::format("unreachable hit at {}:{}\n", this->global_ctx.get_file_name(t->get_file_id()), t->get_line());
 	auto const src_tokens = lex::src_tokens::from_single_token(t);
 
 	ast::arena_vector<ast::expression> args = {};
@@ -3526,6 +3531,357 @@ static void expand_variadic_params(ast::arena_vector<ast::decl_variable> &params
 	}
 }
 
+static bool is_vector_intrinsic(uint32_t kind)
+{
+	return kind >= ast::function_body::vector_add && kind <= ast::function_body::vector_masked_store;
+}
+
+static bool is_valid_vector_element_type(uint32_t intrinsic_kind, ast::typespec_view elem_type)
+{
+	if (!elem_type.is<ast::ts_base_type>())
+	{
+		return false;
+	}
+
+	auto const kind = elem_type.get<ast::ts_base_type>().info->kind;
+	switch (intrinsic_kind)
+	{
+	case ast::function_body::vector_add:
+	case ast::function_body::vector_sub:
+	case ast::function_body::vector_mul:
+	case ast::function_body::vector_div:
+	case ast::function_body::vector_min:
+	case ast::function_body::vector_max:
+	case ast::function_body::vector_lt:
+	case ast::function_body::vector_gt:
+	case ast::function_body::vector_lte:
+	case ast::function_body::vector_gte:
+	case ast::function_body::vector_reduce_add:
+	case ast::function_body::vector_reduce_mul:
+	case ast::function_body::vector_reduce_min:
+	case ast::function_body::vector_reduce_max:
+		return ast::is_integer_kind(kind) || ast::is_floating_point_kind(kind);
+	case ast::function_body::vector_rem:
+		return ast::is_integer_kind(kind);
+	case ast::function_body::vector_shl:
+	case ast::function_body::vector_shr:
+		return ast::is_unsigned_integer_kind(kind);
+	case ast::function_body::vector_and:
+	case ast::function_body::vector_or:
+	case ast::function_body::vector_xor:
+	case ast::function_body::vector_reduce_and:
+	case ast::function_body::vector_reduce_or:
+	case ast::function_body::vector_reduce_xor:
+		return ast::is_unsigned_integer_kind(kind) || kind == ast::type_info::bool_;
+	case ast::function_body::vector_eq:
+	case ast::function_body::vector_neq:
+	case ast::function_body::vector_select:
+	case ast::function_body::vector_shuffle:
+	case ast::function_body::vector_masked_load:
+	case ast::function_body::vector_masked_store:
+		return ast::is_integer_kind(kind) || ast::is_floating_point_kind(kind) || kind == ast::type_info::bool_;
+	default:
+		bz_unreachable;
+	}
+}
+
+// checks the parts of the signatures of the vector intrinsics, that can't be expressed in __builtins.bz
+static bool check_vector_intrinsic_call(
+	lex::src_tokens const &src_tokens,
+	ast::function_body *body,
+	ast::arena_vector<ast::expression> &args,
+	ctx::parse_context &context
+)
+{
+	auto const func_name = body->function_name_or_operator_kind.get<ast::identifier>().format_as_unqualified();
+
+	// the element type is checked on the last vector parameter, the other ones must have the same type
+	bz_assert(body->params.not_empty());
+	auto const vector_param_index = body->intrinsic_kind == ast::function_body::vector_shuffle ? 0 : body->params.size() - 1;
+	auto const vector_type = body->params[vector_param_index].get_type().remove_any_mut();
+	bz_assert(vector_type.is<ast::ts_array>());
+	auto const &array_type = vector_type.get<ast::ts_array>();
+	if (!is_valid_vector_element_type(body->intrinsic_kind, array_type.elem_type))
+	{
+		context.report_error(
+			src_tokens,
+			bz::format("invalid element type '{}' in '{}'", array_type.elem_type, func_name)
+		);
+		return false;
+	}
+
+	switch (body->intrinsic_kind)
+	{
+	case ast::function_body::vector_shuffle:
+	{
+		bz_assert(args.size() == 2);
+		resolve::consteval_try_without_error(args[1], context);
+		if (!args[1].is_constant())
+		{
+			context.report_error(args[1].src_tokens, bz::format("indices in '{}' must be a constant expression", func_name));
+			return false;
+		}
+
+		auto const &indices_value = args[1].get_constant_value();
+		bz::vector<uint64_t> indices;
+		if (indices_value.is_uint_array())
+		{
+			indices.append(indices_value.get_uint_array());
+		}
+		else
+		{
+			bz_assert(indices_value.is_array());
+			for (auto const &index : indices_value.get_array())
+			{
+				indices.push_back(index.get_uint());
+			}
+		}
+
+		for (auto const [index, i] : indices.enumerate())
+		{
+			if (index >= array_type.size)
+			{
+				context.report_error(
+					args[1].src_tokens,
+					bz::format("index {} at position {} is out of bounds for a vector of size {} in '{}'", index, i, array_type.size, func_name)
+				);
+				return false;
+			}
+		}
+		return true;
+	}
+	case ast::function_body::vector_reduce_add:
+	case ast::function_body::vector_reduce_mul:
+	case ast::function_body::vector_reduce_min:
+	case ast::function_body::vector_reduce_max:
+	case ast::function_body::vector_reduce_and:
+	case ast::function_body::vector_reduce_or:
+	case ast::function_body::vector_reduce_xor:
+		return true;
+	case ast::function_body::vector_masked_load:
+	case ast::function_body::vector_masked_store:
+	{
+		bz_assert(body->params.size() == 3);
+		auto const ptr_type = body->params[0].get_type().remove_any_mut();
+		bz_assert(ptr_type.is<ast::ts_pointer>());
+		auto const pointed_type = ptr_type.get<ast::ts_pointer>().remove_any_mut();
+		if (pointed_type != array_type.elem_type)
+		{
+			context.report_error(
+				src_tokens,
+				bz::format("mismatched pointer type '{}' and vector type '{}' in '{}'", ptr_type, vector_type, func_name)
+			);
+			return false;
+		}
+
+		auto const mask_size = body->params[1].get_type().remove_any_mut().get<ast::ts_array>().size;
+		if (mask_size != array_type.size)
+		{
+			context.report_error(
+				src_tokens,
+				bz::format("mismatched mask size {} and vector size {} in '{}'", mask_size, array_type.size, func_name)
+			);
+			return false;
+		}
+		return true;
+	}
+	default:
+	{
+		bz_assert(body->params.size() >= 2);
+		auto const lhs_type = body->params[body->params.size() - 2].get_type().remove_any_mut();
+		if (lhs_type != vector_type)
+		{
+			context.report_error(
+				src_tokens,
+				bz::format("mismatched vector types '{}' and '{}' in '{}'", lhs_type, vector_type, func_name)
+			);
+			return false;
+		}
+
+		if (body->intrinsic_kind == ast::function_body::vector_select)
+		{
+			bz_assert(body->params.size() == 3);
+			auto const mask_size = body->params[0].get_type().remove_any_mut().get<ast::ts_array>().size;
+			if (mask_size != array_type.size)
+			{
+				context.report_error(
+					src_tokens,
+					bz::format("mismatched mask size {} and vector size {} in '{}'", mask_size, array_type.size, func_name)
+				);
+				return false;
+			}
+		}
+		return true;
+	}
+	}
+}
+
+static bool is_atomic_intrinsic(uint32_t kind)
+{
+	return kind >= ast::function_body::atomic_load && kind <= ast::function_body::atomic_fence;
+}
+
+static bool is_valid_atomic_value_type(uint32_t intrinsic_kind, ast::typespec_view value_type)
+{
+	if (value_type.is<ast::ts_pointer>() || value_type.is_optional_pointer())
+	{
+		return intrinsic_kind == ast::function_body::atomic_load
+			|| intrinsic_kind == ast::function_body::atomic_store
+			|| intrinsic_kind == ast::function_body::atomic_exchange
+			|| intrinsic_kind == ast::function_body::atomic_compare_exchange;
+	}
+	else if (!value_type.is<ast::ts_base_type>())
+	{
+		return false;
+	}
+
+	auto const kind = value_type.get<ast::ts_base_type>().info->kind;
+	switch (intrinsic_kind)
+	{
+	case ast::function_body::atomic_load:
+	case ast::function_body::atomic_store:
+	case ast::function_body::atomic_exchange:
+		return ast::is_integer_kind(kind) || ast::is_floating_point_kind(kind);
+	case ast::function_body::atomic_compare_exchange:
+	case ast::function_body::atomic_fetch_add:
+	case ast::function_body::atomic_fetch_sub:
+		return ast::is_integer_kind(kind);
+	case ast::function_body::atomic_fetch_and:
+	case ast::function_body::atomic_fetch_or:
+	case ast::function_body::atomic_fetch_xor:
+		return ast::is_unsigned_integer_kind(kind);
+	default:
+		bz_unreachable;
+	}
+}
+
+static bz::u8string_view get_memory_order_name(ast::memory_order order)
+{
+	switch (order)
+	{
+	case ast::memory_order::relaxed:
+		return "relaxed";
+	case ast::memory_order::acquire:
+		return "acquire";
+	case ast::memory_order::release:
+		return "release";
+	case ast::memory_order::acq_rel:
+		return "acq_rel";
+	case ast::memory_order::seq_cst:
+		return "seq_cst";
+	}
+	bz_unreachable;
+}
+
+static bool is_valid_memory_order(uint32_t intrinsic_kind, ast::memory_order order, bool is_failure_order)
+{
+	switch (intrinsic_kind)
+	{
+	case ast::function_body::atomic_load:
+		return order != ast::memory_order::release && order != ast::memory_order::acq_rel;
+	case ast::function_body::atomic_store:
+		return order != ast::memory_order::acquire && order != ast::memory_order::acq_rel;
+	case ast::function_body::atomic_compare_exchange:
+		return !is_failure_order || (order != ast::memory_order::release && order != ast::memory_order::acq_rel);
+	case ast::function_body::atomic_fence:
+		return order != ast::memory_order::relaxed;
+	default:
+		return true;
+	}
+}
+
+// memory orders that aren't constant expressions are allowed, in that case every valid memory order is handled
+// during code generation
+static bool check_memory_order_arg(
+	ast::expression &arg,
+	uint32_t intrinsic_kind,
+	bool is_failure_order,
+	bz::u8string_view func_name,
+	ctx::parse_context &context
+)
+{
+	resolve::consteval_try_without_error(arg, context);
+	if (!arg.is_constant())
+	{
+		return true;
+	}
+
+	auto const order_value = arg.get_constant_value().get_uint();
+	if (order_value > static_cast<uint32_t>(ast::memory_order::seq_cst))
+	{
+		context.report_error(arg.src_tokens, bz::format("invalid memory order {} in '{}'", order_value, func_name));
+		return false;
+	}
+
+	auto const order = static_cast<ast::memory_order>(order_value);
+	if (!is_valid_memory_order(intrinsic_kind, order, is_failure_order))
+	{
+		context.report_error(
+			arg.src_tokens,
+			is_failure_order
+				? bz::format("memory order '{}' can't be used as the failure order in '{}'", get_memory_order_name(order), func_name)
+				: bz::format("memory order '{}' can't be used in '{}'", get_memory_order_name(order), func_name)
+		);
+		return false;
+	}
+	return true;
+}
+
+// checks the parts of the signatures of the atomic intrinsics, that can't be expressed in __builtins.bz
+static bool check_atomic_intrinsic_call(
+	lex::src_tokens const &src_tokens,
+	ast::function_body *body,
+	ast::arena_vector<ast::expression> &args,
+	ctx::parse_context &context
+)
+{
+	auto const func_name = body->function_name_or_operator_kind.get<ast::identifier>().format_as_unqualified();
+
+	if (body->intrinsic_kind == ast::function_body::atomic_fence)
+	{
+		bz_assert(args.size() == 1);
+		return check_memory_order_arg(args[0], body->intrinsic_kind, false, func_name, context);
+	}
+
+	auto const ptr_type = body->params[0].get_type().remove_any_mut();
+	bz_assert(ptr_type.is<ast::ts_pointer>());
+	auto const object_type = ptr_type.get<ast::ts_pointer>().remove_any_mut();
+	if (!is_valid_atomic_value_type(body->intrinsic_kind, object_type))
+	{
+		context.report_error(
+			src_tokens,
+			bz::format("invalid value type '{}' in '{}'", object_type, func_name)
+		);
+		return false;
+	}
+
+	// every parameter between the pointer and the memory orders must have the same type as the pointed object
+	auto const order_param_count = body->intrinsic_kind == ast::function_body::atomic_compare_exchange ? 2 : 1;
+	for (auto const &param : body->params.slice(1, body->params.size() - order_param_count))
+	{
+		auto const param_type = param.get_type().remove_reference().remove_any_mut();
+		if (param_type != object_type)
+		{
+			context.report_error(
+				src_tokens,
+				bz::format("mismatched pointer type '{}' and value type '{}' in '{}'", ptr_type, param_type, func_name)
+			);
+			return false;
+		}
+	}
+
+	bz_assert(args.size() == body->params.size());
+	if (body->intrinsic_kind == ast::function_body::atomic_compare_exchange)
+	{
+		return check_memory_order_arg(args[args.size() - 2], body->intrinsic_kind, false, func_name, context)
+			&& check_memory_order_arg(args[args.size() - 1], body->intrinsic_kind, true, func_name, context);
+	}
+	else
+	{
+		return check_memory_order_arg(args.back(), body->intrinsic_kind, false, func_name, context);
+	}
+}
+
 static ast::expression make_expr_function_call_from_body(
 	lex::src_tokens const &src_tokens,
 	ast::function_body *body,
@@ -3582,6 +3938,7 @@ static ast::expression make_expr_function_call_from_body(
 	}
 	resolve::resolve_function_symbol({}, *body, context);
 	context.pop_resolve_queue();
+	context.global_ctx.require_function_body(*body);
 	if (body->state == ast::resolve_state::error)
 	{
 		return ast::make_error_expression(src_tokens, ast::make_expr_function_call(src_tokens, std::move(args), body, resolve_order));
@@ -3595,6 +3952,22 @@ static ast::expression make_expr_function_call_from_body(
 		);
 		return ast::make_error_expression(src_tokens, ast::make_expr_function_call(src_tokens, std::move(args), body, resolve_order));
 	}
+	else if (
+		body->is_intrinsic()
+		&& is_vector_intrinsic(body->intrinsic_kind)
+		&& !check_vector_intrinsic_call(src_tokens, body, args, context)
+	)
+	{
+		return ast::make_error_expression(src_tokens, ast::make_expr_function_call(src_tokens, std::move(args), body, resolve_order));
+	}
+	else if (
+		body->is_intrinsic()
+		&& is_atomic_intrinsic(body->intrinsic_kind)
+		&& !check_atomic_intrinsic_call(src_tokens, body, args, context)
+	)
+	{
+		return ast::make_error_expression(src_tokens, ast::make_expr_function_call(src_tokens, std::move(args), body, resolve_order));
+	}
 
 	if (body->is_intrinsic() && body->intrinsic_kind == ast::function_body::builtin_destruct_value)
 	{
@@ -3842,6 +4215,7 @@ static ast::expression make_expr_function_call_from_body(
 	}
 	resolve::resolve_function_symbol({}, *body, context);
 	context.pop_resolve_queue();
+	context.global_ctx.require_function_body(*body);
 	if (body->state == ast::resolve_state::error)
 	{
 		return ast::make_error_expression(src_tokens, ast::make_expr_function_call(src_tokens, std::move(args), body, resolve_order));
@@ -3874,29 +4248,44 @@ static void get_possible_funcs_for_operator_helper(
 	lex::src_tokens const &src_tokens,
 	uint32_t op,
 	ast::expression &expr,
-	bz::array_view<ast::operator_overload_set> operator_sets,
+	ast::global_scope_symbol_list_t const &symbols,
+	bz::array_view<ast::imported_symbol_list_t const> imported_symbols,
 	parse_context &context
 )
 {
-	auto const set_it = std::find_if(
-		operator_sets.begin(), operator_sets.end(),
-		[op](auto const &op_set) { return op_set.op == op; }
-	);
-	if (set_it == operator_sets.end())
+	auto const add_op_decls = [&](bz::array_view<ast::decl_operator * const> op_decls) {
+		for (auto const op_decl : op_decls)
+		{
+			if (!result.member<&possible_func_t::func_body>().contains(&op_decl->body))
+			{
+				auto match_level = resolve::get_function_call_match_level(op_decl, op_decl->body, expr, context, src_tokens);
+				result.push_back({ std::move(match_level), op_decl, &op_decl->body });
+			}
+		}
+	};
+
+	auto const set = symbols.get_operator_set(op);
+	if (set != nullptr)
 	{
-		return;
+		add_op_decls(set->op_decls);
 	}
 
-	for (auto const op_decl : set_it->op_decls)
+	// operator aliases are not imported
+	for (auto const &import : imported_symbols)
 	{
-		if (!result.member<&possible_func_t::func_body>().contains(&op_decl->body))
+		auto const import_set = import.symbols->get_operator_set(op);
+		if (import_set != nullptr)
 		{
-			auto match_level = resolve::get_function_call_match_level(op_decl, op_decl->body, expr, context, src_tokens);
-			result.push_back({ std::move(match_level), op_decl, &op_decl->body });
+			add_op_decls(import_set->op_decls);
 		}
 	}
 
-	for (auto const op_alias : set_it->alias_decls)
+	if (set == nullptr)
+	{
+		return;
+	}
+
+	for (auto const op_alias : set->alias_decls)
 	{
 		for (auto const decl : op_alias->aliased_decls)
 		{
@@ -3930,8 +4319,17 @@ static void get_possible_funcs_for_operator_helper(
 		else
 		{
 			bz_assert(scope.scope->is_global());
-			auto &symbols = only_export ? scope.scope->get_global().export_symbols : scope.scope->get_global().all_symbols;
-			get_possible_funcs_for_operator_helper(result, src_tokens, op, expr, symbols.operator_sets, context);
+			auto const &global_scope = scope.scope->get_global();
+			if constexpr (only_export)
+			{
+				get_possible_funcs_for_operator_helper(result, src_tokens, op, expr, global_scope.export_symbols, {}, context);
+			}
+			else
+			{
+				get_possible_funcs_for_operator_helper(
+					result, src_tokens, op, expr, global_scope.all_symbols, global_scope.imported_symbols, context
+				);
+			}
 			scope = scope.scope->get_global().parent;
 		}
 	}
@@ -4076,29 +4474,44 @@ static void get_possible_funcs_for_operator_helper(
 	uint32_t op,
 	ast::expression &lhs,
 	ast::expression &rhs,
-	bz::array_view<ast::operator_overload_set> operator_sets,
+	ast::global_scope_symbol_list_t const &symbols,
+	bz::array_view<ast::imported_symbol_list_t const> imported_symbols,
 	parse_context &context
 )
 {
-	auto const set_it = std::find_if(
-		operator_sets.begin(), operator_sets.end(),
-		[op](auto const &op_set) { return op_set.op == op; }
-	);
-	if (set_it == operator_sets.end())
+	auto const add_op_decls = [&](bz::array_view<ast::decl_operator * const> op_decls) {
+		for (auto const op_decl : op_decls)
+		{
+			if (!result.member<&possible_func_t::func_body>().contains(&op_decl->body))
+			{
+				auto match_level = resolve::get_function_call_match_level(op_decl, op_decl->body, lhs, rhs, context, src_tokens);
+				result.push_back({ std::move(match_level), op_decl, &op_decl->body });
+			}
+		}
+	};
+
+	auto const set = symbols.get_operator_set(op);
+	if (set != nullptr)
 	{
-		return;
+		add_op_decls(set->op_decls);
 	}
 
-	for (auto const op_decl : set_it->op_decls)
+	// operator aliases are not imported
+	for (auto const &import : imported_symbols)
 	{
-		if (!result.member<&possible_func_t::func_body>().contains(&op_decl->body))
+		auto const import_set = import.symbols->get_operator_set(op);
+		if (import_set != nullptr)
 		{
-			auto match_level = resolve::get_function_call_match_level(op_decl, op_decl->body, lhs, rhs, context, src_tokens);
-			result.push_back({ std::move(match_level), op_decl, &op_decl->body });
+			add_op_decls(import_set->op_decls);
 		}
 	}
 
-	for (auto const op_alias : set_it->alias_decls)
+	if (set == nullptr)
+	{
+		return;
+	}
+
+	for (auto const op_alias : set->alias_decls)
 	{
 		for (auto const decl : op_alias->aliased_decls)
 		{
@@ -4133,8 +4546,17 @@ static void get_possible_funcs_for_operator_helper(
 		else
 		{
 			bz_assert(scope.scope->is_global());
-			auto &symbols = only_export ? scope.scope->get_global().export_symbols : scope.scope->get_global().all_symbols;
-			get_possible_funcs_for_operator_helper(result, src_tokens, op, lhs, rhs, symbols.operator_sets, context);
+			auto const &global_scope = scope.scope->get_global();
+			if constexpr (only_export)
+			{
+				get_possible_funcs_for_operator_helper(result, src_tokens, op, lhs, rhs, global_scope.export_symbols, {}, context);
+			}
+			else
+			{
+				get_possible_funcs_for_operator_helper(
+					result, src_tokens, op, lhs, rhs, global_scope.all_symbols, global_scope.imported_symbols, context
+				);
+			}
 			scope = scope.scope->get_global().parent;
 		}
 	}
@@ -4817,18 +5239,14 @@ ast::expression parse_context::make_function_call_expression(
 static void get_possible_funcs_for_universal_function_call_helper(
 	ast::arena_vector<possible_func_t> &result,
 	lex::src_tokens const &src_tokens,
-	ast::identifier const &id,
 	bz::array_view<ast::expression> params,
-	ast::global_scope_symbol_list_t const &symbols,
+	ast::global_scope_symbol_t const &symbol,
 	parse_context &context
 )
 {
-	auto const [kind, index] = symbols.get_symbol_index_by_id(id);
-
-	if (kind == ast::global_scope_symbol_kind::function_set)
+	if (symbol.symbol_kind == ast::global_scope_symbol_kind::function_set)
 	{
-		auto const &func_set = symbols.function_sets[index];
-		for (auto const func : func_set.func_decls.filter(
+		for (auto const func : symbol.get_func_decls().filter(
 			[&result](auto const func) {
 				return !result.member<&possible_func_t::func_body>().contains(&func->body);
 			})
@@ -4838,7 +5256,7 @@ static void get_possible_funcs_for_universal_function_call_helper(
 			result.push_back({ std::move(match_level), func, &func->body });
 		}
 
-		for (auto const alias : func_set.alias_decls)
+		for (auto const alias : symbol.get_alias_decls())
 		{
 			context.add_to_resolve_queue(src_tokens, *alias);
 			resolve::resolve_function_alias(*alias, context);
@@ -4881,8 +5299,9 @@ static void get_possible_funcs_for_universal_function_call_helper(
 			bz_assert(scope.scope->is_global());
 			if (!id.is_qualified || scope.scope->get_global().parent.scope == nullptr)
 			{
-				auto &symbols = only_export ? scope.scope->get_global().export_symbols : scope.scope->get_global().all_symbols;
-				get_possible_funcs_for_universal_function_call_helper(result, src_tokens, id, params, symbols, context);
+				auto const &global_scope = scope.scope->get_global();
+				auto const [symbol, _] = only_export ? global_scope.find_export_by_id(id.ids) : global_scope.find_by_id(id.ids);
+				get_possible_funcs_for_universal_function_call_helper(result, src_tokens, params, symbol, context);
 			}
 			scope = scope.scope->get_global().parent;
 		}
@@ -4942,9 +5361,9 @@ static ast::arena_vector<possible_func_t> get_possible_funcs_for_universal_funct
 		}
 	}
 
-	if (id.values.size() == 1)
+	if (id.ids.size() == 1)
 	{
-		auto const kinds = context.get_builtin_universal_functions(id.values.front());
+		auto const kinds = context.get_builtin_universal_functions(id.ids.front());
 		for (auto const decl : kinds.transform([&](auto const kind) { return context.global_ctx.get_builtin_function(kind); }))
 		{
 			auto match_level = resolve::get_function_call_match_level(decl, decl->body, params, context, src_tokens);
@@ -5272,7 +5691,8 @@ ast::expression parse_context::make_cast_expression(
 	else if (expr.is_enum_literal())
 	{
 		auto const id = expr.get_enum_literal().id;
-		auto const id_value = id->value;
+		auto const id_value = id->get_value();
+		auto const identifier_id = id->get_identifier_id();
 		if (!type.is<ast::ts_enum>())
 		{
 			this->report_error(
@@ -5287,8 +5707,8 @@ ast::expression parse_context::make_cast_expression(
 
 		auto const it = std::find_if(
 			decl->values.begin(), decl->values.end(),
-			[id_value](auto const &value) {
-				return value.id->value == id_value;
+			[identifier_id](auto const &value) {
+				return value.id->get_identifier_id() == identifier_id;
 			}
 		);
 
@@ -5862,7 +6282,7 @@ ast::expression parse_context::make_member_access_expression(
 
 			if (symbol.is_null())
 			{
-				this->report_error(member, bz::format("no member named '{}' in type '{}'", member->value, type));
+				this->report_error(member, bz::format("no member named '{}' in type '{}'", member->get_value(), type));
 				return ast::make_error_expression(src_tokens, ast::make_expr_type_member_access(std::move(base), member, nullptr));
 			}
 			else
@@ -5874,17 +6294,15 @@ ast::expression parse_context::make_member_access_expression(
 		{
 			auto const decl = type.get<ast::ts_enum>().decl;
 			this->resolve_type(src_tokens, decl);
-			auto const member_value = member->value;
-
 			auto const result_it = std::find_if(
 				decl->values.begin(), decl->values.end(),
-				[member_value](auto const &value) {
-					return value.id->value == member_value;
+				[member_id = member->get_identifier_id()](auto const &value) {
+					return value.id->get_identifier_id() == member_id;
 				}
 			);
 			if (result_it == decl->values.end())
 			{
-				this->report_error(member, bz::format("no value named '{}' in enum '{}'", member->value, type));
+				this->report_error(member, bz::format("no value named '{}' in enum '{}'", member->get_value(), type));
 				return ast::make_error_expression(src_tokens, ast::make_expr_type_member_access(std::move(base), member, nullptr));
 			}
 			else
@@ -5903,7 +6321,7 @@ ast::expression parse_context::make_member_access_expression(
 		}
 		else
 		{
-			this->report_error(member, bz::format("no member named '{}' in type '{}'", member->value, type));
+			this->report_error(member, bz::format("no member named '{}' in type '{}'", member->get_value(), type));
 			return ast::make_error_expression(src_tokens, ast::make_expr_type_member_access(std::move(base), member, nullptr));
 		}
 	}
@@ -5942,13 +6360,13 @@ ast::expression parse_context::make_member_access_expression(
 	}();
 	auto const it = std::find_if(
 		members.begin(), members.end(),
-		[member_value = member->value](auto const member_variable) {
-			return member_value == member_variable->get_unqualified_id_value();
+		[member_id = member->get_identifier_id()](auto const member_variable) {
+			return member_id == member_variable->get_unqualified_id();
 		}
 	);
 	if (it == members.end())
 	{
-		this->report_error(member, bz::format("no member named '{}' in value of type '{}'", member->value, bare_base_type));
+		this->report_error(member, bz::format("no member named '{}' in value of type '{}'", member->get_value(), bare_base_type));
 		return ast::make_error_expression(src_tokens, ast::make_expr_member_access(std::move(base), 0));
 	}
 	else if (
@@ -5970,7 +6388,7 @@ ast::expression parse_context::make_member_access_expression(
 			}
 		}();
 		this->report_error(
-			member, bz::format("member '{}' in value of type '{}' is inaccessible in this context", member->value, bare_base_type),
+			member, bz::format("member '{}' in value of type '{}' is inaccessible in this context", member->get_value(), bare_base_type),
 			std::move(notes)
 		);
 		// no need to return here, the type of the member is available so the expression doesn't have to be in an error state
@@ -6003,7 +6421,7 @@ ast::expression parse_context::make_member_access_expression(
 			auto const dtor = base_type.get<ast::ts_base_type>().info->destructor;
 			this->report_error(
 				src_tokens,
-				bz::format("accessing member '{}' of an rvalue of type '{}' is not allowed", member->value, base_type),
+				bz::format("accessing member '{}' of an rvalue of type '{}' is not allowed", member->get_value(), base_type),
 				{ this->make_note(
 					dtor->body.src_tokens,
 					bz::format("type '{}' has a non-default destructor defined here", base_type)
@@ -8651,15 +9069,37 @@ ast::identifier parse_context::make_qualified_identifier(lex::token_pos id)
 {
 	ast::identifier result;
 	result.is_qualified = true;
-	result.values.push_back(id->value);
+	result.ids.push_back(id->get_identifier_id());
 	result.tokens = { id, id + 1 };
 	return result;
 }
 
+static void add_consteval_call_result_if_reusable(
+	comptime::codegen_context &codegen_context,
+	bz::optional<comptime::consteval_call_key_t> &call_key,
+	comptime::executor_context const &executor,
+	ast::constant_value const &result
+)
+{
+	if (call_key.has_value() && result.not_null() && executor.is_result_reusable && executor.diagnostics.empty())
+	{
+		codegen_context.add_consteval_call_result(std::move(call_key.get()), result);
+	}
+}
+
 ast::constant_value parse_context::execute_expression(ast::expression &expr)
 {
 	auto &codegen_context = this->global_ctx.get_codegen_context();
 
+	auto call_key = comptime::get_consteval_call_key(expr);
+	if (call_key.has_value())
+	{
+		if (auto const cached_result = codegen_context.get_consteval_call_result(call_key.get()); cached_result != nullptr)
+		{
+			return *cached_result;
+		}
+	}
+
 	auto const prev_context = codegen_context.parse_ctx;
 	codegen_context.parse_ctx = this;
 
@@ -8668,6 +9108,7 @@ ast::constant_value parse_context::execute_expression(ast::expression &expr)
 	auto executor = comptime::executor_context(&codegen_context);
 	auto result = executor.execute_expression(expr, func);
 	bz_assert(result.not_null() || executor.diagnostics.not_empty());
+	add_consteval_call_result_if_reusable(codegen_context, call_key, executor, result);
 
 	for (auto &diagnostic : executor.diagnostics)
 	{
@@ -8682,10 +9123,21 @@ ast::constant_value parse_context::execute_expression(ast::expression &expr)
 ast::constant_value parse_context::execute_expression_without_error(ast::expression &expr)
 {
 	auto &codegen_context = this->global_ctx.get_codegen_context();
+
+	auto call_key = comptime::get_consteval_call_key(expr);
+	if (call_key.has_value())
+	{
+		if (auto const cached_result = codegen_context.get_consteval_call_result(call_key.get()); cached_result != nullptr)
+		{
+			return *cached_result;
+		}
+	}
+
 	auto const func = comptime::generate_code_for_expression(expr, codegen_context);
 
 	auto executor = comptime::executor_context(&codegen_context);
 	auto result = executor.execute_expression(expr, func);
+	add_consteval_call_result_if_reusable(codegen_context, call_key, executor, result);
 
 	return result;
 }
@@ -52,7 +52,8 @@ struct parse_context
 
 	ast::scope_t                 *current_global_scope = nullptr;
 	ast::enclosing_scope_t        current_local_scope  = {};
-	bz::vector<bz::u8string_view> current_unresolved_locals = {};
+	// interned identifiers, see lex::intern_identifier
+	bz::vector<uint32_t> current_unresolved_locals = {};
 	ast::function_body           *current_function = nullptr;
 
 	struct move_scope_t
@@ -92,7 +93,7 @@ struct parse_context
 	ast::decl_function *get_builtin_function(uint32_t kind) const;
 	ast::decl_operator *get_builtin_operator(uint32_t op_kind, uint8_t expr_type_kind) const;
 	ast::decl_operator *get_builtin_operator(uint32_t op_kind, uint8_t lhs_type_kind, uint8_t rhs_type_kind) const;
-	bz::array_view<uint32_t const> get_builtin_universal_functions(bz::u8string_view id);
+	bz::array_view<uint32_t const> get_builtin_universal_functions(uint32_t id);
 	ast::type_prototype_set_t &get_type_prototype_set(void);
 
 	ast::constant_value add_constant_string(bz::u8string_view str) const;
@@ -141,7 +142,7 @@ struct parse_context
 	{
 		ast::scope_t *global_scope;
 		ast::enclosing_scope_t local_scope;
-		bz::vector<bz::u8string_view> unresolved_locals;
+		bz::vector<uint32_t> unresolved_locals;
 	};
 
 	[[nodiscard]] global_local_scope_pair_t push_global_scope(ast::scope_t *new_scope) noexcept;
@@ -23,6 +23,10 @@ bz::optional<emit_type> parse_emit_type(bz::u8string_view arg)
 	{
 		return emit_type::llvm_ir;
 	}
+	else if (config::backend_llvm && arg == "thinlto-bc")
+	{
+		return emit_type::thinlto_bc;
+	}
 	else if (arg == "null")
 	{
 		return emit_type::null;
@@ -91,3 +95,8 @@ void print_version_info(void)
 		bz::print("bozon {}\n", bozon_version);
 	}
 }
+
+bz::u8string_view get_compiler_version(void)
+{
+	return bozon_version;
+}
@@ -5,6 +5,8 @@
 #include "ctx/warnings.h"
 #include "codegen/optimizations.h"
 
+#include <chrono>
+
 enum class compilation_phase
 {
 	parse_command_line,
@@ -21,6 +23,7 @@ enum class emit_type
 	asm_,
 	llvm_bc,
 	llvm_ir,
+	thinlto_bc,
 	null,
 };
 
@@ -48,6 +51,36 @@ inline bz::optional<x86_asm_syntax_kind> parse_x86_asm_syntax(bz::u8string_view
 	}
 }
 
+enum class opt_pipeline_kind
+{
+	// only the module pipeline is run after bitcode emission
+	module,
+	// every function is simplified right after it's emitted, and only the module level optimizations are run later
+	eager,
+	// both of the above, the functions are simplified twice
+	full,
+};
+
+inline bz::optional<opt_pipeline_kind> parse_opt_pipeline(bz::u8string_view arg)
+{
+	if (arg == "module")
+	{
+		return opt_pipeline_kind::module;
+	}
+	else if (arg == "eager")
+	{
+		return opt_pipeline_kind::eager;
+	}
+	else if (arg == "full")
+	{
+		return opt_pipeline_kind::full;
+	}
+	else
+	{
+		return {};
+	}
+}
+
 enum class target_endianness_kind
 {
 	little,
@@ -79,12 +112,14 @@ inline bz::array<bool, ctx::warning_infos.size()> warnings{};
 inline bz::array<bool, ctx::warning_infos.size()> error_warnings{};
 
 inline bz::u8string output_file_name;
-inline bz::u8string source_file;
+inline bz::vector<bz::u8string> source_files;
 
 inline compilation_phase compile_until = compilation_phase::link;
 
 inline bool do_profile = false;
 inline bool no_main = false;
+inline bool thinlto_backend = false;
+inline bool check_library = false;
 #ifndef NDEBUG
 inline bool debug_ir_output = false;
 inline bool debug_comptime_print_functions = false;
@@ -102,9 +137,14 @@ inline bool discard_llvm_value_names = true;
 inline bool return_zero_on_error = false;
 inline bool freestanding = false;
 inline uint64_t target_pointer_size = 0;
+inline uint64_t codegen_units = 1;
 inline target_endianness_kind target_endianness = target_endianness_kind::little;
 
 inline bz::u8string target;
+inline bz::u8string target_cpu;
+inline bz::u8string target_features;
+inline bz::u8string profile_generate_dir;
+inline bz::u8string profile_use_file;
 extern emit_type emit_file_type;
 inline x86_asm_syntax_kind x86_asm_syntax = x86_asm_syntax_kind::att;
 
@@ -114,16 +154,46 @@ inline bool no_error_highlight = false;
 inline bz::vector<bz::u8string> import_dirs;
 inline bz::vector<bz::u8string> defines;
 inline bz::u8string stdlib_dir;
+inline bz::u8string module_cache_dir;
 
 inline size_t max_opt_iter_count = 1;
 inline uint32_t opt_level = 0;
 inline uint32_t size_opt_level = 0;
 inline uint32_t machine_code_opt_level = 0;
+inline opt_pipeline_kind opt_pipeline = opt_pipeline_kind::full;
+
+struct codegen_unit_profile_info_t
+{
+	size_t function_count;
+	std::chrono::nanoseconds duration;
+};
+
+inline bz::vector<codegen_unit_profile_info_t> codegen_unit_profile_infos;
+
+inline size_t library_function_resolved_count = 0;
+inline size_t library_function_skipped_count = 0;
+
+inline size_t consteval_call_cache_hit_count = 0;
+inline size_t consteval_call_cache_miss_count = 0;
+
+inline size_t module_cache_hit_count = 0;
+inline size_t module_cache_miss_count = 0;
+
+inline size_t source_token_count = 0;
+// time spent lexing source files or loading their tokens from the module cache, summed over all threads
+inline std::chrono::nanoseconds tokenization_time{};
+
+inline size_t comptime_heap_allocation_count = 0;
+inline size_t comptime_heap_free_count = 0;
+inline size_t comptime_max_live_heap_allocation_count = 0;
 
 #ifdef BOZON_PROFILE_COMPTIME
 inline size_t comptime_executed_instructions_count = 0;
 inline size_t comptime_emitted_instructions_count = 0;
+inline std::chrono::nanoseconds comptime_execution_time{};
+inline size_t comptime_execution_depth = 0;
 inline bool debug_comptime_print_instruction_counts = false;
+inline bool debug_comptime_switch_dispatch = false;
 #endif // BOZON_PROFILE_COMPTIME
 
 } // namespace global_data
@@ -132,5 +202,6 @@ bool is_warning_enabled(ctx::warning_kind kind) noexcept;
 bool is_warning_error(ctx::warning_kind kind) noexcept;
 
 void print_version_info(void);
+bz::u8string_view get_compiler_version(void);
 
 #endif // GLOBAL_DATA_H
@@ -7,6 +7,8 @@
 struct file_iterator
 {
 	ctx::char_pos it;
+	// token offsets are calculated relative to this
+	ctx::char_pos file_begin;
 	uint32_t file_id;
 	uint32_t line = 1;
 
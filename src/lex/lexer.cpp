@@ -10,6 +10,39 @@ static token get_next_token(
 	ctx::lex_context &context
 );
 
+static token make_token(
+	uint32_t kind,
+	bz::u8string_view value,
+	bz::u8string_view postfix,
+	ctx::char_pos begin_it,
+	ctx::char_pos end_it,
+	file_iterator const &stream
+)
+{
+	auto const begin = begin_it.data();
+	auto const end = end_it.data();
+	bz_assert(postfix.size() == 0 || postfix.data() + postfix.size() == end);
+	return token(
+		kind,
+		static_cast<uint32_t>(begin - stream.file_begin.data()),
+		static_cast<uint32_t>(end - begin),
+		static_cast<uint32_t>(value.data() - begin),
+		static_cast<uint32_t>((end - postfix.size()) - (value.data() + value.size())),
+		static_cast<uint32_t>(postfix.size())
+	);
+}
+
+static token make_token(
+	uint32_t kind,
+	bz::u8string_view value,
+	ctx::char_pos begin_it,
+	ctx::char_pos end_it,
+	file_iterator const &stream
+)
+{
+	return make_token(kind, value, bz::u8string_view(), begin_it, end_it, stream);
+}
+
 bz::vector<token> get_tokens(
 	bz::u8string_view file,
 	uint32_t file_id,
@@ -21,14 +54,93 @@ bz::vector<token> get_tokens(
 	// uncomment the commented out code in this function to check whether it's really good or not
 	tokens.reserve(file.size() / 4);
 	// auto const capacity_before = tokens.capacity();
-	file_iterator stream = { file.begin(), file_id };
+	file_iterator stream = { file.begin(), file.begin(), file_id };
 	auto const end = file.end();
 
+	// brackets are matched here, so the parser can skip over them without counting nesting levels
+	struct open_bracket_t
+	{
+		uint32_t index;
+		uint32_t line;
+	};
+	bz::vector<open_bracket_t> open_brackets = {};
+
+	auto const get_begin = [&](token const &t) {
+		return ctx::char_pos(file.data() + t.offset);
+	};
+	auto const get_end = [&](token const &t) {
+		return ctx::char_pos(file.data() + t.offset + t.length);
+	};
+	auto const report_unclosed_bracket = [&](open_bracket_t open, bz::u8string message) {
+		auto const &open_token = tokens[open.index];
+		auto const &t = tokens.back();
+		context.bad_chars(
+			file_id, stream.line,
+			get_begin(t), get_begin(t), get_end(t),
+			std::move(message),
+			{ context.make_note(
+				file_id, open.line,
+				get_begin(open_token), get_begin(open_token), get_end(open_token),
+				"to match this:"
+			) }
+		);
+	};
+
 	do
 	{
 		tokens.push_back(get_next_token(stream, end, context));
+		auto const index = static_cast<uint32_t>(tokens.size() - 1);
+		auto const kind = tokens.back().kind;
+		if (token::is_open_bracket(kind))
+		{
+			open_brackets.push_back({ index, stream.line });
+		}
+		else if (token::is_bracket(kind))
+		{
+			// if there's no opening bracket of the same kind, then the closing bracket is stray,
+			// otherwise the opening brackets after that one are unclosed
+			auto match_index = open_brackets.size();
+			while (match_index != 0 && token::get_closing_bracket(tokens[open_brackets[match_index - 1].index].kind) != kind)
+			{
+				--match_index;
+			}
+
+			if (match_index == 0)
+			{
+				context.bad_chars(
+					file_id, stream.line,
+					get_begin(tokens.back()), get_begin(tokens.back()), get_end(tokens.back()),
+					bz::format("stray {}", token_info[kind].token_value)
+				);
+				continue;
+			}
+			else if (match_index != open_brackets.size())
+			{
+				auto const open = open_brackets.back();
+				report_unclosed_bracket(open, bz::format(
+					"expected closing {} before {}",
+					token_info[token::get_closing_bracket(tokens[open.index].kind)].token_value,
+					get_token_name_for_message(kind)
+				));
+			}
+
+			auto const open = open_brackets[match_index - 1];
+			tokens[open.index].match_distance = index - open.index;
+			tokens.back().match_distance = index - open.index;
+			open_brackets.resize(match_index - 1);
+		}
 	} while (tokens.back().kind != token::eof);
 
+	// only the innermost unclosed bracket is reported, the outer ones would only add noise
+	if (open_brackets.not_empty())
+	{
+		auto const open = open_brackets.back();
+		report_unclosed_bracket(open, bz::format(
+			"expected closing {} before end-of-file",
+			token_info[token::get_closing_bracket(tokens[open.index].kind)].token_value
+		));
+	}
+
 	// auto const capacity_after = tokens.capacity();
 
 	// bz::log("{:3}: {:5} bytes, {:4} tokens, {:%}, ({} -> {})\n", file_id, file.size(), tokens.size(), (double)tokens.size() / (double)file.size(), capacity_before, capacity_after);
@@ -173,7 +285,6 @@ static token get_identifier_or_keyword_token(
 	);
 
 	auto const begin_it = stream.it;
-	auto const line     = stream.line;
 
 	do
 	{
@@ -226,10 +337,10 @@ static token get_character_token(
 			{ context.make_note(stream.file_id, line, begin_it, "to match this:") }
 		);
 
-		return token(
+		return make_token(
 			token::character_literal,
 			bz::u8string_view(char_begin, char_begin),
-			stream.file_id, line, begin_it, char_begin
+			begin_it, char_begin, stream
 		);
 	}
 
@@ -272,11 +383,11 @@ static token get_character_token(
 
 	auto const end_it = stream.it;
 
-	return token(
+	return make_token(
 		token::character_literal,
 		bz::u8string_view(char_begin, char_end),
 		bz::u8string_view(postfix_begin, postfix_end),
-		stream.file_id, line, begin_it, end_it
+		begin_it, end_it, stream
 	);
 }
 
@@ -322,11 +433,11 @@ static token get_string_token(
 
 	auto const end_it = stream.it;
 
-	return token(
+	return make_token(
 		token::string_literal,
 		bz::u8string_view(str_begin, str_end),
 		bz::u8string_view(postfix_begin, postfix_end),
-		stream.file_id, line, begin_it, end_it
+		begin_it, end_it, stream
 	);
 }
 
@@ -385,11 +496,11 @@ static token get_raw_string_token(
 
 	auto const end_it = stream.it;
 
-	return token(
+	return make_token(
 		token::raw_string_literal,
 		bz::u8string_view(str_begin, str_end),
 		bz::u8string_view(postfix_begin, postfix_end),
-		stream.file_id, line, begin_it, end_it
+		begin_it, end_it, stream
 	);
 }
 
@@ -405,7 +516,6 @@ static token get_hex_number_token(
 
 	auto const begin_it = stream.it;
 	auto const num_begin = stream.it;
-	auto const line = stream.line;
 
 	++stream; ++stream; // '0x' or '0X'
 
@@ -425,11 +535,11 @@ static token get_hex_number_token(
 
 	auto const end_it = stream.it;
 
-	return token(
+	return make_token(
 		token::hex_literal,
 		bz::u8string_view(num_begin, num_end),
 		bz::u8string_view(postfix_begin, postfix_end),
-		stream.file_id, line, begin_it, end_it
+		begin_it, end_it, stream
 	);
 }
 
@@ -445,7 +555,6 @@ static token get_oct_number_token(
 
 	auto const begin_it = stream.it;
 	auto const num_begin = stream.it;
-	auto const line = stream.line;
 
 	++stream; ++stream; // '0o' or '0O'
 
@@ -465,11 +574,11 @@ static token get_oct_number_token(
 
 	auto const end_it = stream.it;
 
-	return token(
+	return make_token(
 		token::oct_literal,
 		bz::u8string_view(num_begin, num_end),
 		bz::u8string_view(postfix_begin, postfix_end),
-		stream.file_id, line, begin_it, end_it
+		begin_it, end_it, stream
 	);
 }
 
@@ -485,7 +594,6 @@ static token get_bin_number_token(
 
 	auto const begin_it = stream.it;
 	auto const num_begin = stream.it;
-	auto const line = stream.line;
 
 	++stream; ++stream; // '0b' or '0B'
 
@@ -505,11 +613,11 @@ static token get_bin_number_token(
 
 	auto const end_it = stream.it;
 
-	return token(
+	return make_token(
 		token::bin_literal,
 		bz::u8string_view(num_begin, num_end),
 		bz::u8string_view(postfix_begin, postfix_end),
-		stream.file_id, line, begin_it, end_it
+		begin_it, end_it, stream
 	);
 }
 
@@ -636,7 +744,6 @@ static token get_number_token(
 
 
 	auto const begin_it = stream.it;
-	auto const line = stream.line;
 
 	auto const [num_str, token_kind] = get_number_token_str_and_kind(stream, end);
 
@@ -649,28 +756,26 @@ static token get_number_token(
 
 	auto const end_it = stream.it;
 
-	return token(
+	return make_token(
 		token_kind,
 		num_str,
 		bz::u8string_view(postfix_begin, postfix_end),
-		stream.file_id, line, begin_it, end_it
+		begin_it, end_it, stream
 	);
 }
 
 static token make_regular_token(
 	uint32_t kind,
 	ctx::char_pos begin_it,
-	ctx::char_pos end_it,
-	uint32_t file_id,
-	uint32_t line,
+	file_iterator const &stream,
 	ctx::lex_context &
 )
 {
 	bz_assert(*begin_it <= 127);
-	return token(
+	return make_token(
 		kind,
-		bz::u8string_view(begin_it, end_it),
-		file_id, line, begin_it, end_it
+		bz::u8string_view(begin_it, stream.it),
+		begin_it, stream.it, stream
 	);
 }
 
@@ -690,10 +795,10 @@ static token get_single_char_token(
 	// ascii
 	if (char_value <= 127)
 	{
-		return token(
+		return make_token(
 			static_cast<uint32_t>(char_value),
 			bz::u8string_view(begin_it, end_it),
-			stream.file_id, line, begin_it, end_it
+			begin_it, end_it, stream
 		);
 	}
 	// non-ascii
@@ -708,10 +813,10 @@ static token get_single_char_token(
 				"unicode character U+037E (greek question mark) looks the same as a semicolon, but it is not"
 			);
 		}
-		return token(
+		return make_token(
 			token::non_ascii_character,
 			bz::u8string_view(begin_it, end_it),
-			stream.file_id, line, begin_it, end_it
+			begin_it, end_it, stream
 		);
 	}
 }
@@ -726,10 +831,10 @@ static token get_next_token(
 
 	if (stream.it == end)
 	{
-		return token(
+		return make_token(
 			token::eof,
 			bz::u8string_view(end, end),
-			stream.file_id, stream.line, end, end
+			end, end, stream
 		);
 	}
 
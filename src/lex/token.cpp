@@ -3,4 +3,178 @@
 namespace lex
 {
 
+// only accessed from the main thread, tokens created on other threads are only added here later
+static bz::vector<source_file_info_t> source_files;
+static size_t last_source_file_index = 0;
+
+// the identifier table is also only accessed from the main thread.  it uses open addressing with linear
+// probing, and the entries store the hash, so strings are only compared if their hashes are the same.
+struct identifier_table_entry_t
+{
+	uint32_t hash;
+	uint32_t id;
+};
+
+static constexpr uint32_t empty_identifier_id = std::numeric_limits<uint32_t>::max();
+static constexpr size_t identifier_storage_chunk_size = 64 * 1024;
+
+static bz::vector<identifier_table_entry_t> identifier_table;
+static bz::vector<bz::u8string_view> identifier_values;
+// the strings are copied, because not all identifiers come from source files
+static bz::vector<std::unique_ptr<char[]>> identifier_storage_chunks;
+static char *identifier_storage_chunk = nullptr;
+static size_t identifier_storage_chunk_used = identifier_storage_chunk_size;
+
+bool add_source_file(bz::u8string_view file, uint32_t file_id, bz::array_view<token> tokens)
+{
+	// the end offset of a file is used by its eof token, so there's a gap of one between files
+	auto const begin_offset = source_files.empty() ? 0 : source_files.back().end_offset + 1;
+	if (file.size() >= std::numeric_limits<uint32_t>::max() - begin_offset)
+	{
+		return false;
+	}
+
+	bz::vector<uint32_t> line_begin_offsets;
+	line_begin_offsets.push_back(0);
+	auto const file_begin = file.data();
+	auto const file_end = file.data() + file.size();
+	for (auto it = file_begin; it != file_end; ++it)
+	{
+		if (*it == '\n')
+		{
+			line_begin_offsets.push_back(static_cast<uint32_t>(it - file_begin) + 1);
+		}
+	}
+
+	source_files.push_back({
+		.begin_offset = begin_offset,
+		.end_offset = begin_offset + static_cast<uint32_t>(file.size()),
+		.file_id = file_id,
+		.data = file_begin,
+		.line_begin_offsets = std::move(line_begin_offsets),
+	});
+
+	for (auto &t : tokens)
+	{
+		bz_assert(t.offset + t.length <= file.size());
+		if (t.kind == token::identifier)
+		{
+			bz_assert(t.value_begin_trim == 0 && t.value_end_trim == 0);
+			t.identifier_id = intern_identifier(bz::u8string_view(file_begin + t.offset, file_begin + t.offset + t.length));
+		}
+		t.offset += begin_offset;
+	}
+	return true;
+}
+
+source_file_info_t const &get_source_file_info(uint32_t offset)
+{
+	bz_assert(source_files.not_empty());
+	// tokens are usually accessed in runs from the same file
+	auto const &last = source_files[last_source_file_index];
+	if (offset >= last.begin_offset && offset <= last.end_offset)
+	{
+		return last;
+	}
+
+	auto const it = std::upper_bound(
+		source_files.begin(), source_files.end(), offset,
+		[](uint32_t offset, source_file_info_t const &info) {
+			return offset < info.begin_offset;
+		}
+	);
+	bz_assert(it != source_files.begin());
+	bz_assert(offset <= (it - 1)->end_offset);
+	last_source_file_index = static_cast<size_t>((it - 1) - source_files.begin());
+	return *(it - 1);
+}
+
+static uint32_t hash_identifier(bz::u8string_view value)
+{
+	// FNV-1a
+	uint32_t hash = 0x811c'9dc5;
+	for (auto const c : bz::array_view(value.data(), value.data() + value.size()))
+	{
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 0x0100'0193;
+	}
+	return hash;
+}
+
+static void insert_identifier_table_entry(identifier_table_entry_t entry)
+{
+	auto const mask = identifier_table.size() - 1;
+	auto index = entry.hash & mask;
+	while (identifier_table[index].id != empty_identifier_id)
+	{
+		index = (index + 1) & mask;
+	}
+	identifier_table[index] = entry;
+}
+
+static char const *store_identifier_value(bz::u8string_view value)
+{
+	if (value.size() > identifier_storage_chunk_size / 4)
+	{
+		auto &storage = identifier_storage_chunks.push_back(std::make_unique<char[]>(value.size()));
+		std::memcpy(storage.get(), value.data(), value.size());
+		return storage.get();
+	}
+
+	if (identifier_storage_chunk_size - identifier_storage_chunk_used < value.size())
+	{
+		identifier_storage_chunk = identifier_storage_chunks.push_back(std::make_unique<char[]>(identifier_storage_chunk_size)).get();
+		identifier_storage_chunk_used = 0;
+	}
+	auto const result = identifier_storage_chunk + identifier_storage_chunk_used;
+	std::memcpy(result, value.data(), value.size());
+	identifier_storage_chunk_used += value.size();
+	return result;
+}
+
+uint32_t intern_identifier(bz::u8string_view value)
+{
+	// keep the load factor at most 1/2
+	if (identifier_values.size() * 2 >= identifier_table.size())
+	{
+		auto const old_table = std::move(identifier_table);
+		identifier_table = bz::vector<identifier_table_entry_t>(
+			std::max(old_table.size() * 2, size_t(1024)),
+			identifier_table_entry_t{ 0, empty_identifier_id }
+		);
+		for (auto const entry : old_table)
+		{
+			if (entry.id != empty_identifier_id)
+			{
+				insert_identifier_table_entry(entry);
+			}
+		}
+	}
+
+	auto const hash = hash_identifier(value);
+	auto const mask = identifier_table.size() - 1;
+	auto index = hash & mask;
+	while (identifier_table[index].id != empty_identifier_id)
+	{
+		auto const entry = identifier_table[index];
+		if (entry.hash == hash && identifier_values[entry.id] == value)
+		{
+			return entry.id;
+		}
+		index = (index + 1) & mask;
+	}
+
+	auto const id = static_cast<uint32_t>(identifier_values.size());
+	auto const data = store_identifier_value(value);
+	identifier_values.push_back(bz::u8string_view(data, data + value.size()));
+	identifier_table[index] = { hash, id };
+	return id;
+}
+
+bz::u8string_view get_identifier_value(uint32_t id)
+{
+	bz_assert(id < identifier_values.size());
+	return identifier_values[id];
+}
+
 } // namespace lex
@@ -145,47 +145,173 @@ struct token
 		_last
 	};
 
-	uint32_t kind;
-	bz::u8string_view value;
-	bz::u8string_view postfix;
-	struct
+	uint16_t kind;
+	// the value of the token is the text of the token without the postfix, and without
+	// these many characters at the beginning and at the end (e.g. the quotes of a string)
+	uint8_t value_begin_trim;
+	uint8_t value_end_trim;
+	// offset of the first character of the token in the source file space, see add_source_file
+	uint32_t offset;
+	uint32_t length;
+	union
 	{
-		uint32_t file_id;
-		uint32_t line;
-		bz::u8string_view::const_iterator begin;
-		bz::u8string_view::const_iterator end;
-	} src_pos;
+		uint32_t postfix_length;
+		// identifiers never have a postfix, so they store their interned id instead, which is set
+		// when the file is added to the source file space
+		uint32_t identifier_id;
+		// brackets don't have a postfix either, so they store the distance to their matching bracket,
+		// which is set by get_tokens; the match of 'it' is 'it + match_distance' for opening brackets
+		// and 'it - match_distance' for closing brackets
+		uint32_t match_distance;
+	};
 
-	token(
-		uint32_t _kind,
-		bz::u8string_view _value,
-		uint32_t _file_id,
-		uint32_t _line,
-		bz::u8string_view::const_iterator _begin,
-		bz::u8string_view::const_iterator _end
-	)
-		: kind   (_kind),
-		  value  (_value),
-		  postfix(""),
-		  src_pos{ _file_id, _line, _begin, _end }
-	{}
+	static constexpr uint32_t max_value_trim = std::numeric_limits<uint8_t>::max();
+
+	token(uint32_t _kind, uint32_t _offset, uint32_t _length)
+		: kind(static_cast<uint16_t>(_kind)),
+		  value_begin_trim(0),
+		  value_end_trim(0),
+		  offset(_offset),
+		  length(_length),
+		  postfix_length(0)
+	{
+		bz_assert(_kind < _last);
+	}
 
 	token(
 		uint32_t _kind,
-		bz::u8string_view _value,
-		bz::u8string_view _postfix,
-		uint32_t _file_id,
-		uint32_t _line,
-		bz::u8string_view::const_iterator _begin,
-		bz::u8string_view::const_iterator _end
+		uint32_t _offset,
+		uint32_t _length,
+		uint32_t _value_begin_trim,
+		uint32_t _value_end_trim,
+		uint32_t _postfix_length
 	)
-		: kind   (_kind),
-		  value  (_value),
-		  postfix(_postfix),
-		  src_pos{ _file_id, _line, _begin, _end }
-	{}
+		: kind(static_cast<uint16_t>(_kind)),
+		  value_begin_trim(static_cast<uint8_t>(_value_begin_trim)),
+		  value_end_trim(static_cast<uint8_t>(_value_end_trim)),
+		  offset(_offset),
+		  length(_length),
+		  postfix_length(_postfix_length)
+	{
+		bz_assert(_kind < _last);
+		bz_assert(_value_begin_trim <= max_value_trim);
+		bz_assert(_value_end_trim <= max_value_trim);
+		bz_assert((_kind != identifier && !is_bracket(_kind)) || _postfix_length == 0);
+		bz_assert(_value_begin_trim + _value_end_trim + _postfix_length <= _length);
+	}
+
+	static constexpr bool is_bracket(uint32_t kind)
+	{
+		return kind == paren_open || kind == paren_close
+			|| kind == square_open || kind == square_close
+			|| kind == curly_open || kind == curly_close;
+	}
+
+	static constexpr bool is_open_bracket(uint32_t kind)
+	{
+		return kind == paren_open || kind == square_open || kind == curly_open;
+	}
+
+	static constexpr uint32_t get_closing_bracket(uint32_t open_kind)
+	{
+		return open_kind == paren_open ? paren_close
+			: open_kind == square_open ? square_close
+			: curly_close;
+	}
+
+	// identifiers and brackets reuse the storage of the postfix length
+	bool has_postfix_length(void) const
+	{
+		return this->kind != identifier && !is_bracket(this->kind);
+	}
+
+	bz::u8string_view get_value(void) const;
+	bz::u8string_view get_postfix(void) const;
+	uint32_t get_identifier_id(void) const;
+	uint32_t get_file_id(void) const;
+	uint32_t get_line(void) const;
+	bz::u8string_view::const_iterator get_begin(void) const;
+	bz::u8string_view::const_iterator get_end(void) const;
+};
+
+static_assert(sizeof (token) == 16);
+static_assert(std::is_trivially_copyable_v<token>);
+static_assert(token::_last <= std::numeric_limits<uint16_t>::max());
+
+// All source files are placed after each other in a 32-bit source file space, so tokens only need
+// to store a single offset.  The file id, the line number and the text of a token are looked up
+// from the source file that contains the offset.
+struct source_file_info_t
+{
+	uint32_t begin_offset;
+	uint32_t end_offset;
+	uint32_t file_id;
+	char const *data;
+	// offsets of the first character of each line, relative to begin_offset
+	bz::vector<uint32_t> line_begin_offsets;
 };
 
+// Adds a tokenized source file to the source file space.  The offsets of 'tokens' must be relative to
+// the beginning of 'file', and they are changed to be relative to the beginning of the source file space.
+// The identifiers in 'tokens' are interned.  'file' must outlive the tokens.  Returns false if the source
+// file space is full.
+[[nodiscard]] bool add_source_file(bz::u8string_view file, uint32_t file_id, bz::array_view<token> tokens);
+source_file_info_t const &get_source_file_info(uint32_t offset);
+
+// Identifiers are interned into 32-bit ids, so symbol lookups can hash and compare integers instead
+// of strings.  Ids are assigned in the order in which identifiers are first seen on the main thread,
+// which keeps them deterministic even though files are tokenized on multiple threads.
+uint32_t intern_identifier(bz::u8string_view value);
+bz::u8string_view get_identifier_value(uint32_t id);
+
+inline bz::u8string_view::const_iterator token::get_begin(void) const
+{
+	auto const &info = get_source_file_info(this->offset);
+	return bz::u8string_view::const_iterator(info.data + (this->offset - info.begin_offset));
+}
+
+inline bz::u8string_view::const_iterator token::get_end(void) const
+{
+	auto const &info = get_source_file_info(this->offset);
+	return bz::u8string_view::const_iterator(info.data + (this->offset - info.begin_offset) + this->length);
+}
+
+inline bz::u8string_view token::get_value(void) const
+{
+	auto const &info = get_source_file_info(this->offset);
+	auto const begin = info.data + (this->offset - info.begin_offset);
+	auto const end = begin + this->length;
+	auto const postfix_length = this->has_postfix_length() ? this->postfix_length : 0;
+	return bz::u8string_view(begin + this->value_begin_trim, end - postfix_length - this->value_end_trim);
+}
+
+inline bz::u8string_view token::get_postfix(void) const
+{
+	auto const &info = get_source_file_info(this->offset);
+	auto const end = info.data + (this->offset - info.begin_offset) + this->length;
+	auto const postfix_length = this->has_postfix_length() ? this->postfix_length : 0;
+	return bz::u8string_view(end - postfix_length, end);
+}
+
+inline uint32_t token::get_identifier_id(void) const
+{
+	// other tokens can be used as identifiers after a parse error
+	return this->kind == identifier ? this->identifier_id : intern_identifier(this->get_value());
+}
+
+inline uint32_t token::get_file_id(void) const
+{
+	return get_source_file_info(this->offset).file_id;
+}
+
+inline uint32_t token::get_line(void) const
+{
+	auto const &info = get_source_file_info(this->offset);
+	auto const &line_begin_offsets = info.line_begin_offsets;
+	auto const it = std::upper_bound(line_begin_offsets.begin(), line_begin_offsets.end(), this->offset - info.begin_offset);
+	return static_cast<uint32_t>(it - line_begin_offsets.begin());
+}
+
 
 
 using token_pos = bz::vector<token>::const_iterator;
@@ -1570,6 +1570,11 @@ int main(int argc, char const **argv)
 		}
 		t.end_section();
 
+		if (global_data::do_profile)
+		{
+			global_ctx.profile_timer = &t;
+		}
+
 		if (global_data::compile_until <= compilation_phase::parse_command_line)
 		{
 			global_ctx.report_and_clear_errors_and_warnings();
@@ -1582,6 +1587,30 @@ int main(int argc, char const **argv)
 			global_ctx.report_and_clear_errors_and_warnings();
 			return_from_main(2);
 		}
+
+		if (global_data::thinlto_backend)
+		{
+			t.end_section();
+
+			if (global_data::source_files.empty())
+			{
+				global_ctx.report_error("no input file was provided");
+				global_ctx.report_and_clear_errors_and_warnings();
+				return_from_main(3);
+			}
+
+			t.start_section("code generation time");
+			if (!global_ctx.run_thinlto_backend())
+			{
+				global_ctx.report_and_clear_errors_and_warnings();
+				return_from_main(6);
+			}
+			t.end_section();
+
+			global_ctx.report_and_clear_errors_and_warnings();
+			return_from_main(0);
+		}
+
 		if (!global_ctx.initialize_builtins())
 		{
 			global_ctx.report_and_clear_errors_and_warnings();
@@ -1589,12 +1618,21 @@ int main(int argc, char const **argv)
 		}
 		t.end_section();
 
-		t.start_section("global symbol parse time");
-		if (!global_ctx.parse_global_symbols())
+		if (global_data::source_files.empty())
 		{
+			global_ctx.report_error("no source file was provided");
 			global_ctx.report_and_clear_errors_and_warnings();
 			return_from_main(3);
 		}
+		for (auto const i : bz::iota(0, global_data::source_files.size()))
+		{
+			t.start_section("global symbol parse time", global_data::source_files[i]);
+			if (!global_ctx.parse_global_symbols(i))
+			{
+				global_ctx.report_and_clear_errors_and_warnings();
+				return_from_main(3);
+			}
+		}
 		t.end_section();
 
 		if (global_data::compile_until <= compilation_phase::parse_global_symbols)
@@ -1629,11 +1667,14 @@ int main(int argc, char const **argv)
 		}
 		t.end_section();
 
-		t.start_section("code generation time");
-		if (!global_ctx.generate_and_output_code())
+		for (auto const i : bz::iota(0, global_data::source_files.size()))
 		{
-			global_ctx.report_and_clear_errors_and_warnings();
-			return_from_main(6);
+			t.start_section("code generation time", global_data::source_files[i]);
+			if (!global_ctx.generate_and_output_code(i))
+			{
+				global_ctx.report_and_clear_errors_and_warnings();
+				return_from_main(6);
+			}
 		}
 		t.end_section();
 
@@ -1661,10 +1702,45 @@ int main(int argc, char const **argv)
 		bz::print("successful compilation in {:8.3f}ms\n", in_ms(compilation_time));
 		bz::print("front-end time:           {:8.3f}ms\n", in_ms(front_end_time));
 		bz::print("back-end time:            {:8.3f}ms\n", in_ms(back_end_time));
-		for (auto const &[name, begin, end] : t.timing_sections)
+		for (auto const &[name, unit, begin, end, subsections] : t.timing_sections)
+		{
+			if (unit == "" || global_data::source_files.size() == 1)
+			{
+				bz::print("{:25} {:8.3f}ms\n", bz::format("{}:", name), in_ms(end - begin));
+			}
+			else
+			{
+				bz::print("{:25} {:8.3f}ms ({})\n", bz::format("{}:", name), in_ms(end - begin), unit);
+			}
+			for (auto const &[subsection_name, time] : subsections)
+			{
+				bz::print("{:25} {:8.3f}ms\n", bz::format("  {}:", subsection_name), in_ms(time));
+			}
+		}
+		for (auto const &[info, i] : global_data::codegen_unit_profile_infos.enumerate())
 		{
-			bz::print("{:25} {:8.3f}ms\n", bz::format("{}:", name), in_ms(end - begin));
+			bz::print(
+				"{:25} {:8.3f}ms ({} functions)\n",
+				bz::format("  codegen unit {}:", i), in_ms(info.duration), info.function_count
+			);
 		}
+		bz::print("consteval cache hits:     {:8}\n", global_data::consteval_call_cache_hit_count);
+		bz::print("consteval cache misses:   {:8}\n", global_data::consteval_call_cache_miss_count);
+		bz::print("resolved library bodies:  {:8}\n", global_data::library_function_resolved_count);
+		bz::print("skipped library bodies:   {:8}\n", global_data::library_function_skipped_count);
+		if (global_data::module_cache_dir != "")
+		{
+			bz::print("module cache hits:        {:8}\n", global_data::module_cache_hit_count);
+			bz::print("module cache misses:      {:8}\n", global_data::module_cache_miss_count);
+		}
+		bz::print(
+			"source tokens:            {:8} ({} KiB)\n",
+			global_data::source_token_count, global_data::source_token_count * sizeof (lex::token) / 1024
+		);
+		bz::print("tokenization time:        {:8.3f}ms\n", in_ms(global_data::tokenization_time));
+		bz::print("comptime allocations:     {:8}\n", global_data::comptime_heap_allocation_count);
+		bz::print("comptime frees:           {:8}\n", global_data::comptime_heap_free_count);
+		bz::print("max live comptime allocs: {:8}\n", global_data::comptime_max_live_heap_allocation_count);
 
 #ifdef BOZON_PROFILE_ALLOCATIONS
 		bz::print("allocations:              {:8}\n", ast::arena_allocator::get_allocation_count());
@@ -1676,6 +1752,13 @@ int main(int argc, char const **argv)
 #ifdef BOZON_PROFILE_COMPTIME
 		bz::print("emitted instructions:     {:8}\n", global_data::comptime_emitted_instructions_count);
 		bz::print("executed instructions:    {:8}\n", global_data::comptime_executed_instructions_count);
+		bz::print("comptime execution time:  {:8.3f}ms\n", in_ms(global_data::comptime_execution_time));
+		if (global_data::comptime_execution_time.count() != 0)
+		{
+			auto const instructions_per_second = static_cast<double>(global_data::comptime_executed_instructions_count)
+				/ (in_ms(global_data::comptime_execution_time) * 1e-3);
+			bz::print("executed instructions/s:  {:8.3e}\n", instructions_per_second);
+		}
 		if (global_data::debug_comptime_print_instruction_counts)
 		{
 			comptime::print_instruction_counts();
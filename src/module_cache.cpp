@@ -0,0 +1,304 @@
+#include "module_cache.h"
+#include "global_data.h"
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // !_WIN32
+
+namespace module_cache
+{
+
+// should be incremented every time the layout of the cache files changes
+static constexpr uint32_t cache_format_version = 6;
+static constexpr bz::array<char, 8> cache_file_magic = { 'b', 'z', 'm', 'c', 'a', 'c', 'h', 'e' };
+
+// the header is followed by the tokens
+// 'key' is also the name of the cache file, 'content_hash' is computed independently of it,
+// so together with 'file_size' the entry is identified by a 128-bit hash and the size of the file
+struct cache_file_header_t
+{
+	bz::array<char, 8> magic;
+	uint64_t key;
+	uint64_t content_hash;
+	uint64_t file_size;
+	uint64_t token_count;
+};
+
+static_assert(std::is_trivially_copyable_v<cache_file_header_t>);
+
+// FNV-1a is used, because the hash needs to be the same across compiler builds
+static uint64_t hash_bytes(uint64_t hash, bz::u8string_view bytes)
+{
+	for (auto const c : bz::array_view(bytes.data(), bytes.data() + bytes.size()))
+	{
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 0x0000'0100'0000'01b3;
+	}
+	return hash;
+}
+
+// the file contents are hashed 8 bytes at a time, which is several times faster than hash_bytes
+// on large files; the high half of the hash is folded back after every step, so that the high bytes
+// of a word also affect the low bits of the result.  the words are read in native byte order,
+// which is fine, because a different key only means a cache miss
+static uint64_t hash_file_contents(uint64_t hash, bz::u8string_view file)
+{
+	auto it = file.data();
+	auto const end = file.data() + file.size();
+	for (; end - it >= 8; it += 8)
+	{
+		uint64_t word;
+		std::memcpy(&word, it, 8);
+		hash ^= word;
+		hash *= 0x0000'0100'0000'01b3;
+		hash ^= hash >> 32;
+	}
+	return hash_bytes(hash, bz::u8string_view(it, end));
+}
+
+// the second half of the 128-bit hash of the file contents; it uses a different multiplier and mixing
+// step than hash_file_contents, so that a collision in one of them is not a collision in the other
+static uint64_t get_content_hash(bz::u8string_view file)
+{
+	uint64_t hash = 0x6a09'e667'f3bc'c908;
+	auto it = file.data();
+	auto const end = file.data() + file.size();
+	for (; end - it >= 8; it += 8)
+	{
+		uint64_t word;
+		std::memcpy(&word, it, 8);
+		hash = (hash ^ word) * 0x9e37'79b9'7f4a'7c15;
+		hash = (hash << 27) | (hash >> 37);
+	}
+	for (; it != end; ++it)
+	{
+		hash = (hash ^ static_cast<uint8_t>(*it)) * 0x9e37'79b9'7f4a'7c15;
+		hash = (hash << 27) | (hash >> 37);
+	}
+	hash ^= hash >> 29;
+	hash *= 0xbf58'476d'1ce4'e5b9;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+static uint64_t get_cache_key(bz::u8string_view file, bz::u8string_view target_triple)
+{
+	auto const format_version = bz::format("{}", cache_format_version);
+
+	uint64_t hash = 0xcbf2'9ce4'8422'2325;
+	hash = hash_bytes(hash, format_version);
+	hash = hash_bytes(hash, get_compiler_version());
+	// the strings are separated with a null byte, so that e.g. "ab" + "c" and "a" + "bc" give different hashes
+	hash = hash_bytes(hash, bz::u8string_view("\0", "\0" + 1));
+	hash = hash_bytes(hash, target_triple);
+	hash = hash_bytes(hash, bz::u8string_view("\0", "\0" + 1));
+	hash = hash_file_contents(hash, file);
+	return hash;
+}
+
+static fs::path get_cache_file_path(uint64_t key)
+{
+	auto const dir = std::string_view(global_data::module_cache_dir.data_as_char_ptr(), global_data::module_cache_dir.size());
+	auto const file_name = bz::format("{:016x}.bztok", key);
+	return fs::path(dir) / std::string_view(file_name.data_as_char_ptr(), file_name.size());
+}
+
+static bz::optional<bz::vector<lex::token>> get_tokens_from_cache_data(
+	bz::array_view<uint8_t const> data,
+	bz::u8string_view file,
+	uint64_t key,
+	uint64_t content_hash
+)
+{
+	if (data.size() < sizeof (cache_file_header_t))
+	{
+		return {};
+	}
+
+	cache_file_header_t header;
+	std::memcpy(&header, data.data(), sizeof (cache_file_header_t));
+	if (
+		std::memcmp(header.magic.data(), cache_file_magic.data(), cache_file_magic.size()) != 0
+		|| header.key != key
+		|| header.content_hash != content_hash
+		|| header.file_size != file.size()
+		|| header.token_count == 0
+		|| (data.size() - sizeof (cache_file_header_t)) % sizeof (lex::token) != 0
+		|| (data.size() - sizeof (cache_file_header_t)) / sizeof (lex::token) != header.token_count
+	)
+	{
+		return {};
+	}
+
+	// the tokens are stored as they are before being added to the source file space,
+	// so their offsets are relative to the beginning of the file and identifiers are not interned yet
+	bz::vector<lex::token> result;
+	result.resize(header.token_count, lex::token(lex::token::eof, 0, 0));
+	std::memcpy(result.data(), data.data() + sizeof (cache_file_header_t), header.token_count * sizeof (lex::token));
+	for (auto const &token : result)
+	{
+		if (
+			token.kind >= lex::token::_last
+			|| token.length > file.size()
+			|| token.offset > file.size() - token.length
+			|| static_cast<uint64_t>(token.value_begin_trim) + token.value_end_trim + (token.has_postfix_length() ? token.postfix_length : 0) > token.length
+			|| (token.kind == lex::token::identifier && (token.value_begin_trim != 0 || token.value_end_trim != 0 || token.postfix_length != 0))
+		)
+		{
+			return {};
+		}
+	}
+
+	if (result.back().kind != lex::token::eof)
+	{
+		return {};
+	}
+
+	// the parser relies on the bracket matches being consistent
+	size_t bracket_count = 0;
+	size_t open_bracket_count = 0;
+	for (auto const i : bz::iota(0, result.size()))
+	{
+		auto const &token = result[i];
+		bracket_count += lex::token::is_bracket(token.kind) ? 1 : 0;
+		if (!lex::token::is_open_bracket(token.kind))
+		{
+			continue;
+		}
+		open_bracket_count += 1;
+
+		if (
+			token.match_distance == 0
+			|| token.match_distance >= result.size() - i
+			|| result[i + token.match_distance].kind != lex::token::get_closing_bracket(token.kind)
+			|| result[i + token.match_distance].match_distance != token.match_distance
+		)
+		{
+			return {};
+		}
+	}
+
+	// every opening bracket has a different closing bracket, so this means that every closing bracket is matched
+	if (bracket_count != 2 * open_bracket_count)
+	{
+		return {};
+	}
+	return result;
+}
+
+bz::optional<bz::vector<lex::token>> load_tokens(
+	bz::u8string_view file,
+	bz::u8string_view target_triple
+)
+{
+	auto const key = get_cache_key(file, target_triple);
+	auto const content_hash = get_content_hash(file);
+	auto const path = get_cache_file_path(key);
+
+#ifdef _WIN32
+	std::ifstream cache_file(path, std::ios::binary);
+	if (!cache_file.good())
+	{
+		return {};
+	}
+
+	std::vector<char> data{
+		std::istreambuf_iterator<char>(cache_file),
+		std::istreambuf_iterator<char>()
+	};
+	return get_tokens_from_cache_data(
+		bz::array_view(reinterpret_cast<uint8_t const *>(data.data()), data.size()),
+		file, key, content_hash
+	);
+#else
+	auto const fd = open(path.c_str(), O_RDONLY);
+	if (fd == -1)
+	{
+		return {};
+	}
+
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0)
+	{
+		close(fd);
+		return {};
+	}
+
+	auto const size = static_cast<size_t>(file_stat.st_size);
+	auto const data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+	{
+		return {};
+	}
+
+	auto result = get_tokens_from_cache_data(
+		bz::array_view(static_cast<uint8_t const *>(data), size),
+		file, key, content_hash
+	);
+	munmap(data, size);
+	return result;
+#endif // _WIN32
+}
+
+void store_tokens(
+	bz::u8string_view file,
+	bz::array_view<lex::token const> tokens,
+	bz::u8string_view target_triple
+)
+{
+	auto const key = get_cache_key(file, target_triple);
+	auto const header = cache_file_header_t{
+		.magic        = cache_file_magic,
+		.key          = key,
+		.content_hash = get_content_hash(file),
+		.file_size    = file.size(),
+		.token_count  = tokens.size(),
+	};
+
+	std::error_code ec;
+	auto const path = get_cache_file_path(key);
+	fs::create_directories(path.parent_path(), ec);
+	if (ec)
+	{
+		return;
+	}
+
+	// the cache file is written to a temporary file first and then renamed, so that
+	// other compiler processes never see a partially written cache file
+	auto temp_path = path;
+	// the thread id is included, because source files may be tokenized on multiple threads
+	auto const temp_suffix = bz::format(
+		".{}.{}.tmp",
+		std::chrono::steady_clock::now().time_since_epoch().count(),
+		std::hash<std::thread::id>()(std::this_thread::get_id())
+	);
+	temp_path += std::string_view(temp_suffix.data_as_char_ptr(), temp_suffix.size());
+	{
+		std::ofstream cache_file(temp_path, std::ios::binary);
+		if (!cache_file.good())
+		{
+			return;
+		}
+		cache_file.write(reinterpret_cast<char const *>(&header), sizeof (cache_file_header_t));
+		cache_file.write(reinterpret_cast<char const *>(tokens.data()), tokens.size() * sizeof (lex::token));
+		if (!cache_file.good())
+		{
+			cache_file.close();
+			fs::remove(temp_path, ec);
+			return;
+		}
+	}
+
+	fs::rename(temp_path, path, ec);
+	if (ec)
+	{
+		fs::remove(temp_path, ec);
+	}
+}
+
+} // namespace module_cache
@@ -0,0 +1,31 @@
+#ifndef MODULE_CACHE_H
+#define MODULE_CACHE_H
+
+#include "core.h"
+#include "lex/token.h"
+
+namespace module_cache
+{
+
+// Loads the tokens of a source file from the module cache directory.  The cache entry is keyed by
+// the hash of the file contents, the compiler version and the target triple, and it is only used if
+// a second, independent hash of the contents and the size of the file also match.  Only the tokens are
+// cached, declarations are always parsed and resolved again.  The offsets of the returned tokens are
+// relative to the beginning of 'file', like the ones returned by lex::get_tokens.
+bz::optional<bz::vector<lex::token>> load_tokens(
+	bz::u8string_view file,
+	bz::u8string_view target_triple
+);
+
+// Stores the tokens of a source file in the module cache directory.  The offsets of the tokens must be
+// relative to the beginning of 'file'.  Failing to write the cache entry is not an error, the file
+// will be tokenized again next time.
+void store_tokens(
+	bz::u8string_view file,
+	bz::array_view<lex::token const> tokens,
+	bz::u8string_view target_triple
+);
+
+} // namespace module_cache
+
+#endif // MODULE_CACHE_H
@@ -245,6 +245,55 @@ ast::expression parse_compound_expression(
 	}
 }
 
+static ast::branch_likelihood parse_branch_likelihood(
+	lex::token_pos &stream, lex::token_pos end,
+	ctx::parse_context &context
+)
+{
+	if (
+		stream == end || stream->kind != lex::token::at
+		|| (stream + 1) == end || (stream + 1)->kind != lex::token::identifier
+	)
+	{
+		return ast::branch_likelihood::none;
+	}
+
+	++stream; // '@'
+	auto const name = stream;
+	++stream;
+	if (name->get_value() == "likely")
+	{
+		return ast::branch_likelihood::likely;
+	}
+	else if (name->get_value() == "unlikely")
+	{
+		return ast::branch_likelihood::unlikely;
+	}
+	else
+	{
+		context.report_warning(
+			ctx::warning_kind::unknown_attribute,
+			name,
+			bz::format("unknown attribute '@{}'", name->get_value())
+		);
+		return ast::branch_likelihood::none;
+	}
+}
+
+static ast::branch_likelihood get_opposite_likelihood(ast::branch_likelihood likelihood)
+{
+	switch (likelihood)
+	{
+	case ast::branch_likelihood::none:
+		return ast::branch_likelihood::none;
+	case ast::branch_likelihood::likely:
+		return ast::branch_likelihood::unlikely;
+	case ast::branch_likelihood::unlikely:
+		return ast::branch_likelihood::likely;
+	}
+	bz_unreachable;
+}
+
 ast::expression parse_if_expression(
 	lex::token_pos &stream, lex::token_pos end,
 	ctx::parse_context &context
@@ -263,6 +312,8 @@ ast::expression parse_if_expression(
 
 	auto const prev_unresolved_context = is_if_consteval && context.push_unresolved_context();
 
+	auto const then_likelihood_it = stream;
+	auto const then_likelihood = parse_branch_likelihood(stream, end, context);
 	auto then_block = parse_expression_without_semi_colon(stream, end, context, precedence{});
 	if (
 		stream != end
@@ -275,9 +326,24 @@ ast::expression parse_if_expression(
 		++stream; // ';'
 	}
 	ast::expression else_block;
+	auto else_likelihood = ast::branch_likelihood::none;
 	if (stream != end && stream->kind == lex::token::kw_else)
 	{
 		++stream; // 'else'
+		auto const else_likelihood_it = stream;
+		else_likelihood = parse_branch_likelihood(stream, end, context);
+		if (
+			then_likelihood != ast::branch_likelihood::none
+			&& else_likelihood != ast::branch_likelihood::none
+			&& then_likelihood != get_opposite_likelihood(else_likelihood)
+		)
+		{
+			context.report_error(
+				else_likelihood_it + 1,
+				bz::format("both branches of the if expression are marked as '@{}'", (else_likelihood_it + 1)->get_value()),
+				{ context.make_note(then_likelihood_it + 1, "then branch was marked here") }
+			);
+		}
 		else_block = parse_expression_without_semi_colon(stream, end, context, no_comma);
 		if (!else_block.is_special_top_level() && stream->kind == lex::token::semi_colon)
 		{
@@ -291,17 +357,26 @@ ast::expression parse_if_expression(
 		context.pop_unresolved_context(prev_unresolved_context);
 	}
 
+	// the hints are ignored for if consteval
+	auto const make_if_expr = [&](auto &&...blocks) {
+		if (is_if_consteval)
+		{
+			return ast::make_unresolved_expr_if_consteval(std::move(condition), std::move(blocks)...);
+		}
+
+		auto result = ast::make_unresolved_expr_if(std::move(condition), std::move(blocks)...);
+		result.template get<ast::expr_if>().then_likelihood = then_likelihood != ast::branch_likelihood::none
+			? then_likelihood
+			: get_opposite_likelihood(else_likelihood);
+		return result;
+	};
+
 	if (else_block.is_null())
 	{
 		if (then_block.not_error())
 		{
 			consume_semi_colon_at_end_of_expression(stream, end, context, then_block);
-			return ast::make_unresolved_expression(
-				src_tokens,
-				is_if_consteval
-					? ast::make_unresolved_expr_if_consteval(std::move(condition), std::move(then_block))
-					: ast::make_unresolved_expr_if(std::move(condition), std::move(then_block))
-			);
+			return ast::make_unresolved_expression(src_tokens, make_if_expr(std::move(then_block)));
 		}
 		else
 		{
@@ -315,12 +390,7 @@ ast::expression parse_if_expression(
 	}
 	else if (then_block.not_error() && else_block.not_error())
 	{
-		return ast::make_unresolved_expression(
-			src_tokens,
-			is_if_consteval
-				? ast::make_unresolved_expr_if_consteval(std::move(condition), std::move(then_block), std::move(else_block))
-				: ast::make_unresolved_expr_if(std::move(condition), std::move(then_block), std::move(else_block))
-		);
+		return ast::make_unresolved_expression(src_tokens, make_if_expr(std::move(then_block), std::move(else_block)));
 	}
 	else
 	{
@@ -347,7 +417,9 @@ ast::expression parse_switch_expression(
 	auto const open_curly = context.assert_token(stream, lex::token::curly_open);
 
 	ast::arena_vector<ast::switch_case> cases;
+	ast::arena_vector<ast::branch_likelihood> case_likelihoods;
 	ast::expression default_case;
+	auto default_likelihood = ast::branch_likelihood::none;
 
 	do
 	{
@@ -372,6 +444,7 @@ ast::expression parse_switch_expression(
 			}
 			else
 			{
+				default_likelihood = parse_branch_likelihood(stream, end, context);
 				default_case = parse_expression(stream, end, context, no_comma);
 			}
 		}
@@ -386,6 +459,7 @@ ast::expression parse_switch_expression(
 				case_values.emplace_back(parse_expression(case_stream, end, context, no_comma));
 			} while (case_stream != case_end && case_stream->kind == lex::token::comma && (++case_stream, case_stream != case_end));
 			context.assert_token(stream, lex::token::fat_arrow);
+			case_likelihoods.push_back(parse_branch_likelihood(stream, end, context));
 			auto case_expr = parse_expression(stream, end, context, no_comma);
 			cases.push_back({ std::move(case_values), std::move(case_expr) });
 		}
@@ -405,10 +479,15 @@ ast::expression parse_switch_expression(
 	}
 
 	lex::src_tokens src_tokens = { begin, begin, stream };
-	return ast::make_unresolved_expression(
-		src_tokens,
-		ast::make_unresolved_expr_switch(std::move(matched_expr), std::move(default_case), std::move(cases))
-	);
+	auto switch_expr = ast::make_unresolved_expr_switch(std::move(matched_expr), std::move(default_case), std::move(cases));
+	auto const has_likelihoods = default_likelihood != ast::branch_likelihood::none
+		|| case_likelihoods.is_any([](auto const likelihood) { return likelihood != ast::branch_likelihood::none; });
+	if (has_likelihoods)
+	{
+		switch_expr.get<ast::expr_switch>().case_likelihoods = std::move(case_likelihoods);
+		switch_expr.get<ast::expr_switch>().default_likelihood = default_likelihood;
+	}
+	return ast::make_unresolved_expression(src_tokens, std::move(switch_expr));
 }
 
 static ast::expression parse_array_type(
@@ -662,7 +741,7 @@ static ast::expression parse_primary_expression(
 		auto const first = stream;
 		++stream;
 		while (
-			stream != end && (stream - 1)->postfix == ""
+			stream != end && (stream - 1)->get_postfix() == ""
 			&& (stream->kind == lex::token::string_literal || stream->kind == lex::token::raw_string_literal)
 		)
 		{
@@ -923,12 +1002,12 @@ static ast::expression parse_expression_helper(
 		case lex::token::dot:
 		{
 			auto id = get_identifier(stream, end, context);
-			if (id.values.empty())
+			if (id.ids.empty())
 			{
 				lhs.to_error();
 				break;
 			}
-			else if (!id.is_qualified && id.values.size() == 1 && (stream == end || stream->kind != lex::token::paren_open))
+			else if (!id.is_qualified && id.ids.size() == 1 && (stream == end || stream->kind != lex::token::paren_open))
 			{
 				auto const src_tokens = lex::src_tokens{ lhs.get_tokens_begin(), id.tokens.begin, stream };
 				bz_assert(id.tokens.begin->kind == lex::token::identifier);
@@ -56,7 +56,7 @@ ast::expression parse_parenthesized_condition(
 			"assign operator used in condition, which could be mistaken with the equals operator",
 			{}, { context.make_suggestion_before(
 				condition.src_tokens.pivot,
-				condition.src_tokens.pivot->src_pos.begin, condition.src_tokens.pivot->src_pos.end,
+				condition.src_tokens.pivot->get_begin(), condition.src_tokens.pivot->get_end(),
 				"==", "did you mean to use the equals operator"
 			) }
 		);
@@ -20,53 +20,44 @@ ast::expression parse_parenthesized_condition(
 	ctx::parse_context &context
 );
 
-template<uint32_t ...stop_tokens>
+// Moves 'stream' past the bracketed token group that starts at 'stream'.  The matching bracket is found
+// by the lexer, so this doesn't depend on the size of the group.  If the matching bracket is not before
+// 'end', then 'stream' is moved to 'end'.
+inline void skip_bracketed_tokens(lex::token_pos &stream, lex::token_pos end)
+{
+	bz_assert(stream != end && lex::token::is_open_bracket(stream->kind));
+	auto const close = stream + stream->match_distance;
+	stream = close < end ? close + 1 : end;
+}
+
 inline lex::token_range get_tokens_in_curly(
 	lex::token_pos &stream, lex::token_pos end,
 	ctx::parse_context &context
 )
 {
 	auto const open_curly = stream - 1;
+	bz_assert(open_curly->kind == lex::token::curly_open);
 	auto const begin = stream;
-	size_t level = 0;
-	auto const is_valid_kind = [](uint32_t kind) {
-		return !((kind == lex::token::curly_close) || ... || (kind == stop_tokens));
-	};
+	auto const close_curly = open_curly + open_curly->match_distance;
 
-	while (stream != end && (level != 0 || is_valid_kind(stream->kind)))
+	if (close_curly >= end)
 	{
-		if (stream->kind == lex::token::curly_open)
-		{
-			++level;
-		}
-		else if (stream->kind == lex::token::curly_close)
-		{
-			--level;
-		}
-		++stream;
-	}
-
-	if (stream == end)
-	{
-		if (open_curly->kind == lex::token::curly_open)
-		{
-			context.report_paren_match_error(stream, open_curly);
-		}
+		stream = end;
+		context.report_paren_match_error(stream, open_curly);
 		return {};
 	}
 	else
 	{
-		bz_assert(stream->kind == lex::token::curly_close);
-		auto const end_ = stream;
-		++stream; // '}'
-		return { begin, end_ };
+		bz_assert(close_curly->kind == lex::token::curly_close);
+		stream = close_curly + 1; // '}'
+		return { begin, close_curly };
 	}
 }
 
 template<uint32_t ...stop_tokens>
 inline lex::token_range get_expression_tokens_without_error(
 	lex::token_pos &stream, lex::token_pos end,
-	ctx::parse_context &context
+	[[maybe_unused]] ctx::parse_context &context
 )
 {
 	auto const begin = stream;
@@ -74,49 +65,15 @@ inline lex::token_range get_expression_tokens_without_error(
 		return is_valid_expression_or_type_token(kind)
 			&& !((kind == stop_tokens) || ...);
 	};
-	size_t level = 0;
 
-	while (stream != end && (level != 0 || is_valid_kind(stream->kind)))
+	while (stream != end && is_valid_kind(stream->kind))
 	{
 		switch (stream->kind)
 		{
 		case lex::token::paren_open:
-		{
-			++stream; // '('
-			get_expression_tokens_without_error<
-				lex::token::paren_close, lex::token::square_close
-			>(stream, end, context);
-			if (stream != end && stream->kind == lex::token::paren_close)
-			{
-				++stream;
-			}
-			break;
-		}
 		case lex::token::square_open:
-		{
-			++stream; // '['
-			get_expression_tokens_without_error<
-				lex::token::paren_close, lex::token::square_close
-			>(stream, end, context);
-			if (stream != end && stream->kind == lex::token::square_close)
-			{
-				++stream;
-			}
-			break;
-		}
 		case lex::token::curly_open:
-			++level;
-			++stream; // '{'
-			break;
-		case lex::token::curly_close:
-			--level;
-			++stream; // '}'
-			break;
-		case lex::token::paren_close:
-			++stream; // ')'
-			break;
-		case lex::token::square_close:
-			++stream; // ']'
+			skip_bracketed_tokens(stream, end);
 			break;
 		default:
 			++stream;
@@ -144,32 +101,12 @@ inline lex::token_range get_expression_tokens(
 		switch (stream->kind)
 		{
 		case lex::token::paren_open:
-		{
-			++stream; // '('
-			get_expression_tokens_without_error<
-				lex::token::paren_close, lex::token::square_close
-			>(stream, end, context);
-			if (stream != end && stream->kind == lex::token::paren_close)
-			{
-				++stream;
-			}
-			break;
-		}
 		case lex::token::square_open:
-		{
-			++stream; // '['
-			get_expression_tokens_without_error<
-				lex::token::paren_close, lex::token::square_close
-			>(stream, end, context);
-			if (stream != end && stream->kind == lex::token::square_close)
-			{
-				++stream;
-			}
+			skip_bracketed_tokens(stream, end);
 			break;
-		}
 		case lex::token::curly_open:
 			++stream; // '{'
-			get_tokens_in_curly<>(stream, end, context);
+			get_tokens_in_curly(stream, end, context);
 			break;
 		case lex::token::paren_close:
 			context.report_error(stream, "stray )");
@@ -238,10 +175,10 @@ inline lex::token_range get_paren_matched_range(
 
 inline lex::token_pos search_token(uint32_t kind, lex::token_pos begin, lex::token_pos end)
 {
-	int paren_level = 0;
-	for (auto it = begin; paren_level >= 0 && it != end; ++it)
+	auto it = begin;
+	while (it != end)
 	{
-		if (paren_level == 0 && it->kind == kind)
+		if (it->kind == kind)
 		{
 			return it;
 		}
@@ -250,14 +187,14 @@ inline lex::token_pos search_token(uint32_t kind, lex::token_pos begin, lex::tok
 		case lex::token::paren_open:
 		case lex::token::square_open:
 		case lex::token::curly_open:
-			++paren_level;
+			skip_bracketed_tokens(it, end);
 			break;
 		case lex::token::paren_close:
 		case lex::token::square_close:
 		case lex::token::curly_close:
-			--paren_level;
-			break;
+			return end;
 		default:
+			++it;
 			break;
 		}
 	}
@@ -284,13 +221,13 @@ inline abi::calling_convention get_calling_convention(lex::token_pos it, ctx::pa
 	auto const string_value = [&]() -> bz::u8string {
 		if (it->kind == lex::token::raw_string_literal)
 		{
-			return it->value;
+			return it->get_value();
 		}
 		else
 		{
 			// copy pasted from parse_context.cpp
 			bz::u8string result = "";
-			auto const value = it->value;
+			auto const value = it->get_value();
 			auto it = value.begin();
 			auto const end = value.end();
 
@@ -329,7 +266,7 @@ inline abi::calling_convention get_calling_convention(lex::token_pos it, ctx::pa
 			if (global_data::do_verbose)
 			{
 				return { context.make_note(
-					it->src_pos.file_id, it->src_pos.line,
+					it->get_file_id(), it->get_line(),
 					"available calling conventions are 'c', 'fast' and 'std'"
 				) };
 			}
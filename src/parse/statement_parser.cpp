@@ -119,7 +119,7 @@ static ast::decl_variable parse_decl_variable_id_and_type(
 				),
 				context.get_current_enclosing_scope()
 			);
-			if (id->kind == lex::token::identifier && result.get_id().values.back().starts_with('_'))
+			if (id->kind == lex::token::identifier && result.get_id().get_value(0).starts_with('_'))
 			{
 				result.flags |= ast::decl_variable::maybe_unused;
 			}
@@ -143,7 +143,7 @@ static ast::decl_variable parse_decl_variable_id_and_type(
 			),
 			context.get_current_enclosing_scope()
 		);
-		if (id->kind == lex::token::identifier && result.get_id().values.back().starts_with('_'))
+		if (id->kind == lex::token::identifier && result.get_id().get_value(0).starts_with('_'))
 		{
 			result.flags |= ast::decl_variable::maybe_unused;
 		}
@@ -401,7 +401,7 @@ static ast::arena_vector<ast::decl_variable> parse_parameter_list(
 		));
 		auto &param_decl = result.back();
 		param_decl.flags |= ast::decl_variable::parameter;
-		if (param_decl.get_id().values.empty())
+		if (param_decl.get_id().ids.empty())
 		{
 			param_decl.flags |= ast::decl_variable::maybe_unused;
 		}
@@ -478,7 +478,7 @@ static ast::function_body parse_function_body(
 	if (stream != end && stream->kind == lex::token::curly_open)
 	{
 		++stream; // '{'
-		auto const body_tokens = get_tokens_in_curly<>(stream, end, context);
+		auto const body_tokens = get_tokens_in_curly(stream, end, context);
 		result.body = body_tokens;
 	}
 	else if (stream == end || stream->kind != lex::token::semi_colon)
@@ -563,7 +563,7 @@ ast::statement parse_decl_function_or_alias(
 			: ast::make_identifier(id);
 		auto body = parse_function_body(src_tokens, std::move(func_name), stream, end, context);
 		body.cc = cc;
-		if (scope == parse_scope::global && id->value == "main")
+		if (scope == parse_scope::global && id->get_value() == "main")
 		{
 			body.flags |= ast::function_body::main;
 		}
@@ -658,7 +658,7 @@ ast::statement parse_decl_operator_or_alias(
 		context.report_error(
 			op,
 			is_operator(op->kind)
-			? bz::format("'operator {}' is not overloadable", op->value)
+			? bz::format("'operator {}' is not overloadable", op->get_value())
 			: bz::u8string("expected an overloadable operator")
 		);
 	}
@@ -746,7 +746,7 @@ static ast::statement parse_type_info_destructor(
 	ctx::parse_context &context
 )
 {
-	bz_assert(stream->kind == lex::token::identifier && stream->value == "destructor");
+	bz_assert(stream->kind == lex::token::identifier && stream->get_value() == "destructor");
 	auto const begin_token = stream;
 	++stream; // 'destructor'
 
@@ -764,7 +764,7 @@ static ast::statement parse_type_info_constructor(
 	ctx::parse_context &context
 )
 {
-	bz_assert(stream->kind == lex::token::identifier && stream->value == "constructor");
+	bz_assert(stream->kind == lex::token::identifier && stream->get_value() == "constructor");
 	auto const begin_token = stream;
 	++stream; // 'constructor'
 
@@ -827,11 +827,11 @@ ast::statement default_parse_type_info_statement(
 )
 {
 	bz_assert(stream != end);
-	if (stream->kind == lex::token::identifier && stream->value == "destructor")
+	if (stream->kind == lex::token::identifier && stream->get_value() == "destructor")
 	{
 		return parse_type_info_destructor(stream, end, context);
 	}
-	else if (stream->kind == lex::token::identifier && stream->value == "constructor")
+	else if (stream->kind == lex::token::identifier && stream->get_value() == "constructor")
 	{
 		return parse_type_info_constructor(stream, end, context);
 	}
@@ -879,7 +879,7 @@ static ast::statement parse_decl_struct_impl(
 	if (stream != end && stream->kind == lex::token::curly_open)
 	{
 		++stream; // '{'
-		auto const range = get_tokens_in_curly<>(stream, end, context);
+		auto const range = get_tokens_in_curly(stream, end, context);
 		if (generic_params.not_empty())
 		{
 			return ast::make_decl_struct(
@@ -1009,7 +1009,7 @@ static ast::statement parse_decl_enum_impl(
 	if (stream != end && stream->kind == lex::token::curly_open)
 	{
 		++stream; // '{'
-		auto const range = get_tokens_in_curly<>(stream, end, context);
+		auto const range = get_tokens_in_curly(stream, end, context);
 
 		auto inner_stream = range.begin;
 		auto const inner_end = range.end;
@@ -1027,13 +1027,13 @@ static ast::statement parse_decl_enum_impl(
 
 			auto const duplicate_it = std::find_if(
 				values.begin(), values.end() - 1,
-				[current_id = values.back().id->value](auto const &value) { return value.id->value == current_id; }
+				[current_id = values.back().id->get_identifier_id()](auto const &value) { return value.id->get_identifier_id() == current_id; }
 			);
 			if (duplicate_it != values.end() - 1)
 			{
 				context.report_error(
 					values.back().id,
-					bz::format("duplicate enum member name '{}'", duplicate_it->id->value),
+					bz::format("duplicate enum member name '{}'", duplicate_it->id->get_value()),
 					{ context.make_note(duplicate_it->id, "member was previously defined here") }
 				);
 				values.pop_back();
@@ -1122,7 +1122,7 @@ ast::statement parse_decl_import(
 
 	auto id = get_identifier(stream, end, context);
 
-	if (id.values.empty())
+	if (id.ids.empty())
 	{
 		context.assert_token(stream, lex::token::semi_colon, lex::token::kw_as);
 		return ast::statement();
@@ -1141,7 +1141,7 @@ ast::statement parse_decl_import(
 		auto import_namespace = get_identifier(stream, end, context);
 		context.assert_token(stream, lex::token::semi_colon);
 
-		if (import_namespace.values.empty())
+		if (import_namespace.ids.empty())
 		{
 			return ast::make_decl_import(std::move(id));
 		}
@@ -1222,7 +1222,7 @@ ast::statement parse_attribute_statement(
 			context.report_warning(
 				ctx::warning_kind::unknown_attribute,
 				attribute.name,
-				bz::format("unknown attribute '@{}'", attribute.name->value)
+				bz::format("unknown attribute '@{}'", attribute.name->get_value())
 			);
 		}
 		break;
@@ -1480,7 +1480,7 @@ static ast::statement parse_stmt_foreach_impl(
 	bz_assert(range_var_decl_stmt.is<ast::decl_variable>());
 	auto &range_var_decl = range_var_decl_stmt.get<ast::decl_variable>();
 	range_var_decl.id_and_type.id.tokens = { range_expr_src_tokens.begin, range_expr_src_tokens.end };
-	range_var_decl.id_and_type.id.values = { "" };
+	range_var_decl.id_and_type.id.ids = { lex::intern_identifier("") };
 	range_var_decl.id_and_type.id.is_qualified = false;
 	range_var_decl.id_and_type.var_type.add_layer<ast::ts_auto_reference_mut>();
 
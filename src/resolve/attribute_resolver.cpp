@@ -13,7 +13,7 @@ static void report_unknown_attribute(ast::attribute const &attribute, ctx::parse
 	context.report_warning(
 		ctx::warning_kind::unknown_attribute,
 		attribute.name,
-		bz::format("unknown attribute '@{}'", attribute.name->value)
+		bz::format("unknown attribute '@{}'", attribute.name->get_value())
 	);
 }
 
@@ -98,7 +98,7 @@ static bool apply_builtin(
 {
 	if (!context.global_ctx.add_builtin_function(&func_decl))
 	{
-		context.report_error(func_decl.body.src_tokens, bz::format("invalid function for '@{}'", attribute.name->value));
+		context.report_error(func_decl.body.src_tokens, bz::format("invalid function for '@{}'", attribute.name->get_value()));
 		return false;
 	}
 
@@ -114,7 +114,7 @@ static bool apply_builtin(
 {
 	if (!context.global_ctx.add_builtin_operator(&op_decl))
 	{
-		context.report_error(op_decl.body.src_tokens, bz::format("invalid operator for '@{}'", attribute.name->value));
+		context.report_error(op_decl.body.src_tokens, bz::format("invalid operator for '@{}'", attribute.name->get_value()));
 		return false;
 	}
 
@@ -131,10 +131,10 @@ static bool apply_builtin(
 {
 	if (!context.global_ctx.add_builtin_type_alias(&alias_decl))
 	{
-		context.report_error(alias_decl.src_tokens, bz::format("invalid type alias for '@{}'", attribute.name->value));
+		context.report_error(alias_decl.src_tokens, bz::format("invalid type alias for '@{}'", attribute.name->get_value()));
 		return false;
 	}
-	else if (alias_decl.id.values.back() == "isize")
+	else if (alias_decl.id.get_value(alias_decl.id.ids.size() - 1) == "isize")
 	{
 		auto const info = context.global_ctx.get_isize_type_info_for_builtin_alias();
 		alias_decl.alias_expr = context.type_as_expression(
@@ -143,7 +143,7 @@ static bool apply_builtin(
 		);
 		return true;
 	}
-	else if (alias_decl.id.values.back() == "usize")
+	else if (alias_decl.id.get_value(alias_decl.id.ids.size() - 1) == "usize")
 	{
 		auto const info = context.global_ctx.get_usize_type_info_for_builtin_alias();
 		alias_decl.alias_expr = context.type_as_expression(
@@ -221,7 +221,7 @@ static bool apply_builtin(
 {
 	if (!context.global_ctx.add_builtin_type_info(&info))
 	{
-		context.report_error(info.src_tokens, bz::format("invalid type for '@{}'", attribute.name->value));
+		context.report_error(info.src_tokens, bz::format("invalid type for '@{}'", attribute.name->get_value()));
 		return false;
 	}
 
@@ -284,7 +284,7 @@ static bool apply_builtin_assign(
 {
 	if (op_decl.op->kind != lex::token::assign)
 	{
-		context.report_error(op_decl.body.src_tokens, bz::format("invalid operator for '@{}'", attribute.name->value));
+		context.report_error(op_decl.body.src_tokens, bz::format("invalid operator for '@{}'", attribute.name->get_value()));
 		return false;
 	}
 	else if (apply_builtin(op_decl, attribute, context))
@@ -306,7 +306,7 @@ static bool apply_symbol_name(
 {
 	if (func_body.is_generic())
 	{
-		context.report_error(attribute.name, bz::format("'@{}' cannot be applied to generic functions", attribute.name->value));
+		context.report_error(attribute.name, bz::format("'@{}' cannot be applied to generic functions", attribute.name->get_value()));
 		return false;
 	}
 	else
@@ -329,7 +329,7 @@ static bool apply_symbol_name(
 {
 	if (!var_decl.is_global())
 	{
-		context.report_error(attribute.name, bz::format("'@{}' cannot be applied to local variables", attribute.name->value));
+		context.report_error(attribute.name, bz::format("'@{}' cannot be applied to local variables", attribute.name->get_value()));
 		return false;
 	}
 	else
@@ -372,9 +372,214 @@ static bool apply_overload_priority(
 	return true;
 }
 
+// checks that every feature in a comma separated feature list can be checked at run time
+static bool check_target_clones_features(
+	bz::u8string_view features,
+	ast::expression const &arg,
+	codegen::target_triple const &target_triple,
+	ctx::parse_context &context
+)
+{
+	bool good = true;
+	auto it = features.begin();
+	while (true)
+	{
+		auto const next = features.find(it, ',');
+		auto const feature = bz::u8string_view(it, next);
+		if (!target_triple.is_cpu_supports_feature(feature))
+		{
+			context.report_error(arg, bz::format("invalid feature '{}' in feature list \"{}\"", feature, features));
+			good = false;
+		}
+
+		if (next == features.end())
+		{
+			return good;
+		}
+		it = next;
+		++it;
+	}
+}
+
+static bool apply_target_clones(
+	ast::function_body &func_body,
+	ast::attribute &attribute,
+	ctx::parse_context &context
+)
+{
+	auto const &target_triple = context.global_ctx.target_triple;
+	if (target_triple.arch != codegen::architecture_kind::x86_64 || target_triple.os != codegen::os_kind::linux)
+	{
+		context.report_error(
+			attribute.name,
+			bz::format("'@{}' is only supported for x86-64 linux targets", attribute.name->get_value())
+		);
+		return false;
+	}
+	else if (attribute.args.empty())
+	{
+		context.report_error(attribute.name, bz::format("'@{}' expects at least 1 argument", attribute.name->get_value()));
+		return false;
+	}
+
+	bool good = true;
+	bool has_default = false;
+	ast::arena_vector<bz::u8string> target_clones;
+	for (auto const &arg : attribute.args)
+	{
+		auto const features = arg.get_constant_value().get_string();
+		if (features == "default")
+		{
+			if (has_default)
+			{
+				context.report_error(arg, "\"default\" can only be given once");
+				good = false;
+			}
+			has_default = true;
+			continue;
+		}
+
+		auto const is_valid = [&]() {
+			auto it = features.begin();
+			while (true)
+			{
+				auto const next = features.find(it, ',');
+				if (next == it)
+				{
+					return false;
+				}
+				else if (next == features.end())
+				{
+					return true;
+				}
+				it = next;
+				++it;
+			}
+		}();
+		if (!is_valid)
+		{
+			context.report_error(
+				arg,
+				bz::format("invalid feature list \"{}\", expected a comma separated list of feature names", features)
+			);
+			good = false;
+		}
+		else if (target_clones.contains(features))
+		{
+			context.report_error(arg, bz::format("duplicate feature list \"{}\"", features));
+			good = false;
+		}
+		else if (!check_target_clones_features(features, arg, target_triple, context))
+		{
+			good = false;
+		}
+		else
+		{
+			target_clones.push_back(features);
+		}
+	}
+
+	if (!has_default)
+	{
+		context.report_error(
+			attribute.name,
+			bz::format("'@{}' must have a \"default\" version", attribute.name->get_value())
+		);
+		good = false;
+	}
+	else if (good && target_clones.empty())
+	{
+		context.report_error(
+			attribute.name,
+			bz::format("'@{}' must have at least one version other than \"default\"", attribute.name->get_value())
+		);
+		good = false;
+	}
+
+	if (good)
+	{
+		func_body.target_clones = std::move(target_clones);
+	}
+	return good;
+}
+
+static bool apply_inline(
+	ast::function_body &func_body,
+	ast::attribute &attribute,
+	ctx::parse_context &context
+)
+{
+	if (func_body.is_no_inline())
+	{
+		context.report_error(attribute.name, bz::format("'@{}' cannot be used together with '@noinline'", attribute.name->get_value()));
+		return false;
+	}
+
+	func_body.flags |= ast::function_body::always_inline;
+	return true;
+}
+
+static bool apply_noinline(
+	ast::function_body &func_body,
+	ast::attribute &attribute,
+	ctx::parse_context &context
+)
+{
+	if (func_body.is_always_inline())
+	{
+		context.report_error(attribute.name, bz::format("'@{}' cannot be used together with '@inline'", attribute.name->get_value()));
+		return false;
+	}
+
+	func_body.flags |= ast::function_body::no_inline;
+	return true;
+}
+
+static bool apply_cold(
+	ast::function_body &func_body,
+	ast::attribute &attribute,
+	ctx::parse_context &context
+)
+{
+	if (func_body.is_hot())
+	{
+		context.report_error(attribute.name, bz::format("'@{}' cannot be used together with '@hot'", attribute.name->get_value()));
+		return false;
+	}
+
+	func_body.flags |= ast::function_body::cold;
+	return true;
+}
+
+static bool apply_hot(
+	ast::function_body &func_body,
+	ast::attribute &attribute,
+	ctx::parse_context &context
+)
+{
+	if (func_body.is_cold())
+	{
+		context.report_error(attribute.name, bz::format("'@{}' cannot be used together with '@cold'", attribute.name->get_value()));
+		return false;
+	}
+
+	func_body.flags |= ast::function_body::hot;
+	return true;
+}
+
+static bool apply_flatten(
+	ast::function_body &func_body,
+	ast::attribute &,
+	ctx::parse_context &
+)
+{
+	func_body.flags |= ast::function_body::flatten;
+	return true;
+}
+
 bz::vector<attribute_info_t> make_attribute_infos(bz::array_view<ast::type_info * const> builtin_type_infos)
 {
-	constexpr size_t N = 3;
+	constexpr size_t N = 9;
 	bz::vector<attribute_info_t> result;
 	result.reserve(N);
 
@@ -398,6 +603,37 @@ bz::vector<attribute_info_t> make_attribute_infos(bz::array_view<ast::type_info
 		{ int64_type },
 		{ nullptr, nullptr, &apply_overload_priority, nullptr, nullptr, nullptr }
 	});
+	result.push_back({
+		"target_clones",
+		{ str_type },
+		{ nullptr, nullptr, &apply_target_clones, nullptr, nullptr, nullptr },
+		true
+	});
+	result.push_back({
+		"inline",
+		{},
+		{ nullptr, nullptr, &apply_inline, nullptr, nullptr, nullptr }
+	});
+	result.push_back({
+		"noinline",
+		{},
+		{ nullptr, nullptr, &apply_noinline, nullptr, nullptr, nullptr }
+	});
+	result.push_back({
+		"cold",
+		{},
+		{ nullptr, nullptr, &apply_cold, nullptr, nullptr, nullptr }
+	});
+	result.push_back({
+		"hot",
+		{},
+		{ nullptr, nullptr, &apply_hot, nullptr, nullptr, nullptr }
+	});
+	result.push_back({
+		"flatten",
+		{},
+		{ nullptr, nullptr, &apply_flatten, nullptr, nullptr, nullptr }
+	});
 
 	bz_assert(result.size() == N);
 	return result;
@@ -424,7 +660,18 @@ static bool resolve_attribute(
 			context.report_error({ stream, stream, end });
 		}
 
-		if (attribute.args.size() != attribute_info.arg_types.size())
+		if (attribute_info.is_variadic && attribute.args.size() < attribute_info.arg_types.size())
+		{
+			context.report_error(
+				lex::src_tokens::from_range(attribute.arg_tokens),
+				bz::format(
+					"'@{}' expects at least {} arguments, but {} were provided",
+					attribute_info.name, attribute_info.arg_types.size(), attribute.args.size()
+				)
+			);
+			good = false;
+		}
+		else if (!attribute_info.is_variadic && attribute.args.size() != attribute_info.arg_types.size())
 		{
 			context.report_error(
 				lex::src_tokens::from_range(attribute.arg_tokens),
@@ -437,8 +684,10 @@ static bool resolve_attribute(
 		}
 		else
 		{
-			for (auto const &[arg, arg_type] : bz::zip(attribute.args, attribute_info.arg_types))
+			for (auto const &[arg, i] : attribute.args.enumerate())
 			{
+				// additional arguments of variadic attributes have the type of the last argument
+				auto &arg_type = attribute_info.arg_types[std::min(i, attribute_info.arg_types.size() - 1)];
 				resolve_expression(arg, context);
 				match_expression_to_type(arg, arg_type, context);
 				resolve::consteval_try(arg, context);
@@ -457,11 +706,11 @@ void resolve_attributes(ast::decl_function &func_decl, ctx::parse_context &conte
 {
 	for (auto &attribute : func_decl.attributes)
 	{
-		if (attribute.name->value == "__builtin")
+		if (attribute.name->get_value() == "__builtin")
 		{
 			apply_builtin(func_decl, attribute, context);
 		}
-		else if (auto const attribute_info = context.global_ctx.get_builtin_attribute(attribute.name->value))
+		else if (auto const attribute_info = context.global_ctx.get_builtin_attribute(attribute.name->get_value()))
 		{
 			auto const good = resolve_attribute(attribute, *attribute_info, context);
 			if (good)
@@ -480,15 +729,15 @@ void resolve_attributes(ast::decl_operator &op_decl, ctx::parse_context &context
 {
 	for (auto &attribute : op_decl.attributes)
 	{
-		if (attribute.name->value == "__builtin")
+		if (attribute.name->get_value() == "__builtin")
 		{
 			apply_builtin(op_decl, attribute, context);
 		}
-		else if (attribute.name->value == "__builtin_assign")
+		else if (attribute.name->get_value() == "__builtin_assign")
 		{
 			apply_builtin_assign(op_decl, attribute, context);
 		}
-		else if (auto const attribute_info = context.global_ctx.get_builtin_attribute(attribute.name->value))
+		else if (auto const attribute_info = context.global_ctx.get_builtin_attribute(attribute.name->get_value()))
 		{
 			auto const good = resolve_attribute(attribute, *attribute_info, context);
 			if (good)
@@ -507,7 +756,7 @@ void resolve_attributes(ast::decl_variable &var_decl, ctx::parse_context &contex
 {
 	for (auto &attribute : var_decl.attributes)
 	{
-		if (auto const attribute_info = context.global_ctx.get_builtin_attribute(attribute.name->value))
+		if (auto const attribute_info = context.global_ctx.get_builtin_attribute(attribute.name->get_value()))
 		{
 			auto const good = resolve_attribute(attribute, *attribute_info, context);
 			if (good)
@@ -526,11 +775,11 @@ void resolve_attributes(ast::decl_type_alias &alias_decl, ctx::parse_context &co
 {
 	for (auto &attribute : alias_decl.attributes)
 	{
-		if (attribute.name->value == "__builtin")
+		if (attribute.name->get_value() == "__builtin")
 		{
 			apply_builtin(alias_decl, attribute, context);
 		}
-		else if (auto const attribute_info = context.global_ctx.get_builtin_attribute(attribute.name->value))
+		else if (auto const attribute_info = context.global_ctx.get_builtin_attribute(attribute.name->get_value()))
 		{
 			auto const good = resolve_attribute(attribute, *attribute_info, context);
 			if (good)
@@ -549,11 +798,11 @@ void resolve_attributes(ast::type_info &info, ctx::parse_context &context)
 {
 	for (auto &attribute : info.attributes)
 	{
-		if (attribute.name->value == "__builtin")
+		if (attribute.name->get_value() == "__builtin")
 		{
 			apply_builtin(info, attribute, context);
 		}
-		else if (auto const attribute_info = context.global_ctx.get_builtin_attribute(attribute.name->value))
+		else if (auto const attribute_info = context.global_ctx.get_builtin_attribute(attribute.name->get_value()))
 		{
 			auto const good = resolve_attribute(attribute, *attribute_info, context);
 			if (good)
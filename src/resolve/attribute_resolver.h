@@ -66,6 +66,8 @@ struct attribute_info_t
 	bz::u8string_view name;
 	bz::vector<ast::typespec> arg_types;
 	apply_funcs_t apply_funcs;
+	// if true, any number of additional arguments with the type of the last argument can be given
+	bool is_variadic = false;
 };
 
 bz::vector<attribute_info_t> make_attribute_infos(bz::array_view<ast::type_info * const> builtin_type_infos);
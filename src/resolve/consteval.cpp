@@ -1479,7 +1479,7 @@ static ast::constant_value evaluate_intrinsic_function_call(
 	bz_assert(func_call.func_body->body.is_null());
 	switch (func_call.func_body->intrinsic_kind)
 	{
-	static_assert(ast::function_body::_builtin_last - ast::function_body::_builtin_first == 285);
+	static_assert(ast::function_body::_builtin_last - ast::function_body::_builtin_first == 325);
 	static_assert(ast::function_body::_builtin_default_constructor_last - ast::function_body::_builtin_default_constructor_first == 14);
 	static_assert(ast::function_body::_builtin_unary_operator_last - ast::function_body::_builtin_unary_operator_first == 7);
 	static_assert(ast::function_body::_builtin_binary_operator_last - ast::function_body::_builtin_binary_operator_first == 28);
@@ -1516,6 +1516,14 @@ static ast::constant_value evaluate_intrinsic_function_call(
 	}
 	case ast::function_body::builtin_is_comptime:
 		return {};
+	case ast::function_body::builtin_expect:
+		bz_assert(func_call.params.size() == 2);
+		if (!func_call.params[0].has_consteval_succeeded() || !func_call.params[1].has_consteval_succeeded())
+		{
+			return {};
+		}
+		bz_assert(func_call.params[0].is_constant());
+		return func_call.params[0].get_constant_value();
 	case ast::function_body::comptime_concatenate_strs:
 	{
 		bz_assert(func_call.params.is_all([](auto const &param) {
@@ -922,7 +922,7 @@ static ast::expression resolve_expr(
 					: lex::token_pos(nullptr);
 			auto const [const_begin, const_end] = const_pos == nullptr
 				? std::make_pair(ctx::char_pos(), ctx::char_pos())
-				: std::make_pair(const_pos->src_pos.begin, (const_pos + 1)->src_pos.begin);
+				: std::make_pair(const_pos->get_begin(), (const_pos + 1)->get_begin());
 			context.report_error(
 				array_type.type.src_tokens, "array element type cannot be 'mut'",
 				{}, { context.make_suggestion_before(
@@ -941,7 +941,7 @@ static ast::expression resolve_expr(
 					: lex::token_pos(nullptr);
 			auto const [consteval_begin, consteval_end] = consteval_pos == nullptr
 				? std::make_pair(ctx::char_pos(), ctx::char_pos())
-				: std::make_pair(consteval_pos->src_pos.begin, (consteval_pos + 1)->src_pos.begin);
+				: std::make_pair(consteval_pos->get_begin(), (consteval_pos + 1)->get_begin());
 			context.report_error(
 				array_type.type.src_tokens, "array element type cannot be 'consteval'",
 				{}, { context.make_suggestion_before(
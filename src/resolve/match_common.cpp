@@ -196,8 +196,8 @@ static bool is_enum_literal_implicitly_convertible(
 	}
 
 	auto const dest_enum_values = dest.get<ast::ts_enum>().decl->values.as_array_view();
-	return dest_enum_values.is_any([name = enum_literal.id->value](auto const &name_and_value) {
-		return name == name_and_value.id->value;
+	return dest_enum_values.is_any([name = enum_literal.id->get_identifier_id()](auto const &name_and_value) {
+		return name == name_and_value.id->get_identifier_id();
 	});
 }
 
@@ -108,7 +108,7 @@ static void resolve_stmt(ast::stmt_foreach &foreach_stmt, ctx::parse_context &co
 	bz_assert(foreach_stmt.iter_var_decl.is<ast::decl_variable>());
 	auto &iter_var_decl = foreach_stmt.iter_var_decl.get<ast::decl_variable>();
 	iter_var_decl.id_and_type.id.tokens = { range_expr_src_tokens.begin, range_expr_src_tokens.end };
-	iter_var_decl.id_and_type.id.values = { "" };
+	iter_var_decl.id_and_type.id.ids = { lex::intern_identifier("") };
 	iter_var_decl.id_and_type.id.is_qualified = false;
 	iter_var_decl.id_and_type.var_type.add_layer<ast::ts_mut>();
 	resolve_statement(foreach_stmt.iter_var_decl, context);
@@ -148,7 +148,7 @@ static void resolve_stmt(ast::stmt_foreach &foreach_stmt, ctx::parse_context &co
 	bz_assert(foreach_stmt.end_var_decl.is<ast::decl_variable>());
 	auto &end_var_decl = foreach_stmt.end_var_decl.get<ast::decl_variable>();
 	end_var_decl.id_and_type.id.tokens = { range_expr_src_tokens.begin, range_expr_src_tokens.end };
-	end_var_decl.id_and_type.id.values = { "" };
+	end_var_decl.id_and_type.id.ids = { lex::intern_identifier("") };
 	end_var_decl.id_and_type.id.is_qualified = false;
 	resolve_statement(foreach_stmt.end_var_decl, context);
 	context.add_local_variable(end_var_decl);
@@ -696,7 +696,7 @@ static void resolve_variable_type(ast::decl_variable &var_decl, ctx::parse_conte
 					"expected ';' or '=' at the end of a type",
 					{ context.make_note(
 						stream,
-						bz::format("'operator {}' is not allowed in a variable declaration's type", stream->value)
+						bz::format("'operator {}' is not allowed in a variable declaration's type", stream->get_value())
 					) }
 				);
 			}
@@ -2159,10 +2159,10 @@ static void resolve_type_info_parameters_impl(ast::type_info &info, ctx::parse_c
 					if (type.src_tokens.pivot != nullptr && type.src_tokens.pivot->kind == lex::token::kw_mut)
 					{
 						auto const pivot = type.src_tokens.pivot;
-						auto const erase_begin = pivot->src_pos.begin;
-						auto const erase_end = pivot->src_pos.line == (pivot + 1)->src_pos.line
-							? (pivot + 1)->src_pos.begin
-							: pivot->src_pos.end;
+						auto const erase_begin = pivot->get_begin();
+						auto const erase_end = pivot->get_line() == (pivot + 1)->get_line()
+							? (pivot + 1)->get_begin()
+							: pivot->get_end();
 						suggestions.push_back(context.make_suggestion_before(
 							pivot,
 							erase_begin, erase_end,
@@ -2905,7 +2905,7 @@ static name_value_pair_it_pair find_enum_member(ast::decl_enum &enum_decl, bz::u
 			depends_on_it = it;
 		}
 
-		if (it->id->value == id_value)
+		if (it->id->get_value() == id_value)
 		{
 			return { it, depends_on_it };
 		}
@@ -2931,13 +2931,13 @@ static void resolve_literal_init_enum_members_helper(
 	bz_assert(literal_expr.is_constant());
 	bz_assert(literal_expr.get_constant().expr.is<ast::expr_enum_literal>());
 	auto const id = literal_expr.get_constant().expr.get<ast::expr_enum_literal>().id;
-	auto const [it, depends_on_it] = find_enum_member(enum_decl, id->value);
+	auto const [it, depends_on_it] = find_enum_member(enum_decl, id->get_value());
 	if (it == enum_decl.values.end())
 	{
 		resolve_enum_members(it, enum_decl.values.end(), 0, min_value, max_value, is_signed, context);
 		context.report_error(
 			literal_expr.src_tokens,
-			bz::format("no member named '{}' in enum '{}'", id->value, enum_decl.id.format_as_unqualified())
+			bz::format("no member named '{}' in enum '{}'", id->get_value(), enum_decl.id.format_as_unqualified())
 		);
 	}
 	else if (it->value.not_null())
@@ -2964,13 +2964,13 @@ static void resolve_literal_init_enum_members_helper(
 			.transform([](auto const it) {
 				return ctx::parse_context::make_note(
 					it->value_expr.src_tokens,
-					bz::format("required by member '{}'", it->id->value)
+					bz::format("required by member '{}'", it->id->get_value())
 				);
 			})
 			.collect();
 		context.report_error(
 			current_it->id,
-			bz::format("circular dependency encountered while trying to resolve value of enum member '{}'", current_it->id->value),
+			bz::format("circular dependency encountered while trying to resolve value of enum member '{}'", current_it->id->get_value()),
 			std::move(notes)
 		);
 
@@ -3534,7 +3534,7 @@ static match_function_result_t<kind> generic_type_match_base_case(
 			{
 				match_context.context.report_error(
 					expr.src_tokens,
-					bz::format("unable to match enum literal '.{}' to type '{}'", expr.get_enum_literal().id->value, original_dest)
+					bz::format("unable to match enum literal '.{}' to type '{}'", expr.get_enum_literal().id->get_value(), original_dest)
 				);
 			}
 			else
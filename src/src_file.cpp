@@ -1,4 +1,6 @@
 #include "src_file.h"
+#include "module_cache.h"
+#include "global_data.h"
 #include "ctx/global_context.h"
 #include "ctx/lex_context.h"
 #include "ctx/parse_context.h"
@@ -6,6 +8,7 @@
 #include "parse/statement_parser.h"
 #include "resolve/consteval.h"
 #include "resolve/statement_resolver.h"
+#include "timer.h"
 
 static bz::u8string read_text_from_file(std::istream &file)
 {
@@ -41,167 +44,184 @@ static void report_redeclaration_error(lex::src_tokens src_tokens, ctx::symbol_t
 }
 */
 
-static void add_import_decls(src_file &file, bz::array_view<bz::u8string_view const> scope, ast::global_scope_symbol_list_t const &import_symbols)
+src_file::src_file(fs::path file_path, uint32_t file_id, bz::vector<uint32_t> scope, bool is_library_file)
+	: _stage(constructed),
+	  _is_library_file(is_library_file),
+	  _file_id(file_id),
+	  _file_path(std::move(file_path)),
+	  _file(), _tokens(),
+	  _declarations{},
+	  _global_scope{},
+	  _scope(std::move(scope))
 {
-	ast::arena_vector<bz::u8string_view> id_buffer;
-	bz::array<bz::u8string_view, 8> stack_id_buffer;
+	bz_assert(fs::canonical(this->_file_path) == this->_file_path);
+	this->_file_path.make_preferred();
+}
+
 
-	auto const scope_size = scope.size();
+static ctx::error make_file_error(bz::u8string message)
+{
+	return ctx::error{
+		ctx::warning_kind::_last,
+		{
+			ctx::global_context::compiler_file_id, 0,
+			ctx::char_pos(), ctx::char_pos(), ctx::char_pos(),
+			ctx::suggestion_range{}, ctx::suggestion_range{},
+			std::move(message),
+		},
+		{}, {}
+	};
+}
 
-	if (scope_size >= stack_id_buffer.size())
+static bool read_file(fs::path const &file_path, tokenized_file_t &result)
+{
+	if (file_path.generic_string() == "-")
 	{
-		id_buffer = scope;
+		result.file = read_text_from_file(std::cin);
 	}
 	else
 	{
-		for (auto const i : bz::iota(0, scope_size))
-		{
-			stack_id_buffer[i] = scope[i];
-		}
-	}
-
-	auto const get_id = [&](bz::array_view<bz::u8string_view const> symbol_id) -> bz::array_view<bz::u8string_view const> {
-		if (scope_size + symbol_id.size() <= stack_id_buffer.size())
-		{
-			for (auto const i : bz::iota(0, symbol_id.size()))
-			{
-				stack_id_buffer[scope_size + i] = symbol_id[i];
-			}
+		std::ifstream file(file_path);
 
-			return bz::array_view(stack_id_buffer.data(), stack_id_buffer.size()).slice(0, scope_size + symbol_id.size());
-		}
-		else
+		if (!file.good())
 		{
-			auto const start_size = id_buffer.size();
-			id_buffer.resize(scope_size + symbol_id.size());
-			// initialize id_buffer
-			if (start_size < scope_size)
-			{
-				for (auto const i : bz::iota(0, scope_size))
-				{
-					id_buffer[i] = scope[i];
-				}
-			}
-
-			for (auto const i : bz::iota(0, symbol_id.size()))
-			{
-				id_buffer[scope_size + i] = symbol_id[i];
-			}
-
-			return id_buffer;
+			bz::u8string const file_name = file_path.generic_string().c_str();
+			result.errors.push_back(make_file_error(bz::format("unable to read file '{}'", file_name)));
+			return false;
 		}
-	};
 
-	for (auto const &func_set : import_symbols.function_sets)
-	{
-		for (auto const func_decl : func_set.func_decls)
-		{
-			file._global_scope.get_global().all_symbols.add_function(get_id(func_decl->id.values), *func_decl);
-		}
-		for (auto const alias_decl : func_set.alias_decls)
-		{
-			file._global_scope.get_global().all_symbols.add_function_alias(get_id(alias_decl->id.values), *alias_decl);
-		}
+		result.file = read_text_from_file(file);
 	}
 
-	for (auto const &op_set : import_symbols.operator_sets)
+	if (!result.file.verify())
 	{
-		for (auto const op_decl : op_set.op_decls)
-		{
-			file._global_scope.get_global().all_symbols.add_operator(*op_decl);
-		}
+		bz::u8string const file_name = file_path.generic_string().c_str();
+		result.errors.push_back(make_file_error(bz::format("'{}' is not a valid UTF-8 file", file_name)));
+		return false;
 	}
 
-	for (auto const var_decl : import_symbols.variables)
+	// the tokens point into the file, so it must not be stored inline as a short string,
+	// otherwise moving it into the src_file would invalidate them
+	constexpr size_t short_string_capacity = 2 * sizeof (void *);
+	if (result.file.capacity() <= short_string_capacity)
 	{
-		file._global_scope.get_global().all_symbols.add_variable(get_id(var_decl->get_id().values), *var_decl);
+		result.file.reserve(short_string_capacity + 1);
 	}
+	return true;
+}
 
-	for (auto const &variadic_var_decl : import_symbols.variadic_variables)
+tokenized_file_t read_and_tokenize_file(
+	fs::path const &file_path,
+	uint32_t file_id,
+	bz::u8string_view target_triple,
+	ctx::global_context &global_ctx
+)
+{
+	tokenized_file_t result;
+	result.is_file_read = read_file(file_path, result);
+	if (!result.is_file_read)
 	{
-		file._global_scope.get_global().all_symbols.add_variable(
-			get_id(variadic_var_decl.original_decl->get_id().values),
-			*variadic_var_decl.original_decl,
-			variadic_var_decl.variadic_decls
-		);
+		return result;
 	}
 
-	for (auto const type_alias_decl : import_symbols.type_aliases)
+	auto const tokenization_begin = timer::now();
+	auto const use_module_cache = global_data::module_cache_dir != "";
+	if (use_module_cache)
 	{
-		file._global_scope.get_global().all_symbols.add_type_alias(get_id(type_alias_decl->id.values), *type_alias_decl);
+		auto cached_tokens = module_cache::load_tokens(result.file, target_triple);
+		if (cached_tokens.has_value())
+		{
+			result.tokens = std::move(cached_tokens.get());
+			result.is_module_cache_hit = true;
+			result.tokenization_time = timer::now() - tokenization_begin;
+			return result;
+		}
+		result.is_module_cache_miss = true;
 	}
 
-	for (auto const struct_decl : import_symbols.structs)
-	{
-		file._global_scope.get_global().all_symbols.add_struct(get_id(struct_decl->id.values), *struct_decl);
-	}
+	ctx::lex_context context(global_ctx, result.errors);
+	result.tokens = lex::get_tokens(result.file, file_id, context);
 
-	for (auto const enum_decl : import_symbols.enums)
+	// files with diagnostics are not cached, because the diagnostics would be lost on a cache hit
+	if (use_module_cache && !context.has_diagnostics)
 	{
-		file._global_scope.get_global().all_symbols.add_enum(get_id(enum_decl->id.values), *enum_decl);
+		module_cache::store_tokens(result.file, result.tokens, target_triple);
 	}
 
-	static_assert(sizeof (ast::global_scope_t) == 624 || sizeof (ast::global_scope_t) == 560);
-}
-
-
-src_file::src_file(fs::path file_path, uint32_t file_id, bz::vector<bz::u8string> scope, bool is_library_file)
-	: _stage(constructed),
-	  _is_library_file(is_library_file),
-	  _file_id(file_id),
-	  _file_path(std::move(file_path)),
-	  _file(), _tokens(),
-	  _declarations{},
-	  _global_scope{},
-	  _scope_container(std::move(scope)),
-	  _scope()
-{
-	bz_assert(fs::canonical(this->_file_path) == this->_file_path);
-	this->_file_path.make_preferred();
-	this->_scope = this->_scope_container.transform([](auto const &s) { return s.as_string_view(); }).collect();
+	result.tokenization_time = timer::now() - tokenization_begin;
+	return result;
 }
 
-
-[[nodiscard]] bool src_file::read_file(ctx::global_context &global_ctx)
+[[nodiscard]] bool src_file::read_and_tokenize(ctx::global_context &global_ctx)
 {
 	bz_assert(this->_stage == constructed);
 
-	if (this->_file_path.generic_string() == "-")
+	auto tokenized_file = [&]() {
+		auto prefetched_file = global_ctx.get_prefetched_file(this->_file_path);
+		if (prefetched_file.has_value())
+		{
+			return std::move(prefetched_file.get());
+		}
+		else
+		{
+			return read_and_tokenize_file(this->_file_path, this->_file_id, global_ctx.target_triple.triple, global_ctx);
+		}
+	}();
+
+	// prefetched files were tokenized before they had a file id
+	for (auto &error : tokenized_file.errors)
 	{
-		this->_file = read_text_from_file(std::cin);
+		if (error.src_highlight.file_id == ctx::global_context::prefetch_file_id)
+		{
+			error.src_highlight.file_id = this->_file_id;
+		}
+		for (auto &note : error.notes)
+		{
+			if (note.file_id == ctx::global_context::prefetch_file_id)
+			{
+				note.file_id = this->_file_id;
+			}
+		}
+		for (auto &suggestion : error.suggestions)
+		{
+			if (suggestion.file_id == ctx::global_context::prefetch_file_id)
+			{
+				suggestion.file_id = this->_file_id;
+			}
+		}
 	}
-	else
-	{
-		std::ifstream file(this->_file_path);
 
-		if (!file.good())
+	global_data::module_cache_hit_count += tokenized_file.is_module_cache_hit ? 1 : 0;
+	global_data::module_cache_miss_count += tokenized_file.is_module_cache_miss ? 1 : 0;
+	global_data::tokenization_time += tokenized_file.tokenization_time;
+
+	this->_file = std::move(tokenized_file.file);
+	for (auto &error : tokenized_file.errors)
+	{
+		if (error.is_warning())
 		{
-			bz::u8string const file_name = this->_file_path.generic_string().c_str();
-			global_ctx.report_error(bz::format("unable to read file '{}'", file_name));
-			return false;
+			global_ctx.report_warning(std::move(error));
+		}
+		else
+		{
+			global_ctx.report_error(std::move(error));
 		}
-
-		this->_file = read_text_from_file(file);
 	}
 
-	if (!this->_file.verify())
+	if (!tokenized_file.is_file_read)
 	{
-		bz::u8string const file_name = this->_file_path.generic_string().c_str();
-		global_ctx.report_error(bz::format("'{}' is not a valid UTF-8 file", file_name));
 		return false;
 	}
 	this->_stage = file_read;
-	return true;
-}
-
-[[nodiscard]] bool src_file::tokenize(ctx::global_context &global_ctx)
-{
-	bz_assert(this->_stage == file_read);
 
-	ctx::lex_context context(global_ctx);
-	this->_tokens = lex::get_tokens(this->_file, this->_file_id, context);
+	this->_tokens = std::move(tokenized_file.tokens);
+	if (!lex::add_source_file(this->_file, this->_file_id, this->_tokens))
+	{
+		global_ctx.report_error(bz::format("unable to add '{}', the total size of the source files is too large", this->_file_path.generic_string().c_str()));
+		return false;
+	}
+	global_data::source_token_count += this->_tokens.size();
 	this->_stage = tokenized;
-
 	return !global_ctx.has_errors();
 }
 
@@ -210,17 +230,13 @@ src_file::src_file(fs::path file_path, uint32_t file_id, bz::vector<bz::u8string
 	switch (this->_stage)
 	{
 	case constructed:
-		if (!this->read_file(global_ctx))
+		if (!this->read_and_tokenize(global_ctx))
 		{
 			return false;
 		}
-		[[fallthrough]];
+		break;
 	case file_read:
-		if (!this->tokenize(global_ctx))
-		{
-			return false;
-		}
-		[[fallthrough]];
+		bz_unreachable;
 	case tokenized:
 		break;
 	case parsed_global_symbols:
@@ -251,7 +267,7 @@ src_file::src_file(fs::path file_path, uint32_t file_id, bz::vector<bz::u8string
 
 	for (auto &decl : this->_declarations)
 	{
-		static_assert(sizeof (ast::global_scope_t) == 624 || sizeof (ast::global_scope_t) == 560);
+		static_assert(sizeof (ast::global_scope_t) == 712 || sizeof (ast::global_scope_t) == 632);
 		static_assert(ast::statement_types::size() == 17);
 		switch (decl.kind())
 		{
@@ -314,11 +330,17 @@ src_file::src_file(fs::path file_path, uint32_t file_id, bz::vector<bz::u8string
 	}
 	this->_stage = parsed_global_symbols;
 
+	// start reading and tokenizing all imported files, while the first ones are being parsed
+	for (auto const import : imports)
+	{
+		global_ctx.prefetch_module(this->_file_id, import->id);
+	}
+
 	for (auto const import : imports)
 	{
-		bz_assert(import->id.values.not_empty());
-		auto const import_scope_file_size = import->id.values.size() - 1; // e.g. import std::vector;
-		auto const import_scope_folder_size = import->id.values.size(); // e.g. import std;
+		bz_assert(import->id.ids.not_empty());
+		auto const import_scope_file_size = import->id.ids.size() - 1; // e.g. import std::vector;
+		auto const import_scope_folder_size = import->id.ids.size(); // e.g. import std;
 
 		auto const import_file_ids = global_ctx.add_module(this->_file_id, import->id);
 		for (auto const &[id, scope] : import_file_ids)
@@ -327,20 +349,20 @@ src_file::src_file(fs::path file_path, uint32_t file_id, bz::vector<bz::u8string
 			auto const &import_symbols = import_decls.get_global().export_symbols;
 			if (!import->import_namespace.has_value())
 			{
-				add_import_decls(*this, scope, import_symbols);
+				this->_global_scope.get_global().add_import(scope, import_symbols);
 			}
 			else if (scope.size() == import_scope_file_size)
 			{
-				add_import_decls(*this, import->import_namespace->values, import_symbols);
+				this->_global_scope.get_global().add_import(import->import_namespace->ids, import_symbols);
 			}
 			else
 			{
-				bz_assert(scope.slice(0, import_scope_folder_size) == import->id.values.as_array_view());
-				ast::arena_vector<bz::u8string_view> temp_id_buffer;
-				temp_id_buffer.reserve(import->import_namespace->values.size() + scope.size() - import_scope_folder_size);
-				temp_id_buffer.append(import->import_namespace->values);
+				bz_assert(scope.slice(0, import_scope_folder_size) == import->id.ids.as_array_view());
+				ast::arena_vector<uint32_t> temp_id_buffer;
+				temp_id_buffer.reserve(import->import_namespace->ids.size() + scope.size() - import_scope_folder_size);
+				temp_id_buffer.append(import->import_namespace->ids);
 				temp_id_buffer.append(scope.slice(import_scope_folder_size));
-				add_import_decls(*this, temp_id_buffer, import_symbols);
+				this->_global_scope.get_global().add_import(temp_id_buffer, import_symbols);
 			}
 		}
 	}
@@ -396,8 +418,32 @@ src_file::src_file(fs::path file_path, uint32_t file_id, bz::vector<bz::u8string
 	ctx::parse_context context(global_ctx);
 	context.current_global_scope = &this->_global_scope;
 
+	// in library files only the function symbols are resolved here, the bodies are resolved if the function
+	// is used, see global_context::require_function_body
+	auto const is_lazy = this->_is_library_file && !global_data::check_library;
 	for (auto &decl : this->_declarations)
 	{
+		if (is_lazy && (decl.is<ast::decl_function>() || decl.is<ast::decl_operator>()))
+		{
+			auto &body = decl.is<ast::decl_function>() ? decl.get<ast::decl_function>().body : decl.get<ast::decl_operator>().body;
+			context.add_to_resolve_queue({}, body);
+			resolve::resolve_function_symbol(decl, body, context);
+			context.pop_resolve_queue();
+
+			// external, intrinsic and main functions can be used by the backend directly, so they are always resolved
+			if (
+				body.state == ast::resolve_state::symbol
+				&& body.body.is<lex::token_range>()
+				&& !body.is_external_linkage()
+				&& !body.is_intrinsic()
+				&& !body.is_main()
+			)
+			{
+				global_ctx.add_deferred_library_function(body);
+				continue;
+			}
+		}
+
 		resolve::resolve_global_statement(decl, context);
 	}
 	for (std::size_t i = 0; i < context.generic_functions.size(); ++i)
@@ -4,10 +4,31 @@
 #include "core.h"
 
 #include "ctx/context_forward.h"
+#include "ctx/error.h"
 #include "lex/token.h"
 #include "ast/scope.h"
 #include "ast/statement.h"
 
+// the result of reading and tokenizing a source file, which doesn't depend on any other file, so it can be
+// done on a separate thread.  errors and warnings are collected in 'errors' and are reported later in order.
+struct tokenized_file_t
+{
+	bz::u8string file;
+	bz::vector<lex::token> tokens;
+	bz::vector<ctx::error> errors;
+	bool is_file_read = false;
+	bool is_module_cache_hit = false;
+	bool is_module_cache_miss = false;
+	std::chrono::nanoseconds tokenization_time{};
+};
+
+tokenized_file_t read_and_tokenize_file(
+	fs::path const &file_path,
+	uint32_t file_id,
+	bz::u8string_view target_triple,
+	ctx::global_context &global_ctx
+);
+
 struct src_file
 {
 	enum src_file_stage : uint8_t
@@ -31,18 +52,16 @@ public:
 	bz::vector<ast::statement> _declarations;
 	ast::scope_t               _global_scope;
 
-	bz::vector<bz::u8string> _scope_container;
-	bz::vector<bz::u8string_view> _scope;
+	bz::vector<uint32_t> _scope;
 
 public:
-	src_file(fs::path file_path, uint32_t file_id, bz::vector<bz::u8string> scope, bool is_library_file);
+	src_file(fs::path file_path, uint32_t file_id, bz::vector<uint32_t> scope, bool is_library_file);
 
 	src_file(src_file const &other) = delete;
 	src_file(src_file &&other) = default;
 
 private:
-	[[nodiscard]] bool read_file(ctx::global_context &global_ctx);
-	[[nodiscard]] bool tokenize(ctx::global_context &global_ctx);
+	[[nodiscard]] bool read_and_tokenize(ctx::global_context &global_ctx);
 
 public:
 	[[nodiscard]] bool parse_global_symbols(ctx::global_context &global_ctx);
@@ -0,0 +1,106 @@
+#include "src_file_prefetcher.h"
+#include "ctx/global_context.h"
+
+src_file_prefetcher::src_file_prefetcher(
+	ctx::global_context &_global_ctx,
+	bz::u8string_view _target_triple,
+	size_t worker_count
+)
+	: global_ctx(_global_ctx),
+	  target_triple(_target_triple)
+{
+	this->workers.reserve(worker_count);
+	for ([[maybe_unused]] auto const _ : bz::iota(0, worker_count))
+	{
+		this->workers.emplace_back([this]() { this->worker_loop(); });
+	}
+}
+
+src_file_prefetcher::~src_file_prefetcher(void) noexcept
+{
+	{
+		auto const lock = std::lock_guard(this->mutex);
+		this->stop = true;
+	}
+	this->queue_cv.notify_all();
+	for (auto &worker : this->workers)
+	{
+		worker.join();
+	}
+}
+
+void src_file_prefetcher::prefetch(fs::path const &file_path)
+{
+	{
+		auto const lock = std::lock_guard(this->mutex);
+		auto const [it, inserted] = this->tasks.insert({ file_path, task_t{ task_state::queued, {} } });
+		if (!inserted)
+		{
+			return;
+		}
+		this->queue.push_back(file_path);
+	}
+	this->queue_cv.notify_one();
+}
+
+bz::optional<tokenized_file_t> src_file_prefetcher::get(fs::path const &file_path)
+{
+	auto lock = std::unique_lock(this->mutex);
+	auto const it = this->tasks.find(file_path);
+	if (it == this->tasks.end())
+	{
+		return {};
+	}
+
+	if (it->second.state == task_state::queued)
+	{
+		// the task is removed here, so the worker that would have picked it up skips it
+		this->tasks.erase(it);
+		lock.unlock();
+		return this->run_task(file_path);
+	}
+
+	// iterators may be invalidated by a rehash while waiting, but references stay valid
+	auto &task = it->second;
+	this->done_cv.wait(lock, [&]() { return task.state == task_state::done; });
+	auto result = std::move(task.result);
+	this->tasks.erase(file_path);
+	return result;
+}
+
+void src_file_prefetcher::worker_loop(void)
+{
+	auto lock = std::unique_lock(this->mutex);
+	while (true)
+	{
+		this->queue_cv.wait(lock, [this]() { return this->stop || !this->queue.empty(); });
+		if (this->stop)
+		{
+			return;
+		}
+
+		auto const file_path = std::move(this->queue.front());
+		this->queue.pop_front();
+		auto const it = this->tasks.find(file_path);
+		if (it == this->tasks.end() || it->second.state != task_state::queued)
+		{
+			continue;
+		}
+
+		// references into an unordered_map stay valid, and the task can't be erased while it's running
+		auto &task = it->second;
+		task.state = task_state::running;
+		lock.unlock();
+		auto result = this->run_task(file_path);
+		lock.lock();
+
+		task.result = std::move(result);
+		task.state = task_state::done;
+		this->done_cv.notify_all();
+	}
+}
+
+tokenized_file_t src_file_prefetcher::run_task(fs::path const &file_path)
+{
+	return read_and_tokenize_file(file_path, ctx::global_context::prefetch_file_id, this->target_triple, this->global_ctx);
+}
@@ -0,0 +1,58 @@
+#ifndef SRC_FILE_PREFETCHER_H
+#define SRC_FILE_PREFETCHER_H
+
+#include "core.h"
+#include "src_file.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+// Reads and tokenizes imported source files on worker threads, while the main thread is busy with
+// parsing.  Files are tokenized with a placeholder file id, because file ids are assigned in the
+// order in which the files are first used, which keeps the compilation deterministic.
+struct src_file_prefetcher
+{
+	enum class task_state
+	{
+		queued,
+		running,
+		done,
+	};
+
+	struct task_t
+	{
+		task_state state;
+		tokenized_file_t result;
+	};
+
+	ctx::global_context &global_ctx;
+	bz::u8string target_triple;
+
+	std::mutex mutex;
+	std::condition_variable queue_cv;
+	std::condition_variable done_cv;
+	std::deque<fs::path> queue;
+	std::unordered_map<fs::path, task_t> tasks;
+	bool stop = false;
+	bz::vector<std::thread> workers;
+
+	src_file_prefetcher(ctx::global_context &_global_ctx, bz::u8string_view _target_triple, size_t worker_count);
+	src_file_prefetcher(src_file_prefetcher const &) = delete;
+	src_file_prefetcher(src_file_prefetcher &&)      = delete;
+	src_file_prefetcher &operator = (src_file_prefetcher const &) = delete;
+	src_file_prefetcher &operator = (src_file_prefetcher &&)      = delete;
+	~src_file_prefetcher(void) noexcept;
+
+	void prefetch(fs::path const &file_path);
+	// returns the result of a previously prefetched file and removes it from the prefetcher.  if the
+	// file is still queued it is tokenized on the calling thread instead of waiting for a worker.
+	bz::optional<tokenized_file_t> get(fs::path const &file_path);
+
+private:
+	void worker_loop(void);
+	tokenized_file_t run_task(fs::path const &file_path);
+};
+
+#endif // SRC_FILE_PREFETCHER_H
@@ -2,6 +2,7 @@
 #define TIMER_H
 
 #include <chrono>
+#include <algorithm>
 #include <bz/u8string.h>
 #include <bz/vector.h>
 
@@ -39,17 +40,27 @@ struct timer : std::chrono::high_resolution_clock
 
 #endif // _WIN32
 
+	struct timing_subsection_t
+	{
+		bz::u8string_view name;
+		duration time;
+	};
+
 	struct timing_section_t
 	{
 		bz::u8string name;
+		// the source file this section belongs to, or empty if it's shared between all of them
+		bz::u8string unit;
 		time_point begin;
 		time_point end;
+		// parts of this section that were timed separately, e.g. the stages of code generation
+		bz::vector<timing_subsection_t> subsections;
 	};
 
 	bz::vector<timing_section_t> timing_sections;
 	bool running = false;
 
-	void start_section(bz::u8string name)
+	void start_section(bz::u8string name, bz::u8string unit = {})
 	{
 		if (this->running)
 		{
@@ -60,6 +71,7 @@ struct timer : std::chrono::high_resolution_clock
 		this->running = true;
 		auto &new_section = this->timing_sections.emplace_back();
 		new_section.name = std::move(name);
+		new_section.unit = std::move(unit);
 		new_section.begin = now();
 	}
 
@@ -71,30 +83,49 @@ struct timer : std::chrono::high_resolution_clock
 		this->running = false;
 	}
 
-	timing_section_t const &get_section(bz::u8string_view name) const
+	// adds 'time' to the subsection 'name' of the running section
+	void add_subsection_time(bz::u8string_view name, duration time)
 	{
-		for (auto const &section : this->timing_sections)
+		bz_assert(this->running);
+		bz_assert(this->timing_sections.not_empty());
+		auto &subsections = this->timing_sections.back().subsections;
+		auto const it = std::find_if(
+			subsections.begin(), subsections.end(),
+			[name](auto const &subsection) { return subsection.name == name; }
+		);
+		if (it != subsections.end())
 		{
-			if (name == section.name)
-			{
-				return section;
-			}
+			it->time += time;
+		}
+		else
+		{
+			subsections.push_back({ name, time });
 		}
-		bz_unreachable;
 	}
 
+	// returns the total duration of the sections called 'name' across all compilation units
 	duration get_section_duration(bz::u8string_view name) const
 	{
-		auto const &section = this->get_section(name);
-		return section.end - section.begin;
+		auto result = duration();
+		bool found = false;
+		for (auto const &section : this->timing_sections)
+		{
+			if (name == section.name)
+			{
+				result += section.end - section.begin;
+				found = true;
+			}
+		}
+		bz_assert(found);
+		return result;
 	}
 
 	duration get_total_duration(void) const
 	{
 		auto result = duration();
-		for (auto const &[name, begin, end] : this->timing_sections)
+		for (auto const &section : this->timing_sections)
 		{
-			result += end - begin;
+			result += section.end - section.begin;
 		}
 		return result;
 	}
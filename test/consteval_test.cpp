@@ -20,7 +20,7 @@ static bz::optional<bz::u8string> consteval_guaranteed_test(ctx::global_context
 #define x(str, kind, res_value)                                                 \
 do {                                                                            \
     bz::u8string_view const file = str;                                         \
-    auto const tokens = lex::get_tokens(file, 0, lex_ctx);                      \
+    auto const tokens = get_test_tokens(file, lex_ctx);                         \
     assert_false(global_ctx.has_errors_or_warnings());                          \
     auto it = tokens.begin();                                                   \
     auto res = parse_expression(it, tokens.end() - 1, parse_ctx, precedence{}); \
@@ -38,7 +38,7 @@ do {
 #define x_fail(str)                                                             \
 do {                                                                            \
     bz::u8string_view const file = str;                                         \
-    auto const tokens = lex::get_tokens(file, 0, lex_ctx);                      \
+    auto const tokens = get_test_tokens(file, lex_ctx);                         \
     assert_false(global_ctx.has_errors_or_warnings());                          \
     auto it = tokens.begin();                                                   \
     auto res = parse_expression(it, tokens.end() - 1, parse_ctx, precedence{}); \
@@ -83,7 +83,7 @@ static bz::optional<bz::u8string> consteval_try_test(ctx::global_context &global
 #define x(str, kind, res_value)                                                 \
 do {                                                                            \
     bz::u8string_view const file = str;                                         \
-    auto const tokens = lex::get_tokens(file, 0, lex_ctx);                      \
+    auto const tokens = get_test_tokens(file, lex_ctx);                         \
     assert_false(global_ctx.has_errors_or_warnings());                          \
     auto it = tokens.begin();                                                   \
     auto res = parse_expression(it, tokens.end() - 1, parse_ctx, precedence{}); \
@@ -103,7 +103,7 @@ do {
 #define x_fail(str)                                                             \
 do {                                                                            \
     bz::u8string_view const file = str;                                         \
-    auto const tokens = lex::get_tokens(file, 0, lex_ctx);                      \
+    auto const tokens = get_test_tokens(file, lex_ctx);                         \
     assert_false(global_ctx.has_errors_or_warnings());                          \
     auto it = tokens.begin();                                                   \
     auto res = parse_expression(it, tokens.end() - 1, parse_ctx, precedence{}); \
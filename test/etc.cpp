@@ -3,4 +3,7 @@
 
 #include "ctcli/ctcli.cpp"
 #include "global_data.cpp"
+#include "lex/token.cpp"
 #include "src_file.cpp"
+#include "src_file_prefetcher.cpp"
+#include "module_cache.cpp"
@@ -74,7 +74,7 @@ static bz::optional<bz::u8string> file_iterator_test(void)
 {
 	bz::u8string_view file = "\nthis is line #2\n";
 	file_iterator it = {
-		file.begin(), 0
+		file.begin(), file.begin(), 0
 	};
 	assert_eq(it.line, 1);
 	assert_eq(it.file_id, 0);
@@ -120,14 +120,14 @@ static bz::optional<bz::u8string> skip_comments_and_whitespace_test(ctx::global_
 	{
 		bz::u8string_view file = "";
 		assert_eq(file.begin(), file.end());
-		file_iterator it = { file.begin(), 0 };
+		file_iterator it = { file.begin(), file.begin(), 0 };
 		skip_comments_and_whitespace(it, file.end(), lex_ctx);
 		assert_eq(it.it, file.end());
 	}
 
 #define x(str)                                        \
 bz::u8string_view file = str;                         \
-file_iterator it = { file.begin(), 0 };               \
+file_iterator it = { file.begin(), file.begin(), 0 }; \
 skip_comments_and_whitespace(it, file.end(), lex_ctx)
 
 	{
@@ -225,15 +225,17 @@ static bz::optional<bz::u8string> get_identifier_or_keyword_token_test(ctx::glob
 
 #define x_id(str)                                                        \
 bz::u8string_view const file = str;                                      \
-file_iterator it = { file.begin(), 0 };                                  \
-auto const t = get_identifier_or_keyword_token(it, file.end(), context); \
+file_iterator it = { file.begin(), file.begin(), 0 };                    \
+auto t = get_identifier_or_keyword_token(it, file.end(), context);       \
+add_test_token(file, t);                                                 \
 assert_false(global_ctx.has_errors());                                   \
 assert_eq(t.kind, token::identifier)
 
 #define x_kw(str, kw_kind)                                               \
 bz::u8string_view const file = str;                                      \
-file_iterator it = { file.begin(), 0 };                                  \
-auto const t = get_identifier_or_keyword_token(it, file.end(), context); \
+file_iterator it = { file.begin(), file.begin(), 0 };                    \
+auto t = get_identifier_or_keyword_token(it, file.end(), context);       \
+add_test_token(file, t);                                                 \
 assert_false(global_ctx.has_errors());                                   \
 assert_eq(t.kind, kw_kind)
 
@@ -243,13 +245,13 @@ assert_eq(t.kind, kw_kind)
 	{
 		x_id("asdfjkl");
 		assert_eq(it.it, file.end());
-		assert_eq(t.value, "asdfjkl");
+		assert_eq(t.get_value(), "asdfjkl");
 	}
 
 	{
 		x_id("____");
 		assert_eq(it.it, file.end());
-		assert_eq(t.value, "____");
+		assert_eq(t.get_value(), "____");
 	}
 
 	{
@@ -259,27 +261,27 @@ assert_eq(t.kind, kw_kind)
 	{
 		x_id("a0123");
 		assert_eq(it.it, file.end());
-		assert_eq(t.value, "a0123");
+		assert_eq(t.get_value(), "a0123");
 	}
 
 	{
 		x_id("_0123");
 		assert_eq(it.it, file.end());
-		assert_eq(t.value, "_0123");
+		assert_eq(t.get_value(), "_0123");
 	}
 
 	{
 		x_id("asdf ");
 		//        ^ file.begin() + 4
 		assert_eq(it.it, file.begin() + 4);
-		assert_eq(t.value, "asdf");
+		assert_eq(t.get_value(), "asdf");
 	}
 
 	{
 		x_id("asdf+");
 		//        ^ file.begin() + 4
 		assert_eq(it.it, file.begin() + 4);
-		assert_eq(t.value, "asdf");
+		assert_eq(t.get_value(), "asdf");
 	}
 
 	xx_kw("namespace", token::kw_namespace);
@@ -305,7 +307,7 @@ assert_eq(t.kind, kw_kind)
 
 	{
 		x_id("False");
-		assert_eq(t.value, "False");
+		assert_eq(t.get_value(), "False");
 	}
 
 	return {};
@@ -321,22 +323,23 @@ static bz::optional<bz::u8string> get_character_token_test(ctx::global_context &
 #define x(str, c, it_pos)                                        \
 do {                                                             \
     bz::u8string_view const file = str;                          \
-    file_iterator it = { file.begin(), 0 };                      \
-    auto const t = get_character_token(it, file.end(), context); \
+    file_iterator it = { file.begin(), file.begin(), 0 };        \
+    auto t = get_character_token(it, file.end(), context);       \
+    add_test_token(file, t);                                     \
     assert_false(global_ctx.has_errors());                       \
     assert_eq(t.kind, token::character_literal);                 \
-    assert_eq(t.value, c);                                       \
+    assert_eq(t.get_value(), c);                                 \
     assert_eq(it.it, it_pos);                                    \
 } while (false)
 
-#define x_err(str, it_pos)                        \
-do {                                              \
-    bz::u8string_view const file = str;           \
-    file_iterator it = { file.begin(), 0 };       \
-    get_character_token(it, file.end(), context); \
-    assert_true(global_ctx.has_errors());         \
-    global_ctx.clear_errors_and_warnings();       \
-    assert_eq(it.it, it_pos);                     \
+#define x_err(str, it_pos)                                \
+do {                                                      \
+    bz::u8string_view const file = str;                   \
+    file_iterator it = { file.begin(), file.begin(), 0 }; \
+    get_character_token(it, file.end(), context);         \
+    assert_true(global_ctx.has_errors());                 \
+    global_ctx.clear_errors_and_warnings();               \
+    assert_eq(it.it, it_pos);                             \
 } while (false)
 
 	x("'a'", "a", file.end());
@@ -372,22 +375,23 @@ static bz::optional<bz::u8string> get_string_token_test(ctx::global_context &glo
 #define x(str, c, it_pos)                                     \
 do {                                                          \
     bz::u8string_view const file = str;                       \
-    file_iterator it = { file.begin(), 0 };                   \
-    auto const t = get_string_token(it, file.end(), context); \
+    file_iterator it = { file.begin(), file.begin(), 0 };     \
+    auto t = get_string_token(it, file.end(), context);       \
+    add_test_token(file, t);                                  \
     assert_false(global_ctx.has_errors());                    \
     assert_eq(t.kind, token::string_literal);                 \
-    assert_eq(t.value, c);                                    \
+    assert_eq(t.get_value(), c);                              \
     assert_eq(it.it, it_pos);                                 \
 } while (false)
 
-#define x_err(str, it_pos)                     \
-do {                                           \
-    bz::u8string_view const file = str;        \
-    file_iterator it = { file.begin(), 0 };    \
-    get_string_token(it, file.end(), context); \
-    assert_true(global_ctx.has_errors());      \
-    global_ctx.clear_errors_and_warnings();    \
-    assert_eq(it.it, it_pos);                  \
+#define x_err(str, it_pos)                                \
+do {                                                      \
+    bz::u8string_view const file = str;                   \
+    file_iterator it = { file.begin(), file.begin(), 0 }; \
+    get_string_token(it, file.end(), context);            \
+    assert_true(global_ctx.has_errors());                 \
+    global_ctx.clear_errors_and_warnings();               \
+    assert_eq(it.it, it_pos);                             \
 } while (false)
 
 	x(R"("")", "", file.end());
@@ -417,7 +421,7 @@ static bz::optional<bz::u8string> get_number_token_test(ctx::global_context &glo
 #define x(str, it_pos)                                        \
 do {                                                          \
     bz::u8string_view const file = str;                       \
-    file_iterator it = { file.begin(), 0 };                   \
+    file_iterator it = { file.begin(), file.begin(), 0 };     \
     auto const t = get_number_token(it, file.end(), context); \
     assert_false(global_ctx.has_errors());                    \
     assert_true(                                              \
@@ -496,10 +500,11 @@ static bz::optional<bz::u8string> get_single_char_token_test(ctx::global_context
 	{
 		bz::u8string const _file(1, c);
 		bz::u8string_view const file = _file;
-		file_iterator it = { file.begin(), 0 };
-		auto const t = get_single_char_token(it, file.end(), context);
+		file_iterator it = { file.begin(), file.begin(), 0 };
+		auto t = get_single_char_token(it, file.end(), context);
+		add_test_token(file, t);
 		assert_eq(t.kind, c);
-		assert_eq(t.value, file);
+		assert_eq(t.get_value(), file);
 		assert_false(global_ctx.has_errors());
 	}
 
@@ -513,7 +518,7 @@ static bz::optional<bz::u8string> get_next_token_test(ctx::global_context &globa
 #define x(str, token_kind)                                  \
 do {                                                        \
     bz::u8string_view const file = str;                     \
-    file_iterator it = { file.begin(), 0 };                 \
+    file_iterator it = { file.begin(), file.begin(), 0 };   \
     auto const t = get_next_token(it, file.end(), context); \
     assert_false(global_ctx.has_errors());                  \
     assert_eq(t.kind, token_kind);                          \
@@ -624,6 +629,59 @@ do {                                                     \
 #undef x
 }
 
+static bz::optional<bz::u8string> interned_identifier_test(ctx::global_context &global_ctx)
+{
+	ctx::lex_context context(global_ctx);
+
+	bz::u8string_view const file = "foo bar foo foobar";
+	auto const ts = get_test_tokens(file, context);
+	assert_false(global_ctx.has_errors());
+	assert_eq(ts.size(), 5);
+	assert_eq(ts[0].get_identifier_id(), ts[2].get_identifier_id());
+	assert_neq(ts[0].get_identifier_id(), ts[1].get_identifier_id());
+	assert_neq(ts[0].get_identifier_id(), ts[3].get_identifier_id());
+	assert_eq(ts[1].get_identifier_id(), intern_identifier("bar"));
+	assert_eq(get_identifier_value(ts[3].get_identifier_id()), "foobar");
+
+	return {};
+}
+
+static bz::optional<bz::u8string> bracket_match_test(ctx::global_context &global_ctx)
+{
+	ctx::lex_context context(global_ctx);
+
+	{
+		bz::u8string_view const file = "a(b[c]{d}, {})";
+		auto const ts = get_tokens(file, 0, context);
+		assert_false(global_ctx.has_errors());
+		assert_eq(ts.size(), 14);
+		assert_eq(ts[1].match_distance, 11);  // ( -> )
+		assert_eq(ts[12].match_distance, 11); // ) -> (
+		assert_eq(ts[3].match_distance, 2);   // [ -> ]
+		assert_eq(ts[6].match_distance, 2);   // { -> }
+		assert_eq(ts[10].match_distance, 1);  // { -> }
+	}
+
+#define x_err(str)                                \
+do {                                              \
+    bz::u8string_view const file = str;           \
+    get_tokens(file, 0, context);                 \
+    assert_true(global_ctx.has_errors());         \
+    global_ctx.clear_errors_and_warnings();       \
+} while (false)
+
+	x_err("(");
+	x_err(")");
+	x_err("(]");
+	x_err("{ ( }");
+	x_err("a[b(c]");
+	x_err("{}}");
+
+	return {};
+
+#undef x_err
+}
+
 test_result lexer_test(ctx::global_context &global_ctx)
 {
 	test_begin();
@@ -638,6 +696,8 @@ test_result lexer_test(ctx::global_context &global_ctx)
 	test_fn(get_single_char_token_test, global_ctx);
 	test_fn(get_next_token_test, global_ctx);
 	test_fn(get_tokens_test, global_ctx);
+	test_fn(bracket_match_test, global_ctx);
+	test_fn(interned_identifier_test, global_ctx);
 
 	test_end();
 }
@@ -20,7 +20,7 @@ using namespace resolve;
 #define xxx(fn, str, it_pos, error_assert, custom_assert)  \
 do {                                                       \
     bz::u8string_view const file = str;                    \
-    auto const tokens = lex::get_tokens(file, 0, lex_ctx); \
+    auto const tokens = get_test_tokens(file, lex_ctx);    \
     assert_false(global_ctx.has_errors_or_warnings());     \
     auto it = tokens.begin();                              \
     auto res = fn(it, tokens.end() - 1, parse_ctx);        \
@@ -47,15 +47,15 @@ xxx(fn, str, it_pos, global_ctx.has_errors(), custom_assert)
 do {                                                                                 \
     static std::list<bz::vector<lex::token>> var_tokens;                             \
     static bz::vector<ast::statement> var_decls;                                     \
-    var_tokens.emplace_back(lex::get_tokens(id_str, 0, lex_ctx));                    \
+    var_tokens.emplace_back(get_test_tokens(id_str, lex_ctx));                       \
     auto const &name_tokens = var_tokens.back();                                     \
     assert_eq(name_tokens.size(), 2);                                                \
     assert_eq(name_tokens[0].kind, lex::token::identifier);                          \
     auto const id = name_tokens.begin();                                             \
-    var_tokens.emplace_back(lex::get_tokens(type_str, 0, lex_ctx));                  \
+    var_tokens.emplace_back(get_test_tokens(type_str, lex_ctx));                     \
     auto const &type_tokens = var_tokens.back();                                     \
     assert_false(global_ctx.has_errors());                                           \
-    auto const init_expr_tokens = lex::get_tokens(init_expr_str, 0, lex_ctx);        \
+    auto const init_expr_tokens = get_test_tokens(init_expr_str, lex_ctx);           \
     var_tokens.push_back(init_expr_tokens);                                          \
     auto init_expr = sizeof init_expr_str == 1                                       \
         ? ast::expression()                                                          \
@@ -103,7 +103,7 @@ static bz::optional<bz::u8string> get_paren_matched_range_test(ctx::global_conte
 #define x(str, it_pos)                                     \
 do {                                                       \
     bz::u8string_view const file = str;                    \
-    auto const tokens = lex::get_tokens(file, 0, lex_ctx); \
+    auto const tokens = get_test_tokens(file, lex_ctx);    \
     assert_false(global_ctx.has_errors());                 \
     auto it = tokens.begin() + 1;                          \
     get_paren_matched_range(it, tokens.end(), parse_ctx);  \
@@ -11,6 +11,7 @@
 #include "colors.h"
 #include "ast/constant_value.h"
 #include "ast/statement.h"
+#include "lex/lexer.h"
 
 struct test_result
 {
@@ -84,6 +85,21 @@ inline std::ostream &operator << (std::ostream &os, ast::constant_value const &v
 	return os;
 }
 
+// tokens have to be added to the source file space before their values can be accessed
+inline bz::vector<lex::token> get_test_tokens(bz::u8string_view file, ctx::lex_context &context)
+{
+	auto tokens = lex::get_tokens(file, 0, context);
+	[[maybe_unused]] auto const is_added = lex::add_source_file(file, 0, tokens);
+	bz_assert(is_added);
+	return tokens;
+}
+
+inline void add_test_token(bz::u8string_view file, lex::token &t)
+{
+	[[maybe_unused]] auto const is_added = lex::add_source_file(file, 0, bz::array_view(&t, &t + 1));
+	bz_assert(is_added);
+}
+
 template<typename ...Ts>
 inline bz::u8string build_str(Ts &&...ts)
 {